@@ -82,27 +82,6 @@ TypeAnalysis.prototype.testOnFiles = function (fileList, options)
     var hostParams = config.hostParams;
     var clientParams = config.clientParams;
 
-    // Get the stdlib source file names
-    //const libFiles = TACHYON_STDLIB_SRCS;
-    const libFiles = [
-        'stdlib/object.js',
-        'stdlib/array.js',
-        'stdlib/function.js',
-        'stdlib/boolean.js',
-
-        // TODO
-        // FIXME: big type sets happening
-        //'stdlib/error.js',
-
-        'stdlib/number.js',
-        'stdlib/string.js',
-
-        // TODO
-        //'stdlib/regexp.js',
-
-        'stdlib/math.js'
-    ];
-
     // List of library IR units
     this.libUnits = [];
 
@@ -111,27 +90,7 @@ TypeAnalysis.prototype.testOnFiles = function (fileList, options)
 
     // If the standard library should be included
     if (useStdLib === true)
-    {
-        // For each stdlib file
-        for (var i = 0; i < libFiles.length; ++i)
-        {
-            var fileName = libFiles[i];
-
-            if (this.verbose === true)
-                print('Running type analysis on: "' + fileName + '"');
-
-            // Get the IR for this file
-            var ast = parse_src_file(fileName, hostParams);
-            var ir = unitToIR(ast, hostParams);
-
-            // Add the code unit to the analysis
-            this.addUnit(ir);
-
-            // Add the code to the list of library units
-            this.libUnits.push(ir);
-            this.allUnits.push(ir);
-        }
-    }
+        this.addLibUnits(hostParams);
 
     // For each file to be analyzed
     for (var i = 0; i < fileList.length; ++i)
@@ -162,6 +121,54 @@ TypeAnalysis.prototype.testOnFiles = function (fileList, options)
     this.evalTypeAsserts();
 }
 
+/**
+Standard library files analyzed along with the code under analysis
+*/
+TypeAnalysis.LIB_FILES = [
+    'stdlib/object.js',
+    'stdlib/array.js',
+    'stdlib/function.js',
+    'stdlib/boolean.js',
+
+    // TODO
+    // FIXME: big type sets happening
+    //'stdlib/error.js',
+
+    'stdlib/number.js',
+    'stdlib/string.js',
+
+    // TODO
+    //'stdlib/regexp.js',
+
+    'stdlib/math.js'
+];
+
+/**
+Add the standard library units to the analysis
+*/
+TypeAnalysis.prototype.addLibUnits = function (params)
+{
+    // For each stdlib file
+    for (var i = 0; i < TypeAnalysis.LIB_FILES.length; ++i)
+    {
+        var fileName = TypeAnalysis.LIB_FILES[i];
+
+        if (this.verbose === true)
+            print('Running type analysis on: "' + fileName + '"');
+
+        // Get the IR for this file
+        var ast = parse_src_file(fileName, params);
+        var ir = unitToIR(ast, params);
+
+        // Add the code unit to the analysis
+        this.addUnit(ir);
+
+        // Add the code to the list of library units
+        this.libUnits.push(ir);
+        this.allUnits.push(ir);
+    }
+}
+
 /**
 Log information about analysis results
 */
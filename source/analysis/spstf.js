@@ -90,14 +90,27 @@ SPSTFUseSet.prototype.union = function (that)
     if (this.length < that.length)
     {
         fromSet = this;
-        intoSet = that.copy();
+        intoSet = that;
     }
     else
     {
         fromSet = that;
-        intoSet = this.copy();
+        intoSet = this;
     }
 
+    // If the smaller set is contained in the bigger one, the
+    // bigger set is the union and no copy needs to be made
+    for (var i = 0; i < fromSet.array.length; i += 2)
+    {
+        var val = fromSet.array[i];
+        if (val !== HashMap.FREE_KEY && intoSet.has(val) === false)
+            break;
+    }
+    if (i >= fromSet.array.length)
+        return intoSet;
+
+    intoSet = intoSet.copy();
+
     // Add the elements from the second set
     //for (var itr = that.getItr(); itr.valid(); itr.next())
     //    HashSet.prototype.add.call(newSet, itr.get());
@@ -129,6 +142,9 @@ SPSTFUseSet.prototype.equal = function (that)
 
 SPSTFUseSet.prototype.add = function (use)
 {
+    if (this.has(use) === true)
+        return this;
+
     var newSet = this.copy();
 
     HashSet.prototype.add.call(newSet, use);
@@ -138,6 +154,9 @@ SPSTFUseSet.prototype.add = function (use)
 
 SPSTFUseSet.prototype.rem = function (use)
 {
+    if (this.has(use) === false)
+        return this;
+
     var newSet = this.copy();
 
     HashSet.prototype.rem.call(newSet, use);
@@ -338,6 +357,16 @@ function SPSTFBlock(irBlock, instrIdx, func)
     Map of live values to uses at the beginning of the block
     */
     this.liveMap = new SPSTFLiveMap();
+
+    /**
+    Set of values used or defined by the instructions of this block
+    */
+    this.valSet = new HashSet(undefined, undefined, 3);
+
+    /**
+    Set of values this block is queued for in the live value work list
+    */
+    this.queuedVals = new HashSet(undefined, undefined, 3);
 }
 
 SPSTFBlock.prototype.getName = function ()
@@ -871,6 +900,12 @@ SPSTF.prototype.queueBlock = function (block, value)
         'invalid value'
     );
   
+    // If this value is already queued for this block, do nothing
+    if (block.queuedVals.has(value) === true)
+        return;
+
+    block.queuedVals.add(value);
+
     this.blockWorkList.addLast({ block:block, value:value });
 }
 
@@ -1038,6 +1073,7 @@ SPSTF.prototype.blockItr = function ()
     var item = this.blockWorkList.remFirst();
     var block = item.block;
     var value = item.value;
+    block.queuedVals.rem(value);
 
     //print(
     //    'Iterating block: ' + block.getName() /*+
@@ -1158,24 +1194,27 @@ SPSTF.prototype.blockItr = function ()
     {
         var callSites = branch.block.func.callSites;
 
+        // Test if the value is global and defined in this function
+        var globalDef = (isGlobal === true && block.func.defSet.has(value) === true);
+
         // For each call site of this function
         for (var i = 0; i < callSites.length; ++i)
         {
             var callSite = callSites[i];
+
+            // If the value is not global and defined in this function
+            // and it is not this call's return value, skip this call site
+            if (globalDef === false && value !== callSite.irInstr)
+                continue;
+
             var callCont = callSite.targets[0];
 
             if ((callCont instanceof SPSTFBlock) === false)
                 continue;
 
-            // If the value is global and defined in this function or
-            // if it this call's return value
-            if ((isGlobal === true && block.func.defSet.has(value) === true) ||
-                value === callSite.irInstr)
-            {
-                var succSet = callCont.liveMap.get(value);
-                var succSet = filterPhis(succSet, block, callCont, value);
-                useSet = useSet.union(succSet);                
-            }
+            var succSet = callCont.liveMap.get(value);
+            var succSet = filterPhis(succSet, block, callCont, value);
+            useSet = useSet.union(succSet);                
         }
 
         // Process the definitions
@@ -1264,8 +1303,9 @@ SPSTF.prototype.blockItr = function ()
     // Process uses for branch instruction
     useSet = processUses(branch, value, useSet);
 
-    // For each instruction except the branch, in reverse order
-    for (var i = block.instrs.length - 2; i >= 0; --i)
+    // For each instruction except the branch, in reverse order,
+    // if some instruction of this block uses or defines the value
+    for (var i = block.valSet.has(value)? (block.instrs.length - 2):-1; i >= 0; --i)
     {
         var instr = block.instrs[i];
 
@@ -1631,6 +1671,7 @@ SPSTF.prototype.getType = function (instr, value)
         };
 
         instr.inVals.push(use);
+        instr.block.valSet.add(value);
 
         // If this value is path-sensitive
         if (value.def === undefined)
@@ -1711,6 +1752,7 @@ SPSTF.prototype.setType = function (instr, value, type, targetIdx, pathSens)
 
         // Add the new definition to the list for this target
         defList.push(def);
+        instr.block.valSet.add(value);
 
         if (pathSens === true)
         {
@@ -3894,6 +3936,12 @@ CallFuncInstr.prototype.spstfFlowFunc = function (ta)
         retType = TypeSet.string;
     }
 
+    // Extract or replace a range of characters of a string
+    else if (callee.funcName === 'strSlice' || callee.funcName === 'strSplice')
+    {
+        retType = TypeSet.string;
+    }
+
     // Box value to boolean conversion
     else if (callee.funcName === 'boxToBool')
     {
@@ -601,6 +601,13 @@ TypeSet.prototype.union = function (that)
         return this;
     }
 
+    // If the other set is contained in this one, the union is this set.
+    // This keeps type sets shared so that equality tests stay cheap.
+    else if (this.contains(that) === true)
+    {
+        return this;
+    }
+
     var flags = this.flags | that.flags;
 
     var thisNum = (this.flags & (TypeFlags.INT | TypeFlags.FLOAT)) !== 0;
@@ -703,6 +710,46 @@ TypeSet.prototype.union = function (that)
     return newSet;
 }
 
+/**
+Test if another type set is contained in this one such that their
+union would be equal to this set, without widening the numerical range
+*/
+TypeSet.prototype.contains = function (that)
+{
+    if ((that.flags & ~this.flags) !== 0)
+        return false;
+
+    var thisNum = (this.flags & (TypeFlags.INT | TypeFlags.FLOAT)) !== 0;
+    var thatNum = (that.flags & (TypeFlags.INT | TypeFlags.FLOAT)) !== 0;
+
+    if ((thisNum === false || thatNum === true) &&
+        (this.rangeMin !== that.rangeMin || this.rangeMax !== that.rangeMax))
+        return false;
+
+    if ((that.flags & TypeFlags.STRING) !== 0)
+    {
+        if (this.strVal !== undefined && this.strVal !== that.strVal)
+            return false;
+    }
+    else if ((this.flags & TypeFlags.STRING) === 0)
+    {
+        if (this.strVal !== that.strVal)
+            return false;
+    }
+
+    if (that.objSet === undefined)
+        return true;
+
+    if (that.getNumObjs() > this.getNumObjs())
+        return false;
+
+    for (var itr = that.getObjItr(); itr.valid(); itr.next())
+        if (this.hasObj(itr.get()) === false)
+            return false;
+
+    return true;
+}
+
 /**
 Restrict a type set based on possible type flags
 */
@@ -1123,12 +1170,58 @@ TypeGraph.prototype.merge = function (that, mergeLocals, mergeGlobals)
     return newGraph;
 }
 
+/**
+Test if merging another graph into this one would leave it unchanged
+*/
+TypeGraph.prototype.subsumes = function (that, mergeLocals, mergeGlobals)
+{
+    for (var nodeItr = that.varMap.getItr(); nodeItr.valid(); nodeItr.next())
+    {
+        var edge = nodeItr.get();
+        var node = edge.key;
+
+        // If this is a global value
+        if (node.parent instanceof TGObject || node.parent instanceof TGClosCell)
+        {
+            if (mergeGlobals === false)
+                continue;
+        }
+        else
+        {
+            if (mergeLocals === false)
+                continue;
+        }
+
+        var thisSet = this.varMap.get(node);
+
+        if (thisSet === HashMap.NOT_FOUND)
+            return false;
+
+        var thatSet = edge.value;
+
+        if (thisSet !== thatSet && thisSet.union(thatSet) !== thisSet)
+            return false;
+    }
+
+    if (mergeGlobals === true)
+    {
+        for (var itr = that.objSet.getItr(); itr.valid(); itr.next())
+            if (this.objSet.has(itr.get()) === false)
+                return false;
+    }
+
+    return true;
+}
+
 /**
 Compare this graph for equality with another.
 Equality means both graphs have the same edges.
 */
 TypeGraph.prototype.equal = function (that)
 {
+    if (this === that)
+        return true;
+
     if (this.varMap.length !== that.varMap.length)
         return false;
 
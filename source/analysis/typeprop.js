@@ -65,6 +65,9 @@ function BlockDesc(block, instrIdx)
     this.block = block;
 
     this.instrIdx = instrIdx;
+
+    // Work list priority, set when the block is queued
+    this.order = 0;
 }
 
 /**
@@ -106,9 +109,21 @@ TypeProp.prototype.init = function ()
     TGClosCell.cellMap.clear();
 
     /**
-    Worklist of basic blocks queued to be analyzed
+    Worklist of basic blocks queued to be analyzed.
+    Blocks are processed in the order in which they were first
+    reached, which approximates a reverse postorder traversal.
     */
-    this.workList = new LinkedList();
+    this.workList = new Heap(
+        function (desc1, desc2)
+        {
+            return desc2.order - desc1.order;
+        }
+    );
+
+    /**
+    Map of block descriptors to the order in which they were first queued
+    */
+    this.blockOrder = new HashMap(BlockDesc.hashFn, BlockDesc.equalFn);
 
     /**
     Set of blocks in the work list
@@ -202,18 +217,10 @@ TypeProp.prototype.init = function ()
     this.unitList = [];
 
     /**
-    Map of hash sets for instruction uses/outputs, for gathering statistics
+    Map of instructions to the last seen type sets for their output
+    (index 0) and their uses (index i+1), for gathering statistics
     */
-    this.typeSets = new HashMap(
-        function (use)
-        {
-            return defHashFunc(use.instr) + ((use.idx !== undefined)? use.idx:7);
-        },
-        function (use1, use2)
-        {
-            return use1.instr === use2.instr && use1.idx === use2.idx;
-        }
-    );
+    this.typeSets = new HashMap();
 
     /**
     Total analysis iteration count
@@ -259,14 +266,35 @@ TypeProp.prototype.getTypeSet = function (irInstr, useIdx)
         'invalid use index'
     );
 
-    var typeSet = this.typeSets.get({ instr:irInstr, idx:useIdx });
+    var instrSets = this.typeSets.get(irInstr);
+
+    if (instrSets === HashMap.NOT_FOUND)
+        return null;
+
+    var typeSet = instrSets[(useIdx === undefined)? 0:(useIdx + 1)];
 
-    if (typeSet === HashMap.NOT_FOUND)
+    if (typeSet === undefined)
         return null;
 
     return typeSet;
 }
 
+/**
+Get the array of last seen type sets for an instruction
+*/
+TypeProp.prototype.getInstrSets = function (irInstr)
+{
+    var instrSets = this.typeSets.get(irInstr);
+
+    if (instrSets === HashMap.NOT_FOUND)
+    {
+        instrSets = new Array(irInstr.uses.length + 1);
+        this.typeSets.set(irInstr, instrSets);
+    }
+
+    return instrSets;
+}
+
 /**
 Dump information gathered about functions during analysis
 */
@@ -460,7 +488,16 @@ TypeProp.prototype.queueBlock = function (blockDesc)
     if (this.workSet.has(blockDesc) === true)
         return;
 
-    this.workList.addLast(blockDesc);
+    // Get the priority of the block in the work list
+    var order = this.blockOrder.get(blockDesc);
+    if (order === HashMap.NOT_FOUND)
+    {
+        order = this.blockOrder.length;
+        this.blockOrder.set(blockDesc, order);
+    }
+    blockDesc.order = order;
+
+    this.workList.insert(blockDesc);
 
     this.workSet.add(blockDesc);
 }
@@ -566,7 +603,7 @@ TypeProp.prototype.iterate = function ()
     );
 
     // Remove a block from the work list
-    var blockDesc = this.workList.remFirst();
+    var blockDesc = this.workList.extract();
     this.workSet.rem(blockDesc);
 
     // Get a copy of the type set at the block entry
@@ -603,6 +640,8 @@ TypeProp.prototype.iterate = function ()
     {
         var instr = block.instrs[i];
 
+        var instrSets = this.getInstrSets(instr);
+
         if (config.verbosity >= log.DEBUG)
         {
             print(instr);
@@ -624,7 +663,7 @@ TypeProp.prototype.iterate = function ()
                 print(use.getValName() + ' : ' + useType);
 
             // Store the last seen type set for this use
-            this.typeSets.set({ instr: instr, idx: j }, useType);
+            instrSets[j + 1] = useType;
         }
 
         // Process the instruction
@@ -645,7 +684,7 @@ TypeProp.prototype.iterate = function ()
         var outType = typeGraph.getType(instr);
 
         // Store the last seen type set for the instruction's output
-        this.typeSets.set({ instr: instr }, outType);
+        instrSets[0] = outType;
         
         if (config.verbosity >= log.DEBUG)
         {
@@ -699,6 +738,12 @@ TypeProp.prototype.succMerge = function (succ, predGraph)
         // Queue the successor for analysis
         this.queueBlock(succDesc);
     }
+    // If the successor's type map already contains the predecessor's,
+    // the merge cannot change it and there is nothing to requeue
+    else if (succGraph.subsumes(predGraph, true, true) === true)
+    {
+        return;
+    }
     else
     {
         // Merge the predecessor type map into the successor's
@@ -1992,6 +2037,14 @@ JSCallInstr.prototype.typeProp = function (ta, typeGraph)
         }
     }
 
+    // If at least one potential callee has been analyzed
+    if (calleeAnalyzed === true)
+    {
+        // Store the last seen type set for the call's output
+        var outType = newContGraph.getType(this);
+        ta.getInstrSets(this)[0] = outType;
+    }
+
     // Stop the inference for this block
     return true;
 }
@@ -2143,7 +2196,7 @@ RetInstr.prototype.typeProp = function (ta, typeGraph)
 
                 // Store the last seen type set for the call instruction's output
                 var outType = newContGraph.getType(callInstr);
-                ta.typeSets.set({ instr: callInstr }, outType);
+                ta.getInstrSets(callInstr)[0] = outType;
             }
         }
     }
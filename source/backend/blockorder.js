@@ -42,26 +42,96 @@
 
 /**
 @fileOverview
-Block ordering for register allocation and code generation.
+Block ordering for register allocation and code generation. Blocks are
+laid out so that the most likely successor of each block immediately
+follows it. Branch probabilities come from an edge profile when one is
+available, and from static heuristics otherwise. Cold blocks (exception
+and slow paths) are moved to the end of the function.
 
 @author
 Maxime Chevalier-Boisvert
 */
 
+/**
+Names of the functions whose call sites mark a block as cold
+*/
+orderBlocks.COLD_FUNCS = [
+    'error',
+    'throwExc',
+    'typeError',
+    'refError',
+    'syntaxError'
+];
+
+/**
+Static probability estimates for branch edges
+*/
+orderBlocks.PROB_COLD       = 0.05;
+orderBlocks.PROB_BACK_EDGE  = 0.88;
+orderBlocks.PROB_LOOP_EXIT  = 0.20;
+
 /**
 Generate a block ordering for a CFG
 */
-function orderBlocks(entry, blocks)
+function orderBlocks(entry, blocks, params)
 {
-    // TODO: favorise most likely path
+    // Get the edge profile to use, if any
+    var profile = (params !== undefined)? params.blockProfile:undefined;
+
+    // Get the edge counts for this function, if it was profiled
+    var counts = undefined;
+    if (profile instanceof EdgeProfile)
+        counts = profile.getFuncCounts(entry.parentCFG.ownerFunc);
+
+    // Find the cold blocks and the loops of the CFG
+    var cold = orderBlocks.findColdBlocks(entry, blocks);
+    var loops = orderBlocks.findLoops(entry, blocks);
+
+    //
+    // Estimate the probability of a given branch edge
+    //
+    function edgeProb(pred, succ, targets)
+    {
+        // If we have profiling information for this edge, use it
+        if (counts !== undefined)
+        {
+            var total = 0;
+            for (var i = 0; i < targets.length; ++i)
+                total += counts.getCount(pred, targets[i]);
+
+            if (total > 0)
+                return counts.getCount(pred, succ) / total;
+        }
+
+        if (cold[succ.blockId] === true && cold[pred.blockId] !== true)
+            return orderBlocks.PROB_COLD;
+
+        if (loops.isBackEdge(pred, succ) === true)
+            return orderBlocks.PROB_BACK_EDGE;
+
+        if (loops.isExitEdge(pred, succ) === true)
+            return orderBlocks.PROB_LOOP_EXIT;
+
+        return 1 / targets.length;
+    }
 
     var stack = [entry];
     var order = [];
 
+    // Cold blocks deferred to the end of the function
+    var coldStack = [];
+
     var visited = [];
 
-    while (stack.length > 0)
+    while (stack.length > 0 || coldStack.length > 0)
     {
+        // Once the hot blocks are placed, lay out the cold section
+        if (stack.length === 0)
+        {
+            stack = coldStack.reverse();
+            coldStack = [];
+        }
+
         var b = stack.pop();
 
         if (visited[b.blockId] === true)
@@ -74,13 +144,346 @@ function orderBlocks(entry, blocks)
         // Get the branch targets of the last instruction
         var targets = b.getLastInstr().targets;
 
-        // TODO: back branches (to already visited blocks) more likely?
-
-        // Visit the first target first
+        // Sort the targets by increasing probability so that the most
+        // likely one is visited next. Ties keep the first target first.
+        var sorted = [];
         for (var i = targets.length - 1; i >= 0; --i)
-            stack.push(targets[i]);
+        {
+            var t = targets[i];
+            var p = edgeProb(b, t, targets);
+
+            var j = sorted.length;
+            while (j > 0 && sorted[j-1].prob > p)
+                --j;
+
+            sorted.splice(j, 0, { block: t, prob: p });
+        }
+
+        for (var i = 0; i < sorted.length; ++i)
+        {
+            var t = sorted[i].block;
+
+            // Cold blocks reached from hot code go into the cold section
+            if (cold[t.blockId] === true && cold[b.blockId] !== true)
+                coldStack.push(t);
+            else
+                stack.push(t);
+        }
     }
 
     return order;
 }
 
+/**
+Find the blocks which are unlikely to execute. These are exception
+handlers, arithmetic overflow paths and blocks calling error functions,
+along with the blocks only reachable through them.
+*/
+orderBlocks.findColdBlocks = function (entry, blocks)
+{
+    var cold = [];
+
+    for (var i = 0; i < blocks.length; ++i)
+    {
+        var block = blocks[i];
+        var lastInstr = block.getLastInstr();
+
+        // Overflow and throw targets are slow paths
+        if ((lastInstr instanceof ArithOvfInstr ||
+             lastInstr instanceof CallInstr) &&
+            lastInstr.targets.length > 1)
+            cold[lastInstr.targets[1].blockId] = true;
+
+        // Blocks calling error functions are cold
+        for (var j = 0; j < block.instrs.length; ++j)
+        {
+            var instr = block.instrs[j];
+
+            if (instr instanceof CallFuncInstr &&
+                instr.getCallee() instanceof IRFunction &&
+                arraySetHas(
+                    orderBlocks.COLD_FUNCS,
+                    instr.getCallee().funcName
+                ) === true)
+            {
+                cold[block.blockId] = true;
+                break;
+            }
+        }
+    }
+
+    // The entry block is never cold
+    cold[entry.blockId] = false;
+
+    // Blocks whose predecessors are all cold are cold as well
+    var changed = true;
+    while (changed === true)
+    {
+        changed = false;
+
+        for (var i = 0; i < blocks.length; ++i)
+        {
+            var block = blocks[i];
+
+            if (cold[block.blockId] === true || block === entry)
+                continue;
+
+            var allCold = block.preds.length > 0;
+            for (var j = 0; j < block.preds.length; ++j)
+            {
+                if (cold[block.preds[j].blockId] !== true)
+                {
+                    allCold = false;
+                    break;
+                }
+            }
+
+            if (allCold === true)
+            {
+                cold[block.blockId] = true;
+                changed = true;
+            }
+        }
+    }
+
+    return cold;
+}
+
+/**
+Find the natural loops of a CFG. Returns an object which can identify
+loop back edges and loop exit edges.
+*/
+orderBlocks.findLoops = function (entry, blocks)
+{
+    // Back edges, as a map of block ids to successor block lists
+    var backEdges = [];
+
+    // Loop bodies, as sets of block ids
+    var bodies = [];
+
+    // Perform an iterative DFS to find the back edges, which are
+    // edges to blocks currently on the DFS stack
+    var onStack = [];
+    var visited = [];
+    var stack = [{ block: entry, next: 0 }];
+    visited[entry.blockId] = true;
+    onStack[entry.blockId] = true;
+
+    while (stack.length > 0)
+    {
+        var top = stack[stack.length-1];
+        var succs = top.block.succs;
+
+        if (top.next >= succs.length)
+        {
+            onStack[top.block.blockId] = false;
+            stack.pop();
+            continue;
+        }
+
+        var succ = succs[top.next++];
+
+        if (onStack[succ.blockId] === true)
+        {
+            if (backEdges[top.block.blockId] === undefined)
+                backEdges[top.block.blockId] = [];
+            backEdges[top.block.blockId].push(succ);
+
+            bodies.push(orderBlocks.loopBody(succ, top.block));
+        }
+        else if (visited[succ.blockId] !== true)
+        {
+            visited[succ.blockId] = true;
+            onStack[succ.blockId] = true;
+            stack.push({ block: succ, next: 0 });
+        }
+    }
+
+    return {
+        isBackEdge: function (pred, succ)
+        {
+            var succs = backEdges[pred.blockId];
+            return succs !== undefined && arraySetHas(succs, succ);
+        },
+
+        isExitEdge: function (pred, succ)
+        {
+            for (var i = 0; i < bodies.length; ++i)
+            {
+                var body = bodies[i];
+                if (body[pred.blockId] === true && body[succ.blockId] !== true)
+                    return true;
+            }
+
+            return false;
+        }
+    };
+}
+
+/**
+Compute the body of the natural loop for a back edge from the tail
+block to the loop header block
+*/
+orderBlocks.loopBody = function (header, tail)
+{
+    var body = [];
+    body[header.blockId] = true;
+
+    var work = [tail];
+    while (work.length > 0)
+    {
+        var b = work.pop();
+
+        if (body[b.blockId] === true)
+            continue;
+
+        body[b.blockId] = true;
+
+        for (var i = 0; i < b.preds.length; ++i)
+            work.push(b.preds[i]);
+    }
+
+    return body;
+}
+
+/**
+@class Edge execution counts for a set of functions. Profiles are
+collected by instrumenting the CFG edge transition stubs with counters,
+and can be saved to and loaded from a file. Functions are identified by
+name and source location, and edges by the names of their blocks, so a
+profile is only meaningful for the compiler version that produced it.
+*/
+function EdgeProfile()
+{
+    /**
+    @field Edge counts for each function, by function key
+    */
+    this.funcs = {};
+
+    /**
+    @field Counter memory blocks allocated for instrumented functions
+    */
+    this.counters = [];
+}
+
+/**
+Get the key identifying a CFG edge in the profile
+*/
+EdgeProfile.getEdgeKey = function (pred, succ)
+{
+    return pred.getBlockName() + '->' + succ.getBlockName();
+}
+
+/**
+Load a profile from a file
+*/
+EdgeProfile.readFile = function (fileName)
+{
+    var profile = new EdgeProfile();
+
+    var data = JSON.parse(readFile(fileName));
+
+    for (var funcKey in data)
+        profile.funcs[funcKey] = data[funcKey];
+
+    return profile;
+}
+
+/**
+Write the profile to a file
+*/
+EdgeProfile.prototype.writeFile = function (fileName)
+{
+    this.collect();
+
+    writeFile(fileName, JSON.stringify(this.funcs));
+}
+
+/**
+Get the edge counts for a function. Returns undefined if the function
+does not appear in the profile.
+*/
+EdgeProfile.prototype.getFuncCounts = function (irFunc)
+{
+    var edges = this.funcs[irFunc.getProfileKey()];
+
+    if (edges === undefined)
+        return undefined;
+
+    return {
+        getCount: function (pred, succ)
+        {
+            var count = edges[EdgeProfile.getEdgeKey(pred, succ)];
+            return (count !== undefined)? count:0;
+        }
+    };
+}
+
+/**
+Allocate the counters for the edges of a function. Returns an object
+mapping edge keys to counter addresses, as numbers.
+*/
+EdgeProfile.prototype.allocCounters = function (irFunc, cntSizeBytes)
+{
+    var cfg = irFunc.lirCFG;
+
+    var edgeKeys = [];
+    for (var i = 0; i < cfg.blocks.length; ++i)
+    {
+        var block = cfg.blocks[i];
+        for (var j = 0; j < block.succs.length; ++j)
+            edgeKeys.push(EdgeProfile.getEdgeKey(block, block.succs[j]));
+    }
+
+    var counters = {
+        funcKey: irFunc.getProfileKey(),
+        edgeKeys: edgeKeys,
+        cntSizeBytes: cntSizeBytes,
+        memBlock: null,
+        addrs: {}
+    };
+
+    if (edgeKeys.length === 0)
+        return counters;
+
+    counters.memBlock = allocZeroedBlock(edgeKeys.length * cntSizeBytes);
+
+    for (var i = 0; i < edgeKeys.length; ++i)
+    {
+        var addrBytes = getBlockAddr(counters.memBlock, i * cntSizeBytes);
+        counters.addrs[edgeKeys[i]] = addrToNum(addrBytes);
+    }
+
+    this.counters.push(counters);
+
+    return counters;
+}
+
+/**
+Read the values of the edge counters into the profile
+*/
+EdgeProfile.prototype.collect = function ()
+{
+    for (var i = 0; i < this.counters.length; ++i)
+    {
+        var counters = this.counters[i];
+
+        var edges = this.funcs[counters.funcKey];
+        if (edges === undefined)
+            edges = this.funcs[counters.funcKey] = {};
+
+        for (var j = 0; j < counters.edgeKeys.length; ++j)
+        {
+            var count = 0;
+            for (var k = counters.cntSizeBytes - 1; k >= 0; --k)
+            {
+                count = count * 256 + readFromMemoryBlock(
+                    counters.memBlock,
+                    j * counters.cntSizeBytes + k
+                );
+            }
+
+            edges[counters.edgeKeys[j]] = count;
+        }
+    }
+}
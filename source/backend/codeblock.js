@@ -183,21 +183,18 @@ Write a byte at the current position
 */
 CodeBlock.prototype.writeByte = function (val)
 {
-    assert (
-        this.memBlock,
-        'invalid memory block'
-    );
+    // The checks are written out so that no error message gets built
+    // for every byte written
+    if (this.writePos >= this.size)
+    {
+        error(
+            'no space to write byte in code block ' +
+            '(pos ' + this.writePos + '/' + this.size + ')'
+        );
+    }
 
-    assert (
-        this.writePos + 1 <= this.size,
-        'no space to write byte in code block ' +
-        '(pos ' + this.writePos + '/' + this.size + ')'
-    );
-
-    assert (
-        isNonNegInt(val) && val <= 255,
-        'invalid byte value: ' + val
-    );
+    if (DEBUG === true && !(isNonNegInt(val) && val <= 255))
+        error('invalid byte value: ' + val);
 
     writeToMemoryBlock(this.memBlock, this.writePos, val);
 
@@ -223,15 +220,35 @@ CodeBlock.prototype.writeInt = function (val, numBits)
         'the number of bits must be a positive multiple of 8'
     );
 
+    // Compute the size in bytes
+    var numBytes = numBits / 8;
+
+    // If the value is a 32-bit JS integer, write its bytes directly,
+    // the bytes past the low 32 bits being sign bytes
+    if (typeof val === 'number' && 
+        val >= -2147483648 && val <= 2147483647 && (val | 0) === val)
+    {
+        if (numBits < 32 &&
+            (val < -(1 << (numBits - 1)) || val >= (1 << numBits)))
+        {
+            error(
+                'integer value does not fit within ' + numBits + 
+                ' bits: ' + val
+            );
+        }
+
+        for (var i = 0; i < numBytes; ++i)
+            this.writeByte((i < 4)? ((val >> (8 * i)) & 0xFF):((val < 0)? 0xFF:0));
+
+        return;
+    }
+
     assert (
         num_ge(val, getIntMin(numBits)) &&
         num_le(val, getIntMax(numBits, true)),
         'integer value does not fit within ' + numBits + ' bits: ' + val
     );
 
-    // Compute the size in bytes
-    var numBytes = numBits / 8;
-
     // Write out the bytes
     for (var i = 0; i < numBytes; ++i)
     {
@@ -246,20 +263,28 @@ CodeBlock.prototype.writeInt = function (val, numBits)
 }
 
 /**
-Write a link value at the current position
+Write a link value at the current position. If an entry point label
+name is given, the value is a function and the offset of that entry
+point relative to the end of the link value is written.
 */
-CodeBlock.prototype.writeLink = function (linkVal, numBits)
+CodeBlock.prototype.writeLink = function (linkVal, numBits, entry)
 {
     assert (
         numBits === 32 || numBits === 64,
         'invalid link value size'
     );
 
+    assert (
+        entry === undefined || (linkVal instanceof IRFunction && numBits === 32),
+        'invalid relative link value'
+    );
+
     // Store the link value and its position
     this.imports.push(
         {
             value: linkVal,
-            pos: this.writePos
+            pos: this.writePos,
+            entry: entry
         }
     );
 
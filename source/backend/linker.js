@@ -69,8 +69,14 @@ function linkCode(codeBlock, backend, params)
         // Set the write position
         codeBlock.setWritePos(imported.pos);
 
+        // If this is a relative reference to a function entry point
+        if (value instanceof IRFunction && imported.entry !== undefined)
+        {
+            linkDirectRef(codeBlock, i, backend);
+        }
+
         // If this is a static function reference
-        if (value instanceof IRFunction)
+        else if (value instanceof IRFunction)
         {
             // If the function has no compiled code block
             if ((value.codeBlock instanceof CodeBlock) === false)
@@ -128,3 +134,125 @@ function linkCode(codeBlock, backend, params)
     }
 }
 
+/**
+Link a relative reference to a function entry point, as used by direct
+calls and jumps. The 32-bit offset is written in place when the entry
+point is within range. Otherwise, the reference goes through the far
+jump stub of the block, which jumps to the absolute entry point address.
+*/
+function linkDirectRef(codeBlock, refIdx, backend)
+{
+    var imported = codeBlock.imports[refIdx];
+    var value = imported.value;
+
+    // Position of the target address and kind of the reference entry
+    var refPos = imported.pos;
+    var refKind;
+
+    // Address the reference goes to
+    var targetAddr;
+
+    // If the function has no compiled code block, go through the far
+    // jump stub with a null address, so that running this call site
+    // faults instead of falling through to the next instruction. The
+    // primitives are all compiled before they are linked with each
+    // other, and later units only call compiled functions, so this
+    // only happens in code which never runs, such as the units the
+    // backend tests compile before the primitives. The collector
+    // ignores the reference until it is linked.
+    if ((value.codeBlock instanceof CodeBlock) === false)
+    {
+        log.debug('function not linked: ' + value.getValName());
+
+        refKind = 0;
+
+        if (imported.stubPos !== undefined)
+        {
+            codeBlock.setWritePos(imported.stubPos + 6);
+            codeBlock.writeInt(0, 64);
+
+            targetAddr = codeBlock.getAddress(imported.stubPos);
+        }
+        else
+        {
+            targetAddr = [0, 0, 0, 0];
+        }
+    }
+    else
+    {
+        log.debug('*** linking direct ref to func: ' + value.getValName());
+
+        // The upper bits of the reference kind encode the offset of the
+        // entry point, so that the collector can find the callee's block
+        var entryOffset = value.codeBlock.exports[imported.entry];
+
+        refKind = 4 + entryOffset * 256;
+        targetAddr = value.codeBlock.getExportAddr(imported.entry);
+    }
+
+    // Compute the target offset relative to the end of the 32-bit
+    // reference, which is where the call or jump returns
+    var nextAddr = codeBlock.getAddress(imported.pos + 4);
+    var relOffset = num_sub(addrToNum(targetAddr), addrToNum(nextAddr));
+
+    var inRange = (
+        num_ge(relOffset, getIntMin(32)) &&
+        num_le(relOffset, getIntMax(32))
+    );
+
+    // In 32-bit mode, the offset wraps around the address space
+    if (inRange === false && imported.stubPos === undefined)
+    {
+        assert (
+            backend.regSizeBits === 32,
+            'no far jump stub for direct reference to "' +
+            value.funcName + '"'
+        );
+
+        if (num_gt(relOffset, 0))
+            relOffset = num_sub(relOffset, num_shift(1, 32));
+        else
+            relOffset = num_add(relOffset, num_shift(1, 32));
+    }
+
+    // If the entry point is out of range, or far references are forced,
+    // store its absolute address in the far jump stub and go through it
+    else if (refKind !== 0 && imported.stubPos !== undefined &&
+             (inRange === false || backend.farDirectRefs === true))
+    {
+        log.debug('using far jump stub for: ' + value.getValName());
+
+        refPos = imported.stubPos + 6;
+        refKind = 5 + entryOffset * 256;
+
+        codeBlock.setWritePos(refPos);
+        codeBlock.writeBytes(targetAddr);
+
+        relOffset = imported.stubPos - (imported.pos + 4);
+    }
+
+    // Write the relative offset
+    codeBlock.setWritePos(imported.pos);
+    codeBlock.writeInt(relOffset, 32);
+
+    // Update the reference entry
+    codeBlock.setWritePos(
+        readRefsOffset(codeBlock) +
+        refIdx * CodeBlock.REF_ENTRY_SIZE
+    );
+    codeBlock.writeInt(refPos, 32);
+    codeBlock.writeInt(refKind, 32);
+}
+
+/**
+Read the offset of the reference entries from a code block header
+*/
+function readRefsOffset(codeBlock)
+{
+    var offset = 0;
+
+    for (var i = 3; i >= 0; --i)
+        offset = offset * 256 + codeBlock.readByte(4 + i);
+
+    return offset;
+}
@@ -49,123 +49,250 @@ Maxime Chevalier-Boisvert
 */
 
 /**
-Liveness analysis used by the register allocator
+Liveness analysis used by the register allocator. Live sets are computed
+for each block, as bit sets over the value index. The liveness at the
+output of individual instructions is derived from them on demand.
 */
 function liveAnalysis(blockOrder)
 {
-    //
-    // Liveness analysis
-    //
+    var cfg = blockOrder[0].parentCFG;
 
-    // Work list for the analysis
-    var workList = new LinkedList();
+    // Number the values used in the CFG
+    var index = new ValueIndex(cfg);
 
-    // Add the blocks to the work list, in reverse order
-    for (var i = blockOrder.length - 1; i >= 0; --i)
-        workList.addLast(blockOrder[i]);
+    // Values defined and values used before being defined in each block,
+    // and phi nodes of each block, indexed by block id
+    var killSets = [];
+    var genSets = [];
+    var phiSets = [];
 
-    // Array to store live sets at the input of each block, after the phi nodes
-    // This may include phi nodes from the block, if they are used
-    var blockLiveIn = [];
-
-    // Array of sets of live variables after individual instructions
-    var instrLiveOut = [];
-
-    // Until the work list is empty
-    while (workList.isEmpty() === false)
+    for (var i = 0; i < blockOrder.length; ++i)
     {
-        var block = workList.remFirst();
+        var block = blockOrder[i];
 
-        //print('processing block: ' + block.getBlockName());
+        var killSet = new BitSet(index.size);
+        var genSet = new BitSet(index.size);
+        var phiSet = undefined;
 
-        // Compute the union of the successor live in sets
-        var liveCur = new HashMap();
-        for (var i = 0; i < block.succs.length; ++i)
+        for (var j = 0; j < block.instrs.length; ++j)
         {
-            var succ = block.succs[i];
+            var instr = block.instrs[j];
 
-            var liveSucc = blockLiveIn[succ.blockId];
-            if (liveSucc === undefined)
+            // Phi node uses are live on the incoming edges
+            if (instr instanceof PhiInstr)
+            {
+                if (phiSet === undefined)
+                    phiSet = new BitSet(index.size);
+                phiSet.add(instr.instrId);
                 continue;
+            }
 
-            for (var itr = liveSucc.getItr(); itr.valid(); itr.next())
-            {
-                var value = itr.get().key;
+            for (var k = 0; k < instr.uses.length; ++k)
+                genSet.add(index.getIndex(instr.uses[k]));
 
-                // If this value is a phi node from the successor,
-                // don't add it to the live set
-                if (value instanceof PhiInstr && value.parentBlock === succ)
-                    continue;
+            killSet.add(instr.instrId);
+        }
 
-                liveCur.set(value);
-            }
+        // In SSA form, values defined in the block are defined before
+        // their uses in the block
+        genSet.diff(killSet);
 
-            for (var j = 0; j < succ.instrs.length; ++j)
-            {
-                var instr = succ.instrs[j];
+        killSets[block.blockId] = killSet;
+        genSets[block.blockId] = genSet;
+        phiSets[block.blockId] = phiSet;
+    }
 
-                if ((instr instanceof PhiInstr) === false)
-                    break;
+    /**
+    Add the values live on an edge to the live out set of the predecessor
+    */
+    function edgeFunc(pred, succ, liveIn, liveOut)
+    {
+        var phiSet = phiSets[succ.blockId];
 
-                var inc = instr.getIncoming(block);
-                liveCur.set(inc);
-            }
+        // If the successor has no phi nodes, its live in set is live
+        if (phiSet === undefined)
+        {
+            liveOut.union(liveIn);
+            return;
         }
 
-        // For each instruction, in reverse order
-        for (var i = block.instrs.length - 1; i >= 0; --i)
+        // The phi nodes of the successor are not live, their incoming
+        // values for this predecessor are
+        liveOut.unionExcept(liveIn, phiSet);
+
+        for (var i = 0; i < succ.instrs.length; ++i)
         {
-            var instr = block.instrs[i];
+            var instr = succ.instrs[i];
 
-            // If this instruction is a phi node, continue
-            if (instr instanceof PhiInstr)
-                continue;
+            if ((instr instanceof PhiInstr) === false)
+                break;
 
-            // Remove the output of this instruction from the live set
-            if (instr.dests.length > 0)
-                liveCur.rem(instr);
+            liveOut.add(index.getIndex(instr.getIncoming(pred)));
+        }
+    }
 
-            /*
-            log.debug('instr live out: ' + instr);
-            for (var itr = liveCur.getItr(); itr.valid(); itr.next())
-                log.debug(itr.get().key.getValName());
-            */
+    /**
+    Compute the live in set of a block from its live out set
+    */
+    function transFunc(block, liveSet)
+    {
+        liveSet.diff(killSets[block.blockId]);
+        liveSet.union(genSets[block.blockId]);
+    }
 
-            // Store the live set at the output of this instruction
-            instrLiveOut[instr.instrId] = liveCur.copy();
+    var sets = solveDataflow(
+        getBlockRPO(cfg.entry),
+        true,
+        index.size,
+        edgeFunc,
+        transFunc
+    );
 
-            // Map all uses in the live set
-            for (var j = 0; j < instr.uses.length; ++j)
-                liveCur.set(instr.uses[j]);
-        }
+    return new LiveInfo(index, sets.inSets, sets.outSets);
+}
+
+/**
+@class Result of the liveness analysis
+*/
+function LiveInfo(index, inSets, outSets)
+{
+    /**
+    Value index the live sets are defined over
+    @field
+    */
+    this.index = index;
+
+    /**
+    Live sets at the input of each block, after the phi nodes, indexed by
+    block id. These may include phi nodes from the block, if they are used.
+    @field
+    */
+    this.inSets = inSets;
+
+    /**
+    Live sets at the output of each block, indexed by block id
+    @field
+    */
+    this.outSets = outSets;
+
+    /**
+    Block for which instruction positions and last uses were computed
+    @field
+    */
+    this.curBlock = undefined;
+
+    /**
+    Position of each instruction of the current block, by instruction id
+    @field
+    */
+    this.instrPos = undefined;
+
+    /**
+    Position of the last use of each value in the current block, by index
+    @field
+    */
+    this.lastUse = undefined;
+}
+LiveInfo.prototype = {};
+
+/**
+Get the set of values live at the input of a block
+*/
+LiveInfo.prototype.getLiveIn = function (block)
+{
+    return new LiveSet(this.index, this.inSets[block.blockId]);
+};
 
-        // Find the current live in set for this block
-        var liveInCur = blockLiveIn[block.blockId];
+/**
+Test if a value is live after an instruction. The output of the
+instruction itself is not considered live after it.
+*/
+LiveInfo.prototype.isLiveOut = function (val, instr)
+{
+    var block = instr.parentBlock;
+
+    // Compute the instruction positions and last uses for this block
+    if (block !== this.curBlock)
+    {
+        this.curBlock = block;
+        this.instrPos = [];
+        this.lastUse = [];
 
-        // If the new live set has more temps
-        if (liveInCur === undefined || liveInCur.length !== liveCur.length)
+        for (var i = 0; i < block.instrs.length; ++i)
         {
-            /*
-            print('updating');
-            print('');
-            print('live in for ' + block.getBlockName());
-            for (var itr = liveCur.getItr(); itr.valid(); itr.next())
-                print(itr.get().key.getValName());
-            print('');
-            */
-
-            // Replace the live in set for this block
-            blockLiveIn[block.blockId] = liveCur;
-
-            // Add all predecessors to the work list
-            for (var i = 0; i < block.preds.length; ++i)
-                workList.addLast(block.preds[i]);
+            var blockInstr = block.instrs[i];
+
+            this.instrPos[blockInstr.instrId] = i;
+
+            if (blockInstr instanceof PhiInstr)
+                continue;
+
+            for (var j = 0; j < blockInstr.uses.length; ++j)
+                this.lastUse[this.index.getIndex(blockInstr.uses[j])] = i;
         }
     }
 
-    return {
-        blockIn: blockLiveIn,
-        instrOut: instrLiveOut
-    };
+    var idx = this.index.getIndex(val);
+
+    if (idx === -1)
+        return false;
+
+    var pos = this.instrPos[instr.instrId];
+
+    // Values defined at or after this instruction are not live
+    if (val instanceof IRInstr && 
+        val.parentBlock === block &&
+        !(val instanceof PhiInstr) &&
+        this.instrPos[val.instrId] >= pos)
+        return false;
+
+    var lastUse = this.lastUse[idx];
+
+    return (
+        (lastUse !== undefined && lastUse > pos) ||
+        this.outSets[block.blockId].has(idx)
+    );
+};
+
+/**
+@class Set of live values
+*/
+function LiveSet(index, bitSet)
+{
+    /**
+    Value index
+    @field
+    */
+    this.index = index;
+
+    /**
+    Bit set of the live value indices
+    @field
+    */
+    this.bitSet = bitSet;
 }
+LiveSet.prototype = {};
+
+/**
+Test if a value is in the live set
+*/
+LiveSet.prototype.has = function (val)
+{
+    var idx = this.index.getIndex(val);
+
+    return (idx !== -1 && this.bitSet.has(idx));
+};
+
+/**
+Get an array of the values in the live set
+*/
+LiveSet.prototype.getValues = function ()
+{
+    var values = [];
+
+    for (var itr = this.bitSet.getItr(); itr.valid(); itr.next())
+        values.push(this.index.getValue(itr.get()));
+
+    return values;
+};
 
@@ -129,6 +129,19 @@ x86.Assembler.prototype.getFirstInstr = function ()
     return this.firstInstr;
 }
 
+/**
+Count the instructions in the list
+*/
+x86.Assembler.prototype.countInstrs = function ()
+{
+    var numInstrs = 0;
+
+    for (var instr = this.firstInstr; instr !== null; instr = instr.next)
+        ++numInstrs;
+
+    return numInstrs;
+}
+
 /**
 Add an instruction at the end of the block
 */
@@ -250,120 +263,97 @@ x86.Assembler.prototype.assemble = function (codeOnly)
 {
     //print('assembling machine code');
 
+    // Instructions referencing labels, with their label references
+    var branches = [];
+    var branchRefs = [];
+
+    // Sizing pass: find the encodings of all the instructions, with
+    // label references initially as short as possible
+    for (var instr = this.firstInstr; instr !== null; instr = instr.next)
+    {
+        if (DEBUG === true && (instr instanceof x86.Instruction) === false)
+            error('invalid instruction: ' + instr);
+
+        if (instr instanceof x86.Label)
+            continue;
+
+        instr.getLength(this.x86_64);
+
+        for (var i = 0; i < instr.opnds.length; ++i)
+        {
+            if (instr.opnds[i] instanceof x86.LabelRef)
+            {
+                branches.push(instr);
+                branchRefs.push(instr.opnds[i]);
+            }
+        }
+    }
+
     // Total code length
     var codeLength;
 
-    // Flag to indicate an encoding changed
-    var changed = true;
-
-    // Until no encodings changed
-    while (changed === true)
+    // Relaxation pass: lay out the code, then grow the label references
+    // whose offsets do not fit. Sizes only grow, so this terminates, and
+    // a second layout is only needed when some reference grew.
+    for (;;)
     {
-        //print('iterating');
-
-        // Reset the code length
         codeLength = 0;
 
-        // No changes for this iteration yet
-        changed = false;
-
-        // For each instruction
         for (var instr = this.firstInstr; instr !== null; instr = instr.next)
         {
-            if (DEBUG === true && (instr instanceof x86.Instruction) === false)
-                error('invalid instruction: ' + instr);
-
-            // If this instruction is a label
             if (instr instanceof x86.Label)
-            {
-                // If the position of the label did not change, do nothing
-                if (instr.offset === codeLength)
-                    continue;
+                instr.offset = codeLength;
+            else
+                codeLength += instr.getLength(this.x86_64);
 
-                //print('label position changed for ' + instr + ' (' + codeLength + ')');
+            // Store the offset of the end of the instruction
+            instr.endOffset = codeLength;
+        }
 
-                // Note that the offset changed
-                changed = true;
+        // Flag to indicate a reference grew
+        var grew = false;
 
-                // Store the offset where the label currently is
-                instr.offset = codeLength;
-            }
+        for (var i = 0; i < branches.length; ++i)
+        {
+            var instr = branches[i];
+            var opnd = branchRefs[i];
+
+            // Compute the relative offset to the label
+            var relOffset = opnd.label.offset - instr.endOffset;
+
+            // Store the computed relative offset on the operand
+            opnd.relOffset = relOffset;
+
+            // Compute the relative offset size needed
+            var offSize;
+            if (relOffset >= -128 && relOffset <= 127)
+                offSize = 8;
+            else if (relOffset >= -32768 && relOffset <= 32767)
+                offSize = 16;
+            else if (relOffset >= -2147483648 && relOffset <= 2147483647)
+                offSize = 32;
             else
-            {
-                // Get the current instruction length
-                var curInstrLen = instr.getLength(this.x86_64);
+                error('relative offset does not fit within 32 bits');
 
-                // Add the current instruction length to the total
-                codeLength += curInstrLen;
+            // If the current size is sufficient, do nothing
+            if (offSize <= opnd.size)
+                continue;
 
-                // For each operand of the instruction
-                for (var i = 0; i < instr.opnds.length; ++i)
-                {
-                    var opnd = instr.opnds[i];
-
-                    // If this is a label reference
-                    if (opnd instanceof x86.LabelRef)
-                    {
-                        // Get a reference to the label
-                        var label = opnd.label;
-
-                        // Compute the relative offset to the label
-                        var relOffset = label.offset - codeLength;
-
-                        // Store the computed relative offset on the operand
-                        opnd.relOffset = relOffset;
-
-                        // Compute the updated relative offset size
-                        var offSize;
-                        if (num_ge(relOffset, getIntMin(8)) && num_le(relOffset, getIntMax(8)))
-                            offSize = 8;
-                        else if (num_ge(relOffset, getIntMin(16)) && num_le(relOffset, getIntMax(16)))
-                            offSize = 16;
-                        else if (num_ge(relOffset, getIntMin(32)) && num_le(relOffset, getIntMax(32)))
-                            offSize = 32;
-                        else
-                            error('relative offset does not fit within 32 bits');
-
-                        // If the offset size did not change, do nothing
-                        if (offSize === opnd.size)
-                            continue;
-
-                        // If the offset size is fixed, do not change it
-                        if (opnd.fixedSize === true)
-                        {
-                            assert (
-                                offSize < opnd.size,
-                                'fixed size specified is insufficient'
-                            );
-
-                            continue;
-                        }
-
-                        // Update the offset size
-                        opnd.size = offSize;
-
-                        /*
-                        print('offset size changed for ' + instr);
-                        instr.findEncoding(this.x86_64);
-                        print('instr length: ' + instr.getLength());
-                        */
-
-                        // Find an encoding for this instruction
-                        instr.findEncoding(this.x86_64);
-
-                        // Get the updated instruction length
-                        var newInstrLen = instr.getLength();
-               
-                        // Correct the total code length
-                        codeLength -= curInstrLen;
-                        codeLength += newInstrLen;
-
-                        // Note that the offset changed
-                        changed = true;                        
-                    }
-                }
-            }
+            // If the offset size is fixed, it cannot be changed
+            assert (
+                opnd.fixedSize === false,
+                'fixed size specified is insufficient'
+            );
+
+            // Update the offset size and find a new encoding
+            opnd.size = offSize;
+            instr.findEncoding(this.x86_64);
+
+            grew = true;
         }
+
+        if (grew === false)
+            break;
     }
 
     // If we are doing a raw assembly (code only)
@@ -378,21 +368,31 @@ x86.Assembler.prototype.assemble = function (codeOnly)
     }
     else
     {
-        // Count the number of imported references
+        // Count the number of imported references, and list the distinct
+        // entry points referenced by direct calls and jumps
         var numLinks = 0;
+        var farStubs = [];
         for (var instr = this.firstInstr; instr !== null; instr = instr.next)
         {
             for (var i = 0; i < instr.opnds.length; ++i)
             {
                 var opnd = instr.opnds[i];
 
-                if (opnd instanceof x86.LinkValue)
+                if (opnd instanceof x86.LinkValue ||
+                    opnd instanceof x86.LinkRef)
                     numLinks++;
+
+                if (opnd instanceof x86.LinkRef && this.x86_64 === true &&
+                    x86.findFarStub(farStubs, opnd) === null)
+                    farStubs.push({ value: opnd.value, entry: opnd.entry });
             }
         }
 
         // Compute the total code block size
-        var totalSize = CodeBlock.HEADER_SIZE + codeLength + numLinks * CodeBlock.REF_ENTRY_SIZE;
+        var totalSize =
+            CodeBlock.HEADER_SIZE + codeLength +
+            farStubs.length * x86.FAR_STUB_SIZE +
+            numLinks * CodeBlock.REF_ENTRY_SIZE;
 
         // Allocate a new code block for the code and metadata
         var codeBlock = new CodeBlock(totalSize);
@@ -402,13 +402,42 @@ x86.Assembler.prototype.assemble = function (codeOnly)
         // - Ref encoding offset (32-bit)
         // - Num ref entries (32-bit)
         codeBlock.writeInt(0, 32);
-        codeBlock.writeInt(CodeBlock.HEADER_SIZE + codeLength, 32);
+        codeBlock.writeInt(
+            CodeBlock.HEADER_SIZE + codeLength +
+            farStubs.length * x86.FAR_STUB_SIZE,
+            32
+        );
         codeBlock.writeInt(numLinks, 32);
 
         // Encode the instructions into the code block
         for (var instr = this.firstInstr; instr !== null; instr = instr.next)
             instr.encode(codeBlock, this.x86_64);
 
+        // Write the far jump stubs after the code. Each stub jumps to the
+        // absolute address stored right after it, which the linker fills
+        // in when the entry point is out of range of a 32-bit offset.
+        for (var i = 0; i < farStubs.length; ++i)
+        {
+            farStubs[i].pos = codeBlock.writePos;
+
+            // jmp qword [rip+0]
+            codeBlock.writeByte(0xFF);
+            codeBlock.writeByte(0x25);
+            codeBlock.writeInt(0, 32);
+
+            // Absolute address of the entry point
+            codeBlock.writeInt(0, 64);
+        }
+
+        // Associate the direct references with their far jump stub
+        for (var i = 0; i < codeBlock.imports.length; ++i)
+        {
+            var ref = codeBlock.imports[i];
+
+            if (ref.entry !== undefined && this.x86_64 === true)
+                ref.stubPos = x86.findFarStub(farStubs, ref).pos;
+        }
+
         // For each value linked in the code block
         for (var i = 0; i < codeBlock.imports.length; ++i)
         {
@@ -419,10 +448,12 @@ x86.Assembler.prototype.assemble = function (codeOnly)
 
             var val = ref.value;
 
-            // Encode the value kind
+            // Encode the value kind. Relative function references
+            // are ignored by the collector until the linker sets
+            // their kind, which encodes the entry point offset.
             var kind = 0;
             if (val instanceof IRFunction)
-                kind = 1;
+                kind = (ref.entry === undefined)? 1:0;
             else if (val.type === IRType.ref)
                 kind = 2;
             else if (val.type === IRType.box)
@@ -437,6 +468,27 @@ x86.Assembler.prototype.assemble = function (codeOnly)
     return codeBlock;
 };
 
+/**
+Size in bytes of the far jump stubs emitted for direct references
+*/
+x86.FAR_STUB_SIZE = 14;
+
+/**
+Find the far jump stub for the entry point of a direct reference
+*/
+x86.findFarStub = function (farStubs, ref)
+{
+    for (var i = 0; i < farStubs.length; ++i)
+    {
+        var stub = farStubs[i];
+
+        if (stub.value === ref.value && stub.entry === ref.entry)
+            return stub;
+    }
+
+    return null;
+};
+
 /**
 Anonymous function to initialize the assembler class
 */
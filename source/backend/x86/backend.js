@@ -132,6 +132,12 @@ x86.Backend = function (x86_64)
     Flag to enable the debug trace
     */
     this.debugTrace = false;
+
+    /**
+    Flag to link all direct calls and jumps through their far jump
+    stub, as if their target was out of range of a 32-bit offset
+    */
+    this.farDirectRefs = false;
 }
 x86.Backend.prototype = new Backend();
 
@@ -156,6 +162,20 @@ x86.Backend.prototype.genCode = function (irFunc, params)
     for (var i = 0; i < irFunc.childFuncs.length; ++i)
         backend.genCode(irFunc.childFuncs[i], params);
 
+    return traceFunc(
+        'codegen',
+        irFunc.funcName,
+        function () { return backend.genFuncCode(irFunc, params); }
+    );
+}
+
+/**
+Generate machine code for an IR function, excluding its child functions
+*/
+x86.Backend.prototype.genFuncCode = function (irFunc, params)
+{
+    var backend = this;
+
     log.debug('');
     log.debug('generating code for "' + irFunc.funcName + '"');
 
@@ -168,7 +188,7 @@ x86.Backend.prototype.genCode = function (irFunc, params)
         function ()
         {
             // Compute a block ordering for the function
-            blockOrder = orderBlocks(cfg.entry, cfg.blocks);
+            blockOrder = orderBlocks(cfg.entry, cfg.blocks, params);
 
             /*
             log.debug('order:');
@@ -195,6 +215,13 @@ x86.Backend.prototype.genCode = function (irFunc, params)
         {
             // Produce assembler for the function
             assembler = x86.genCode(irFunc, blockOrder, liveness, backend, params);
+        },
+        function ()
+        {
+            // LIR instructions in, machine instructions out
+            if (assembler === undefined)
+                return cfg.getNumInstrs();
+            return assembler.countInstrs();
         }
     );
 
@@ -206,7 +233,8 @@ x86.Backend.prototype.genCode = function (irFunc, params)
 
             // Run the peephole optimizer
             x86.optimize(assembler);
-        }
+        },
+        function () { return assembler.countInstrs(); }
     );
 
     log.debug('DONE OPTIMIZING');
@@ -61,6 +61,9 @@ x86.genCode = function (irFunc, blockOrder, liveness, backend, params)
     // Get the calling convention for this function
     var callConv = params.backend.getCallConv(irFunc.cProxy? 'c':'tachyon');
 
+    // Mark the calls which can be compiled as tail calls
+    x86.markTailCalls(irFunc, blockOrder, backend, params);
+
     // Map of block ids to allocation map at block entries
     // This is used to store allocations at blocks with
     // multiple predecessors
@@ -226,6 +229,16 @@ x86.genCode = function (irFunc, blockOrder, liveness, backend, params)
         }
     }
 
+    // If edge profiling is enabled, allocate the edge counters
+    var edgeCounters = undefined;
+    if (params.edgeProfile instanceof EdgeProfile)
+    {
+        edgeCounters = params.edgeProfile.allocCounters(
+            irFunc,
+            backend.regSizeBytes
+        );
+    }
+
     // Code generation info object
     var genInfo = {
         irFunc: irFunc,
@@ -257,12 +270,13 @@ x86.genCode = function (irFunc, blockOrder, liveness, backend, params)
                 pred, 
                 block,
                 exitAllocMaps[pred.blockId],
-                liveness.blockIn[block.blockId],
+                liveness.getLiveIn(block),
                 allocMaps,
                 blockLabels,
                 edgeLabels,
                 asm,
-                params
+                params,
+                edgeCounters
             );
         }
 
@@ -287,14 +301,6 @@ x86.genCode = function (irFunc, blockOrder, liveness, backend, params)
 
             //log.debug('processing: ' + instr);
 
-            // Get the live set at output of this instruction
-            var instrLiveOut = liveness.instrOut[instr.instrId];
-            
-            if (DEBUG === true && !(instr instanceof PhiInstr || instrLiveOut instanceof HashMap))
-            {
-                error('invalid live out map for: ' + instr.getValName());
-            }
-
             /**
             Test liveness of values before the instruction
             */
@@ -303,7 +309,7 @@ x86.genCode = function (irFunc, blockOrder, liveness, backend, params)
                 if (arraySetHas(instr.uses, val) === true)
                     return true;
 
-                return instrLiveOut.has(val);
+                return liveness.isLiveOut(val, instr);
             }
 
             /**
@@ -311,7 +317,7 @@ x86.genCode = function (irFunc, blockOrder, liveness, backend, params)
             */
             function liveOutFunc(val)
             {
-                return instrLiveOut.has(val);
+                return liveness.isLiveOut(val, instr);
             }
 
             // Store the live out function in the code generation into
@@ -473,12 +479,13 @@ x86.genCode = function (irFunc, blockOrder, liveness, backend, params)
                 block, 
                 succ,
                 allocMap,
-                liveness.blockIn[succ.blockId],
+                liveness.getLiveIn(succ),
                 allocMaps,
                 blockLabels,
                 edgeLabels,
                 asm,
-                params
+                params,
+                edgeCounters
             );
         }
     }
@@ -509,6 +516,110 @@ x86.genCode = function (irFunc, blockOrder, liveness, backend, params)
     return asm;
 }
 
+/**
+Mark the function calls in tail position which can reuse the stack frame
+of the current function. A call is in tail position if its value is
+returned directly, possibly through phi nodes of a return block. The callee
+must receive as many stack arguments as the current function, so that the
+argument slots can be reused and the stack is cleaned up correctly.
+*/
+x86.markTailCalls = function (irFunc, blockOrder, backend, params)
+{
+    // Get the calling convention for this function
+    var callConv = backend.getCallConv(irFunc.cProxy? 'c':'tachyon');
+
+    // Get the number of incoming stack arguments
+    var numArgs = irFunc.argVars.length + 2;
+    var numArgSlots = Math.max(numArgs - callConv.argRegs.length, 0);
+
+    // Functions with a variable stack frame layout can't make tail calls
+    var canTailCall = (
+        irFunc.cProxy === false &&
+        irFunc.usesArguments === false &&
+        callConv.cleanup === 'CALLEE' &&
+        callConv.argOrder === 'LTR' &&
+        callConv.calleeSave.length === 0 &&
+        backend.debugTrace !== true
+    );
+
+    /**
+    Test if a block only returns the value of a call made in a predecessor
+    */
+    function returnsValue(block, pred, value)
+    {
+        for (var i = 0; i < block.instrs.length; ++i)
+        {
+            var instr = block.instrs[i];
+
+            if (instr instanceof PhiInstr)
+            {
+                if (instr.getIncoming(pred) === value)
+                    var phiVal = instr;
+                continue;
+            }
+
+            return (
+                i === block.instrs.length - 1 &&
+                instr instanceof RetInstr &&
+                instr.uses.length === 1 &&
+                (instr.uses[0] === value || instr.uses[0] === phiVal)
+            );
+        }
+
+        return false;
+    }
+
+    for (var i = 0; i < blockOrder.length; ++i)
+    {
+        var block = blockOrder[i];
+
+        for (var j = 0; j < block.instrs.length; ++j)
+        {
+            var instr = block.instrs[j];
+
+            if ((instr instanceof CallFuncInstr) === false)
+                continue;
+
+            instr.tailCall = false;
+
+            if (canTailCall === false ||
+                instr.x86.calleeConv !== 'tachyon' ||
+                instr.getThrowTarget() !== null)
+                continue;
+
+            // The callee must receive as many stack arguments as we did
+            var numCallArgs = instr.uses.length - 1;
+            var numStackArgs = Math.max(numCallArgs - callConv.argRegs.length, 0);
+            if (numStackArgs !== numArgSlots)
+                continue;
+
+            var next = block.instrs[j+1];
+
+            // If the call value is returned directly
+            if (next instanceof RetInstr)
+            {
+                instr.tailCall = (next.uses[0] === instr);
+            }
+
+            // If the call is followed by a jump or continues to a block
+            // which returns its value
+            else
+            {
+                var contBlock = null;
+                if (next instanceof JumpInstr)
+                    contBlock = next.targets[0];
+                else if (next === undefined)
+                    contBlock = instr.getContTarget();
+
+                instr.tailCall = (
+                    contBlock !== null &&
+                    returnsValue(contBlock, block, instr)
+                );
+            }
+        }
+    }
+}
+
 /*
 Generate code for CFG block edge transitions
 */
@@ -521,7 +632,8 @@ x86.genEdgeTrans = function (
     blockLabels,
     edgeLabels,
     asm,
-    params
+    params,
+    edgeCounters
 )
 {
     // Get a reference to the backend
@@ -531,6 +643,16 @@ x86.genEdgeTrans = function (
     var transLabel = edgeLabels.get({pred:pred, succ:succ});
     asm.addInstr(transLabel);
 
+    // If edge profiling is enabled, count the traversals of this edge
+    if (edgeCounters !== undefined)
+    {
+        x86.genEdgeCounter(
+            asm,
+            edgeCounters.addrs[EdgeProfile.getEdgeKey(pred, succ)],
+            params
+        );
+    }
+
     if (config.verbosity >= log.DEBUG)
     {
         log.debug(
@@ -635,10 +757,11 @@ x86.genEdgeTrans = function (
         }
 
         // For each value live after the phi nodes
-        for (var itr = succLiveIn.getItr(); itr.valid(); itr.next())
+        var liveVals = succLiveIn.getValues();
+        for (var k = 0; k < liveVals.length; ++k)
         {
             // Get the value
-            var value = itr.get().key;
+            var value = liveVals[k];
 
             //print('live value: ' + value.getValName());
 
@@ -792,10 +915,11 @@ x86.genEdgeTrans = function (
         }
 
         // For each value live after the phi nodes
-        for (var itr = succLiveIn.getItr(); itr.valid(); itr.next())
+        var liveVals = succLiveIn.getValues();
+        for (var k = 0; k < liveVals.length; ++k)
         {
             // Get the value
-            var value = itr.get().key;
+            var value = liveVals[k];
 
             // If the value is a phi node from this block, skip it
             if (value instanceof PhiInstr && value.parentBlock === succ)
@@ -1156,6 +1280,9 @@ Encode information about the stack frame in the instruction stream.
 Note: this is used for the GC and exceptions.
 
 Stack info format (packed):
+- Padding (8-bit)
+- Landing pad displacement from the return address, 0 if none (16-bit)
+- Magic code (16-bit)
 - Call align/pad space (16-bit)
 - Num stack slots (16-bit)
 - Return address slot index (16-bit)
@@ -1170,7 +1297,8 @@ x86.writeStackInfo = function (
     dynAlign,
     varArgs,
     padSpace,
-    backend
+    backend,
+    genLandingPad
 )
 {
     // Label to skip the stack info
@@ -1188,8 +1316,14 @@ x86.writeStackInfo = function (
     // Create a data block for the stack info
     var data = new x86.DataBlock(); 
 
-    // Add 3 padding bytes, for a total of 8 bytes before the data
-    data.writeInt(0, 24);
+    // Add 1 padding byte
+    data.writeInt(0, 8);
+
+    // Landing pad displacement, patched below if there is a landing pad.
+    // Together with the jump, this makes for a total of 8 bytes before
+    // the magic code.
+    var padDispIdx = data.values.length;
+    data.writeInt(0, 16);
 
     // Write magic code
     data.writeInt(1337, 16);
@@ -1301,10 +1435,46 @@ x86.writeStackInfo = function (
     // Add the stack info to the instruction stream
     asm.addInstr(data);
 
+    // If there is an exception landing pad for this call site
+    if (genLandingPad !== undefined)
+    {
+        // The landing pad directly follows the stack info. It is only
+        // entered by the unwinder, the normal return path jumps over it.
+        // Its displacement accounts for the 5-byte jump.
+        var padDisp = 5 + data.length;
+
+        assert (
+            padDisp <= getIntMax(16, false),
+            'landing pad displacement too large'
+        );
+
+        data.values[padDispIdx].value = padDisp;
+
+        genLandingPad(asm);
+    }
+
     // Add a label after the stack info
     asm.addInstr(POST_INFO);
 }
 
+/**
+Generate code to increment an edge profiling counter. The condition
+flags are clobbered, which is safe since edge transition stubs are
+only entered after the branch has been taken.
+*/
+x86.genEdgeCounter = function (asm, cntAddr, params)
+{
+    const backend = params.backend;
+
+    // Use the first GP register to hold the counter address
+    var addrReg = backend.gpRegSet[0];
+
+    asm.push(addrReg);
+    asm.mov(addrReg, cntAddr);
+    asm.add(new x86.MemLoc(backend.regSizeBits, addrReg, 0), 1);
+    asm.pop(addrReg);
+}
+
 /**
 Generate the argument normalization stub
 */
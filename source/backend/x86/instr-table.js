@@ -114,6 +114,9 @@ x86.instrTable = [
     {mnem: 'and', opnds: ['r32', 'r/m32'], opCode: [0x23]},
     {mnem: 'and', opnds: ['r64', 'r/m64'], opCode: [0x23], REX_W: 1},
 
+    // Bitwise AND of packed doubles
+    {mnem: 'andpd', opnds: ['xmm', 'xmm/m128'], prefix: [0x66], opCode: [0x0F, 0x54]},
+
     // Call (relative and absolute)
     {mnem: 'call', opnds: ['rel32'], opCode: [0xE8]},
     {mnem: 'call', opnds: ['r/m32'], opCode: [0xFF], opExt: 2, x86_64: false},
@@ -248,6 +251,10 @@ x86.instrTable = [
     {mnem: 'cvtsd2si', opnds: ['r32', 'xmm/m64'], prefix: [0xF2], opCode: [0x0F, 0x2D]},
     {mnem: 'cvtsd2si', opnds: ['r64', 'xmm/m64'], prefix: [0xF2], opCode: [0x0F, 0x2D], REX_W: 1},
 
+    // Convert scalar double to integer with truncation
+    {mnem: 'cvttsd2si', opnds: ['r32', 'xmm/m64'], prefix: [0xF2], opCode: [0x0F, 0x2C]},
+    {mnem: 'cvttsd2si', opnds: ['r64', 'xmm/m64'], prefix: [0xF2], opCode: [0x0F, 0x2C], REX_W: 1},
+
     // Decrement by 1
     {mnem: 'dec', opnds: ['r/m8'], opCode: [0xFE], opExt: 1},
     {mnem: 'dec', opnds: ['r/m16'], opCode: [0xFF], opExt: 1, szPref: true},
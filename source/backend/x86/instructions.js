@@ -87,6 +87,11 @@ x86.Instruction = function ()
     @field Length of the instruction encoding
     */
     this.encLength = 0;
+
+    /**
+    @field Offset of the end of the instruction, set by the assembler
+    */
+    this.endOffset = 0;
 }
 
 /**
@@ -142,8 +147,8 @@ x86.Instruction.prototype.compEncLen = function (enc, x86_64)
     {
         var opnd = this.opnds[i];
 
-        var opndType = x86.opndType(enc.opnds[i]);
-        var opndSize = x86.opndSize(enc.opnds[i]);
+        var opndType = enc.opndTypes[i];
+        var opndSize = enc.opndSizes[i];
 
         if (opnd.rexNeeded)
             rexNeeded = true;
@@ -182,20 +187,14 @@ x86.Instruction.prototype.compEncLen = function (enc, x86_64)
          (rmOpnd.index && rmOpnd.index.size === 32)))
         size += 1;
 
-    // Add the operand-size prefix, if needed
-    if (enc.szPref === true)
-        size += 1;
-
-    // Add the prefix size
-    size += enc.prefix.length;
+    // Add the size of the operand-size prefix, mandatory prefixes
+    // and opcode
+    size += enc.baseLen;
 
     // Add the REX prefix, if needed
     if (rexNeeded === true)
         size += 1;
 
-    // Add the opcode size
-    size += enc.opCode.length;
-
     // Add the ModR/M byte, if needed
     if (rmNeeded)
         size += 1;
@@ -224,22 +223,26 @@ x86.Instruction.prototype.findEncoding = function (x86_64)
     var bestEnc = null;
     var bestLen = 0xFFFF;
 
+    // Get the encodings matching the kinds of the operands
+    var sig = '';
+    for (var i = 0; i < this.opnds.length; ++i)
+        sig += x86.opndKind(this.opnds[i]) + ',';
+    var encodings = this.encIndex[sig];
+    if (encodings === undefined)
+        encodings = [];
+
     // For each possible encoding
     ENC_LOOP:
-    for (var i = 0; i < this.encodings.length; ++i)
+    for (var i = 0; i < encodings.length; ++i)
     {
         //print('encoding #' + (i+1));
 
-        var enc = this.encodings[i];
+        var enc = encodings[i];
 
         // If we are in x86-64 and this encoding is not valid in that mode
         if (x86_64 === true && enc.x86_64 === false)
             continue ENC_LOOP;
 
-        // If the number of operands does not match, skip this encoding
-        if (enc.opnds.length !== this.opnds.length)
-            continue ENC_LOOP;
-
         // For each operand
         for (var j = 0; j < this.opnds.length; ++j)
         {
@@ -247,8 +250,8 @@ x86.Instruction.prototype.findEncoding = function (x86_64)
 
             var encOpnd = enc.opnds[j];
 
-            var opndType = x86.opndType(encOpnd);
-            var opndSize = x86.opndSize(encOpnd);
+            var opndType = enc.opndTypes[j];
+            var opndSize = enc.opndSizes[j];
 
             /*
             print('opnd: ' + opnd);
@@ -327,7 +330,8 @@ x86.Instruction.prototype.findEncoding = function (x86_64)
                 break;
 
                 case 'rel':
-                if (!(opnd instanceof x86.LabelRef))
+                if (!(opnd instanceof x86.LabelRef) &&
+                    !(opnd instanceof x86.LinkRef))
                     continue ENC_LOOP;
                 if (opnd.size > opndSize)
                     continue ENC_LOOP;
@@ -417,8 +421,8 @@ x86.Instruction.prototype.encode = function (codeBlock, x86_64)
     {
         var opnd = this.opnds[i];
 
-        var opndType = x86.opndType(enc.opnds[i]);
-        var opndSize = x86.opndSize(enc.opnds[i]);
+        var opndType = enc.opndTypes[i];
+        var opndSize = enc.opndSizes[i];
 
         if (opnd.rexNeeded === true)
             rexNeeded = true;
@@ -650,6 +654,8 @@ x86.Instruction.prototype.encode = function (codeBlock, x86_64)
             immOpnd.writeImm(codeBlock, immSize);
         else if (immOpnd instanceof x86.LabelRef)
             codeBlock.writeInt(immOpnd.relOffset, immSize);
+        else if (immOpnd instanceof x86.LinkRef)
+            codeBlock.writeLink(immOpnd.value, immSize, immOpnd.entry);
         else
             error('invalid immediate operand');
     }
@@ -960,6 +966,66 @@ x86.opndType = function (opnd)
     }
 };
 
+/**
+Get the kind of an instruction operand, used to index the encodings.
+Immediates of any size and type share the same kind.
+*/
+x86.opndKind = function (opnd)
+{
+    if (opnd instanceof x86.Register)
+        return (opnd.type === 'xmm')? 'x':(opnd.type + opnd.size);
+
+    if (opnd instanceof x86.MemLoc)
+        return 'm' + opnd.size;
+
+    if (opnd instanceof x86.Immediate)
+        return 'i';
+
+    if (opnd instanceof x86.LabelRef || opnd instanceof x86.LinkRef)
+        return 'l';
+
+    error('invalid operand: ' + opnd);
+};
+
+/**
+Get the kinds of instruction operands an encoding operand accepts
+*/
+x86.encOpndKinds = function (encOpnd)
+{
+    var size = x86.opndSize(encOpnd);
+
+    switch (x86.opndType(encOpnd))
+    {
+        case 'fixed_reg':
+        return [x86.opndKind(encOpnd)];
+
+        case 'r':
+        return ['gp' + size];
+
+        case 'xmm':
+        return ['x'];
+
+        case 'm':
+        if (size === undefined)
+            return ['m8', 'm16', 'm32', 'm64', 'm128'];
+        return ['m' + size];
+
+        case 'r/m':
+        return ['gp' + size, 'm' + size];
+
+        case 'xmm/m':
+        return ['x', 'm' + size];
+
+        case 'cst':
+        case 'imm':
+        case 'moffs':
+        return ['i'];
+
+        case 'rel':
+        return ['l'];
+    }
+};
+
 /**
 Anonymous function to create instruction classes from the instruction table.
 */
@@ -1051,6 +1117,18 @@ Anonymous function to create instruction classes from the instruction table.
         if (enc.szPref === undefined)
             enc.szPref = false;
 
+        // Precompute the operand types and sizes
+        enc.opndTypes = [];
+        enc.opndSizes = [];
+        for (var j = 0; j < enc.opnds.length; ++j)
+        {
+            enc.opndTypes.push(x86.opndType(enc.opnds[j]));
+            enc.opndSizes.push(x86.opndSize(enc.opnds[j]));
+        }
+
+        // Length of the operand-size prefix, mandatory prefixes and opcode
+        enc.baseLen = (enc.szPref? 1:0) + enc.prefix.length + enc.opCode.length;
+
         assert (
             enc.szPref === true || enc.szPref === false,
             'invalid operand-size prefix flag for ' + mnem
@@ -1142,6 +1220,43 @@ Anonymous function to create instruction classes from the instruction table.
 
     //print('supported instructions: ' + numInstrs);
 
+    // Function to index encodings by operand kind signature. The
+    // encodings of each signature are kept in table order.
+    function makeEncIndex(encodings)
+    {
+        var index = {};
+
+        for (var i = 0; i < encodings.length; ++i)
+        {
+            var enc = encodings[i];
+
+            // Signatures of the operand kinds accepted so far
+            var sigs = [''];
+
+            for (var j = 0; j < enc.opnds.length; ++j)
+            {
+                var kinds = x86.encOpndKinds(enc.opnds[j]);
+
+                var newSigs = [];
+                for (var k = 0; k < sigs.length; ++k)
+                    for (var l = 0; l < kinds.length; ++l)
+                        newSigs.push(sigs[k] + kinds[l] + ',');
+
+                sigs = newSigs;
+            }
+
+            for (var k = 0; k < sigs.length; ++k)
+            {
+                if (index[sigs[k]] === undefined)
+                    index[sigs[k]] = [];
+
+                index[sigs[k]].push(enc);
+            }
+        }
+
+        return index;
+    }
+
     // Function to create an instruction class
     function makeInstr(mnem, encodings)
     {
@@ -1226,6 +1341,9 @@ Anonymous function to create instruction classes from the instruction table.
         // Store the possible encodings for the instruction
         InstrCtor.prototype.encodings = encodings;
 
+        // Index the encodings by the kinds of operands they accept
+        InstrCtor.prototype.encIndex = makeEncIndex(encodings);
+
         // Store the constructor on the x86.instrs object
         x86.instrs[mnem] = InstrCtor;
     }
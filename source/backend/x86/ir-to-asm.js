@@ -113,6 +113,23 @@ GetBasePtrInstr.prototype.x86.genCode = function (instr, opnds, dest, scratch, a
     asm.add(dest, frameSize);
 }
 
+// Stack unwinding instruction
+// Note: the operands must be in registers since the stack pointer is
+// overwritten before the jump
+UnwindInstr.prototype.x86 = new x86.InstrCfg();
+UnwindInstr.prototype.x86.opndMustBeReg = function (instr, idx, params)
+{
+    return true;
+}
+UnwindInstr.prototype.x86.genCode = function (instr, opnds, dest, scratch, asm, genInfo)
+{
+    // Restore the stack pointer of the frame with the landing pad
+    asm.mov(genInfo.backend.spReg, opnds[0]);
+
+    // Jump to the landing pad
+    asm.jmp(opnds[1]);
+}
+
 // Base instruction configuration for arithmetic instructions
 ArithInstr.prototype.x86 = new x86.InstrCfg();
 ArithInstr.prototype.x86.opndCanBeImm = function (instr, idx, size)
@@ -265,6 +282,26 @@ ModInstr.prototype.x86.excludeRegs = function (instr, params)
     return undefined;
 }
 
+// Integer square root instruction
+ISqrtInstr.prototype.x86 = new x86.InstrCfg();
+ISqrtInstr.prototype.x86.destIsOpnd0 = function (instr)
+{
+    return false;
+}
+ISqrtInstr.prototype.x86.destMustBeReg = function (instr, params)
+{
+    return true;
+}
+ISqrtInstr.prototype.x86.genCode = function (instr, opnds, dest, scratch, asm, genInfo)
+{
+    // The XMM registers are not allocated, use xmm0 as a scratch register
+    const xmm0 = x86.regs.xmm0;
+
+    asm.cvtsi2sd(xmm0, opnds[0]);
+    asm.sqrtsd(xmm0, xmm0);
+    asm.cvttsd2si(dest, xmm0);
+};
+
 /**
 Generate a bitwise instruction's code generation
 */
@@ -410,12 +447,37 @@ CallFuncInstr.prototype.x86.maxMemOpnds = function (instr, idx, size)
 }
 CallFuncInstr.prototype.x86.opndCanBeImm = function (instr, idx, size) 
 { 
-    // The function pointer shouldn't be received as an immediate
+    // The function pointer shouldn't be received as an immediate,
+    // unless the callee is known and can be called directly
     if (idx === 0)
-        return false;
+        return (this.getDirectEntry(instr) !== null);
 
     return true; 
 }
+/**
+Get the name of the entry point label through which a statically known
+callee can be called directly, or null if the callee must be called
+through a function pointer. Calls passing exactly the expected number of
+arguments enter past the argument count check.
+*/
+CallFuncInstr.prototype.x86.getDirectEntry = function (instr)
+{
+    var callee = instr.uses[0];
+
+    if (this.calleeConv !== 'tachyon' ||
+        (callee instanceof IRFunction) === false ||
+        callee.cProxy === true)
+        return null;
+
+    // Number of arguments, without the hidden ones
+    var numActualArgs = instr.uses.length - 3;
+
+    if (callee.usesArguments === false &&
+        numActualArgs === callee.getNumArgs())
+        return 'ENTRY_FAST';
+
+    return 'ENTRY_DEFAULT';
+}
 CallFuncInstr.prototype.x86.opndMustBeReg = function (instr, idx, params)
 {
     // Get the calling convention for the callee
@@ -480,6 +542,10 @@ CallFuncInstr.prototype.x86.numScratchRegs = function (instr, params)
     if (dynAlign === true)
         return 2;
 
+    // Tail calls need an extra scratch register for the function pointer
+    if (instr.tailCall === true)
+        return 2;
+
     // Need 1 scratch register
     return 1;
 }
@@ -534,6 +600,13 @@ CallFuncInstr.prototype.x86.genCode = function (instr, opnds, dest, scratch, asm
     // Compute the number of stack arguments
     var numStackArgs = Math.max(numArgs - numRegArgs, 0);
 
+    // If this is a tail call, reuse the current stack frame
+    if (instr.tailCall === true)
+    {
+        this.genTailCall(instr, opnds, scratch, asm, genInfo);
+        return;
+    }
+
     // Determine if the stack pointer needs to be dynamically aligned
     var dynAlign = (callerConv !== calleeConv && callerConv.spAlign < calleeConv.spAlign);
 
@@ -713,12 +786,37 @@ CallFuncInstr.prototype.x86.genCode = function (instr, opnds, dest, scratch, asm
         );
     }
 
+    // If the callee is known, call its entry point directly
+    if (funcPtr instanceof x86.LinkValue)
+        funcPtr = new x86.LinkRef(funcPtr.value, this.getDirectEntry(instr));
+
     // Call the function with the given address
     asm.call(funcPtr);
 
     // If we are calling a tachyon function
     if (this.calleeConv === 'tachyon')
     {
+        var throwTarget = instr.getThrowTarget();
+
+        // If the call has a throw target, generate an exception landing
+        // pad which restores the stack as the normal return path does
+        // and jumps to the throw target
+        var genLandingPad = undefined;
+        if (throwTarget !== null)
+        {
+            genLandingPad = function (asm)
+            {
+                if (dynAlign === true)
+                    asm.mov(spReg, spLoc);
+                else if (padSpace !== undefined)
+                    asm.add(spReg, padSpace);
+
+                asm.jmp(genInfo.edgeLabels.get(
+                    {pred: instr.parentBlock, succ: throwTarget}
+                ));
+            };
+        }
+
         // Encode stack frame info here
         x86.writeStackInfo(
             instr.parentBlock.parentCFG.ownerFunc,
@@ -728,7 +826,8 @@ CallFuncInstr.prototype.x86.genCode = function (instr, opnds, dest, scratch, asm
             dynAlign,
             false,
             padSpace,
-            backend
+            backend,
+            genLandingPad
         );
     }
 
@@ -776,6 +875,122 @@ CallFuncInstr.prototype.x86.genCode = function (instr, opnds, dest, scratch, asm
     }
 };
 
+CallFuncInstr.prototype.x86.genTailCall = function (instr, opnds, scratch, asm, genInfo)
+{
+    // Get a reference to the backend
+    const backend = genInfo.backend;
+
+    // Get the calling convention for the callee
+    var calleeConv = backend.getCallConv(this.calleeConv);
+
+    // Get the allocation map
+    var allocMap = genInfo.allocMap;
+
+    // Get the stack pointer register
+    var spReg = backend.spReg;
+
+    // Get the temporary register
+    var tmpReg = scratch[0];
+
+    // Get the function pointer
+    var funcPtr = opnds[0];
+
+    // Compute the number of arguments, with and without the hidden ones
+    var numArgs = opnds.length - 1;
+    var numActualArgs = numArgs - 2;
+
+    // Compute the number of register and stack arguments
+    var numRegArgs = Math.min(numArgs, calleeConv.argRegs.length);
+    var numStackArgs = Math.max(numArgs - numRegArgs, 0);
+
+    assert (
+        numStackArgs === allocMap.numArgSlots,
+        'tail call stack argument count does not match the frame'
+    );
+
+    // Size of the spill slots and of the stack arguments
+    var spillSpace = allocMap.slotSize * allocMap.numSpillSlots;
+    var argSpace = allocMap.slotSize * numStackArgs;
+
+    // If the callee is known, jump to its entry point directly
+    if (funcPtr instanceof x86.LinkValue)
+    {
+        funcPtr = new x86.LinkRef(funcPtr.value, this.getDirectEntry(instr));
+    }
+
+    // Load the function pointer in a register before the stack
+    // argument slots are overwritten
+    else if ((funcPtr instanceof x86.Register) === false)
+    {
+        if (typeof funcPtr === 'number')
+            funcPtr = allocMap.getSlotOpnd(funcPtr);
+
+        asm.mov(scratch[1], funcPtr);
+        funcPtr = scratch[1];
+    }
+
+    // Push the stack arguments, since their values may come from the
+    // argument slots they will overwrite
+    for (var i = 0; i < numStackArgs; ++i)
+    {
+        var srcOpnd = opnds[1 + numRegArgs + i];
+
+        if (typeof srcOpnd === 'number')
+        {
+            srcOpnd = allocMap.getSlotOpnd(
+                srcOpnd,
+                undefined,
+                spReg,
+                i * allocMap.slotSize
+            );
+
+            asm.mov(tmpReg, srcOpnd);
+        }
+        else if (srcOpnd instanceof x86.LinkValue)
+        {
+            asm.mov(tmpReg, srcOpnd);
+        }
+        else
+        {
+            x86.moveValue(allocMap, tmpReg, srcOpnd, asm, genInfo.params);
+        }
+
+        asm.push(tmpReg);
+    }
+
+    // Copy the stack arguments into the incoming argument slots, in
+    // the layout a call instruction would produce
+    for (var i = 0; i < numStackArgs; ++i)
+    {
+        var slotDisp = (numStackArgs - i - 1) * allocMap.slotSize;
+
+        asm.mov(
+            tmpReg,
+            new x86.MemLoc(allocMap.slotSize * 8, spReg, slotDisp)
+        );
+
+        asm.mov(
+            new x86.MemLoc(
+                allocMap.slotSize * 8,
+                spReg,
+                argSpace + spillSpace + allocMap.slotSize + slotDisp
+            ),
+            tmpReg
+        );
+    }
+
+    // Remove the pushed arguments and the spills from the stack
+    if (argSpace + spillSpace !== 0)
+        asm.add(spReg, argSpace + spillSpace);
+
+    // Set the argument count register
+    if (calleeConv.argCountReg !== null)
+        asm.mov(calleeConv.argCountReg, numActualArgs);
+
+    // Jump to the callee, which returns to our caller
+    asm.jmp(funcPtr);
+};
+
 // FFI call instruction, reuses the regular call logic
 CallFFIInstr.prototype.x86 = Object.create(CallFuncInstr.prototype.x86);
 CallFFIInstr.prototype.x86.calleeConv = 'c';
@@ -1129,6 +1344,23 @@ CallApplyInstr.prototype.x86.genCode = function (instr, opnds, dest, scratch, as
     // If we are calling a tachyon function
     if (this.calleeConv === 'tachyon')
     {
+        var throwTarget = instr.getThrowTarget();
+
+        // If the call has a throw target, generate an exception landing
+        // pad which restores the old stack pointer and jumps to it
+        var genLandingPad = undefined;
+        if (throwTarget !== null)
+        {
+            genLandingPad = function (asm)
+            {
+                asm.mov(spReg, asm.mem(spReg.size, spReg, 0));
+
+                asm.jmp(genInfo.edgeLabels.get(
+                    {pred: instr.parentBlock, succ: throwTarget}
+                ));
+            };
+        }
+
         // Encode stack frame info here
         x86.writeStackInfo(
             instr.parentBlock.parentCFG.ownerFunc,
@@ -1138,7 +1370,8 @@ CallApplyInstr.prototype.x86.genCode = function (instr, opnds, dest, scratch, as
             true,
             false,
             0,
-            backend
+            backend,
+            genLandingPad
         );
     }
 
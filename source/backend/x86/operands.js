@@ -408,11 +408,6 @@ x86.Immediate = function (value)
         'immediate must be number'
     );
 
-    assert (
-        num_ge(value, getIntMin(64)) && num_le(value, getIntMax(64, true)),
-        'immediate does not fit within 64 bits: ' + num_to_string(value)
-    );
-
     /**
     @field Field value
     */
@@ -424,6 +419,33 @@ x86.Immediate = function (value)
     */
     this.type = 'imm';
 
+    // Small JS integers are sized without bignum arithmetic
+    if (typeof value === 'number' && value > -0x80000000 && value < 0x80000000)
+    {
+        if (value >= -128 && value <= 127)
+            this.size = 8;
+        else if (value >= -32768 && value <= 32767)
+            this.size = 16;
+        else
+            this.size = 32;
+
+        if (value < 0)
+            this.unsgSize = undefined;
+        else if (value <= 0xFF)
+            this.unsgSize = 8;
+        else if (value <= 0xFFFF)
+            this.unsgSize = 16;
+        else
+            this.unsgSize = 32;
+
+        return;
+    }
+
+    assert (
+        num_ge(value, getIntMin(64)) && num_le(value, getIntMax(64, true)),
+        'immediate does not fit within 64 bits: ' + num_to_string(value)
+    );
+
     // Compute the smallest size this immediate fits in
     if (num_ge(value, getIntMin(8)) && num_le(value, getIntMax(8)))
         this.size = 8;
@@ -521,6 +543,43 @@ x86.LinkValue.prototype.writeImm = function (codeBlock, immSize)
     codeBlock.writeLink(this.value, immSize);
 }
 
+/**
+@class Link-time relative reference to an entry point of a function,
+used as the target of direct calls and jumps
+@extends x86.Operand
+*/
+x86.LinkRef = function (func, entry)
+{
+    assert (
+        func instanceof IRFunction,
+        'invalid linked function'
+    );
+
+    /**
+    @field Function referenced
+    */
+    this.value = func;
+
+    /**
+    @field Name of the exported entry point label
+    */
+    this.entry = entry;
+
+    /**
+    @field The offset is always encoded on 32 bits
+    */
+    this.size = 32;
+}
+x86.LinkRef.prototype = new x86.Operand();
+
+/**
+Produce a string representation of the link reference
+*/
+x86.LinkRef.prototype.toString = function ()
+{
+    return capStrLen(this.value.getValName(), 16, true) + ' (' + this.entry + ')';
+}
+
 /**
 @class Label reference operand
 @extends x86.Operand
@@ -42,7 +42,10 @@
 
 /**
 @fileOverview
-x86 peephole optimizer implementation.
+x86 peephole optimizer implementation. The optimizer is driven by a
+table of rules, each of which matches on the mnemonic of an instruction
+and may rewrite that instruction and its neighbors. Every rule keeps a
+count of the number of times it was applied.
 
 @author
 Maxime Chevalier-Boisvert
@@ -53,125 +56,709 @@ x86 namespace
 */
 var x86 = x86 || {};
 
-/*
-TODO: peephole optimizer
+/**
+Table of conditional jump instructions and their logical inverses
+*/
+x86.jumpInvs = {
+    'ja': 'jbe',
+    'jae': 'jb',
+    'jb': 'jae',
+    'jbe': 'ja',
+    'jc': 'jnc',
+    'je': 'jne',
+    'jg': 'jle',
+    'jge': 'jl',
+    'jl': 'jge',
+    'jle': 'jg',
+    'jna': 'ja',
+    'jnae': 'jae',
+    'jnb': 'jb',
+    'jnbe': 'jbe',
+    'jnc': 'jc',
+    'jne': 'je',
+    'jng': 'jg',
+    'jnge': 'jge',
+    'jnl': 'jl',
+    'jnle': 'jle',
+    'jno': 'jo',
+    'jnp': 'jp',
+    'jns': 'js',
+    'jnz': 'jz',
+    'jo': 'jno',
+    'jp': 'jnp',
+    'jpe': 'jpo',
+    'jpo': 'jpe',
+    'js': 'jns',
+    'jz': 'jnz'
+};
 
-neg
+/**
+Instructions which write all the status flags without reading them
+*/
+x86.flagWriters = ['add', 'sub', 'and', 'or', 'xor', 'cmp', 'test', 'neg'];
 
-lea opts for mul
-  r0 := r1*{0,1} + r2*{0,1,2,4,8}
+/**
+Conditional jumps which only depend on the zero and sign flags
+*/
+x86.zsJumps = ['je', 'jne', 'jz', 'jnz', 'js', 'jns'];
 
-lea for 3-register addition
-  lea eax, [ebx+ecx]
+/**
+Maximum number of instructions to scan when computing flag liveness
+*/
+x86.FLAG_SCAN_LIMIT = 16;
 
-move sequence reduction
-- see phi block merges
-- much performance to gain here
+/**
+Test if an instruction is an unconditional jump to a label
+*/
+x86.isDirectJump = function (instr)
+{
+    return (
+        instr instanceof x86.instrs.jmp &&
+        instr.opnds[0] instanceof x86.LabelRef
+    );
+}
 
-mov l1, l0
-mov l2, l1
-... <- instructions not reading l1
-mov l1, l4
+/**
+Test if an instruction is a conditional jump
+*/
+x86.isCondJump = function (instr)
+{
+    return instr !== null && instr.mnem in x86.jumpInvs;
+}
 
-Maybe
------
+/**
+Test if an instruction reads the status flags
+*/
+x86.readsFlags = function (instr)
+{
+    var mnem = instr.mnem;
 
-inc/dec
-- smaller, but may not be faster!
+    return (
+        x86.isCondJump(instr) === true ||
+        mnem.indexOf('cmov') === 0 ||
+        mnem.indexOf('pushf') === 0
+    );
+}
 
-movcc, move on condition
-- may not actually be faster! to be benchmarked
+/**
+Test if the status flags may be read after an instruction executes.
+This is conservative: labels, jumps and data blocks end the scan and
+are assumed to read the flags. Calls and returns do not preserve them.
+*/
+x86.flagsLiveAfter = function (instr)
+{
+    var n = 0;
 
-xadd, exchange and add
+    for (var cur = instr.next; cur !== null; cur = cur.next)
+    {
+        if (cur instanceof x86.Label ||
+            cur instanceof x86.DataBlock ||
+            cur instanceof x86.instrs.jmp ||
+            ++n > x86.FLAG_SCAN_LIMIT)
+            return true;
+
+        if (x86.readsFlags(cur) === true)
+            return true;
+
+        if (cur instanceof x86.instrs.call ||
+            cur instanceof x86.instrs.ret ||
+            arraySetHas(x86.flagWriters, cur.mnem) === true)
+            return false;
+    }
 
-cmpxchg weirdness
-*/
+    return false;
+}
 
 /**
-Optimize a sequence of x86 instructions using peephole patterns
+Test if two registers may overlap
 */
-x86.optimize = function (asm, maxPasses)
+x86.regsAlias = function (r1, r2)
 {
-    // Get a reference to the instructions namespace
-    const instrs = x86.instrs;
+    if (r1.type !== r2.type)
+        return false;
 
-    // Get the x86_64 flag
-    const x86_64 = asm.x86_64;
+    // The 8-bit high registers (ah, ch, dh, bh) alias the low registers
+    if (r1.size === 8 || r2.size === 8)
+        return (r1.regNo % 4) === (r2.regNo % 4);
 
-    /**
-    Remove an instruction
-    */
-    function remInstr(instr)
+    return r1.regNo === r2.regNo;
+}
+
+/**
+Test if an operand reads a given register
+*/
+x86.opndUsesReg = function (opnd, reg)
+{
+    if (opnd instanceof x86.Register)
+        return x86.regsAlias(opnd, reg);
+
+    if (opnd instanceof x86.MemLoc)
     {
-        assert (
-            (instr instanceof x86.DataBlock) === false,
-            'removing data block'
+        return (
+            (opnd.base !== undefined && x86.regsAlias(opnd.base, reg)) ||
+            (opnd.index !== undefined && x86.regsAlias(opnd.index, reg))
         );
-
-        asm.remInstr(instr);
-        changed = true;
     }
 
-    /**
-    Add an instruction after another one
-    */
-    function addAfter(newInstr, prev)
+    return false;
+}
+
+/**
+Test if two operands denote the same location or value
+*/
+x86.sameOpnd = function (o1, o2)
+{
+    if (o1 === o2)
+        return true;
+
+    if (o1 instanceof x86.MemLoc && o2 instanceof x86.MemLoc)
     {
-        asm.addInstrAfter(newInstr, prev);
-        changed = true;
+        return (
+            o1.size === o2.size &&
+            o1.base === o2.base &&
+            o1.index === o2.index &&
+            o1.scale === o2.scale &&
+            num_eq(o1.disp, o2.disp)
+        );
     }
 
-    /**
-    Replace an instruction
-    */
-    function replInstr(oldInstr, newInstr)
+    if (o1 instanceof x86.Immediate && o2 instanceof x86.Immediate)
+        return num_eq(o1.value, o2.value);
+
+    return false;
+}
+
+/**
+Test if an operand is an immediate with a given value
+*/
+x86.isImmVal = function (opnd, val)
+{
+    return opnd instanceof x86.Immediate && num_eq(opnd.value, val);
+}
+
+/**
+Table of peephole optimization rules. Each rule applies to instructions
+with the listed mnemonics (or to labels, with the 'label' key). The
+apply function receives the instruction and the optimizer context, and
+returns true if it modified the code. Rules are tried in order, and the
+first one to apply ends the processing of the instruction.
+*/
+x86.peepholeRules = [
+
+    // Jump to the next instruction
     {
-        asm.replInstr(oldInstr, newInstr);
-        changed = true;
-    }
+        name: 'jumpToNext',
+        mnems: ['jmp', 'jcc'],
+        apply: function (instr, opt)
+        {
+            if (instr.opnds[0].label !== instr.next)
+                return false;
 
-    // TODO: complete this table
-    // Table of conditional jump instructions and their logical inverses
-    const jumpInvs = {
-        'je': 'jne',
-        'jg': 'jle',
-        'jge': 'jl',
-        'jl': 'jge',
-        'jle': 'jg',
-        'jne': 'je'
-    }
+            opt.remInstr(instr);
+            return true;
+        }
+    },
+
+    // Conditional jump over an unconditional jump:
+    // jcc labelT
+    // jmp labelF
+    // labelT:
+    //
+    // is replaced by:
+    // jnc labelF
+    // labelT:
+    {
+        name: 'invertCondJump',
+        mnems: ['jcc'],
+        apply: function (instr, opt)
+        {
+            var next = instr.next;
+
+            if (x86.isDirectJump(next) === false ||
+                instr.opnds[0].label !== next.next)
+                return false;
+
+            var invJmpCtor = x86.instrs[x86.jumpInvs[instr.mnem]];
+            var labelF = next.opnds[0].label;
+            var newJmp = new invJmpCtor([new x86.LabelRef(labelF)], opt.x86_64);
 
-    /**
-    Test if an instruction is an unconditional jump
-    */
-    function isDirectJump(instr)
+            opt.remInstr(next);
+            opt.replInstr(instr, newJmp);
+            return true;
+        }
+    },
+
+    // Jump to a jump, possibly through a chain of labels
     {
-        return instr instanceof instrs.jmp;
-    }
+        name: 'jumpThreading',
+        mnems: ['jmp', 'jcc'],
+        apply: function (instr, opt)
+        {
+            if (x86.isCondJump(instr) === false &&
+                x86.isDirectJump(instr) === false)
+                return false;
+
+            var label = instr.opnds[0].label;
+
+            var target = label.next;
+            while (target instanceof x86.Label)
+                target = target.next;
+
+            if (x86.isDirectJump(target) === false)
+                return false;
+
+            var j2Label = target.opnds[0].label;
+
+            // Avoid threading a jump to itself
+            if (j2Label === label || target === instr)
+                return false;
+
+            var ctor = x86.instrs[instr.mnem];
+            var newJmp = new ctor([new x86.LabelRef(j2Label)], opt.x86_64);
+            opt.replInstr(instr, newJmp);
+            return true;
+        }
+    },
+
+    // Unreachable instruction after an unconditional jump
+    {
+        name: 'deadAfterJump',
+        mnems: ['jmp'],
+        apply: function (instr, opt)
+        {
+            var next = instr.next;
+
+            if (next === null ||
+                next instanceof x86.Label ||
+                next instanceof x86.DataBlock)
+                return false;
+
+            opt.remInstr(next);
+            return true;
+        }
+    },
+
+    // Unreferenced label
+    {
+        name: 'deadLabel',
+        mnems: ['label'],
+        apply: function (instr, opt)
+        {
+            if (instr.refCount !== 0 || instr.exported === true)
+                return false;
+
+            opt.remInstr(instr);
+            return true;
+        }
+    },
+
+    // Move of a location into itself
+    {
+        name: 'movSelf',
+        mnems: ['mov'],
+        apply: function (instr, opt)
+        {
+            if (instr.opnds[0] !== instr.opnds[1])
+                return false;
+
+            opt.remInstr(instr);
+            return true;
+        }
+    },
+
+    // Move back into the source of a move, such as a spill followed
+    // by a reload of the same value:
+    // mov a, b
+    // mov b, a
+    {
+        name: 'movBack',
+        mnems: ['mov'],
+        apply: function (instr, opt)
+        {
+            var next = instr.next;
+
+            if (!(next instanceof x86.instrs.mov) ||
+                x86.sameOpnd(instr.opnds[0], next.opnds[1]) === false ||
+                x86.sameOpnd(instr.opnds[1], next.opnds[0]) === false)
+                return false;
+
+            // The destination must not be used in the address of the source
+            if (instr.opnds[0] instanceof x86.Register &&
+                x86.opndUsesReg(instr.opnds[1], instr.opnds[0]) === true)
+                return false;
+
+            // In 64-bit mode, 32-bit moves clear the upper register bits
+            if (opt.x86_64 === true &&
+                next.opnds[0] instanceof x86.Register &&
+                next.opnds[0].size === 32)
+                return false;
+
+            opt.remInstr(next);
+            return true;
+        }
+    },
+
+    // Move overwritten by the next instruction:
+    // mov a, b
+    // mov a, c
+    {
+        name: 'movOverwrite',
+        mnems: ['mov'],
+        apply: function (instr, opt)
+        {
+            var next = instr.next;
+            var dst = instr.opnds[0];
+
+            if (!(next instanceof x86.instrs.mov) ||
+                x86.sameOpnd(dst, next.opnds[0]) === false)
+                return false;
+
+            // The second move must not read the first destination
+            if (dst instanceof x86.Register &&
+                x86.opndUsesReg(next.opnds[1], dst) === true)
+                return false;
+            if (dst instanceof x86.MemLoc &&
+                next.opnds[1] instanceof x86.MemLoc)
+                return false;
+
+            opt.remInstr(instr);
+            return true;
+        }
+    },
+
+    // Second load from the same memory location:
+    // mov r1, m
+    // mov r2, m
+    //
+    // is replaced by:
+    // mov r1, m
+    // mov r2, r1
+    {
+        name: 'loadForward',
+        mnems: ['mov'],
+        apply: function (instr, opt)
+        {
+            var next = instr.next;
+            var r1 = instr.opnds[0];
+            var mem = instr.opnds[1];
+
+            if (!(next instanceof x86.instrs.mov) ||
+                !(r1 instanceof x86.Register) ||
+                !(mem instanceof x86.MemLoc) ||
+                !(next.opnds[0] instanceof x86.Register) ||
+                r1.type !== 'gp' ||
+                x86.sameOpnd(mem, next.opnds[1]) === false ||
+                x86.opndUsesReg(mem, r1) === true)
+                return false;
+
+            var newMov = new x86.instrs.mov([next.opnds[0], r1], opt.x86_64);
+            opt.replInstr(next, newMov);
+            return true;
+        }
+    },
+
+    // Move of 0 into a 32 or 64 bit register, replaced by xor r, r
+    {
+        name: 'movZeroXor',
+        mnems: ['mov'],
+        apply: function (instr, opt)
+        {
+            var reg = instr.opnds[0];
+
+            if (!(reg instanceof x86.Register) ||
+                reg.type !== 'gp' ||
+                reg.size < 32 ||
+                x86.isImmVal(instr.opnds[1], 0) === false ||
+                x86.flagsLiveAfter(instr) === true)
+                return false;
+
+            var newInstr = new x86.instrs.xor([reg, reg], opt.x86_64);
+            opt.replInstr(instr, newInstr);
+            return true;
+        }
+    },
+
+    // Move followed by an addition, replaced by a three-operand lea:
+    // mov r1, r2
+    // add r1, imm/r3
+    //
+    // is replaced by:
+    // lea r1, [r2 + imm/r3]
+    {
+        name: 'addMovLea',
+        mnems: ['mov'],
+        apply: function (instr, opt)
+        {
+            var next = instr.next;
+            var r1 = instr.opnds[0];
+            var r2 = instr.opnds[1];
+
+            // lea is only used with address-sized registers
+            var addrSize = opt.x86_64? 64:32;
+
+            if (!(next instanceof x86.instrs.add ||
+                  next instanceof x86.instrs.sub) ||
+                !(r1 instanceof x86.Register) ||
+                !(r2 instanceof x86.Register) ||
+                r1.type !== 'gp' || r2.type !== 'gp' ||
+                r1.size !== addrSize || r2.size !== addrSize ||
+                r1 === r2 ||
+                next.opnds[0] !== r1)
+                return false;
+
+            var src = next.opnds[1];
+            var memLoc;
+
+            if (src instanceof x86.Immediate && src.size <= 32)
+            {
+                var disp = (next instanceof x86.instrs.sub)?
+                    num_neg(src.value):src.value;
+
+                if (num_lt(disp, getIntMin(32)) || num_gt(disp, getIntMax(32)))
+                    return false;
+
+                memLoc = new x86.MemLoc(8, r2, disp);
+            }
+            else if (src instanceof x86.Register &&
+                     next instanceof x86.instrs.add &&
+                     src.type === 'gp' &&
+                     src.size === addrSize &&
+                     x86.regsAlias(src, r1) === false)
+            {
+                // The stack pointer cannot be used as an index register
+                if (src.regNo !== 4)
+                    memLoc = new x86.MemLoc(8, r2, 0, src);
+                else if (r2.regNo !== 4)
+                    memLoc = new x86.MemLoc(8, src, 0, r2);
+                else
+                    return false;
+            }
+            else
+            {
+                return false;
+            }
+
+            // lea does not set the flags
+            if (x86.flagsLiveAfter(next) === true)
+                return false;
+
+            var lea = new x86.instrs.lea([r1, memLoc], opt.x86_64);
+            opt.remInstr(next);
+            opt.replInstr(instr, lea);
+            return true;
+        }
+    },
+
+    // Addition or subtraction of 0 whose flags are unused
+    {
+        name: 'addZero',
+        mnems: ['add', 'sub'],
+        apply: function (instr, opt)
+        {
+            if (instr.opnds.length !== 2 ||
+                x86.isImmVal(instr.opnds[1], 0) === false ||
+                x86.flagsLiveAfter(instr) === true)
+                return false;
+
+            opt.remInstr(instr);
+            return true;
+        }
+    },
 
-    /**
-    Test if an instruction is a conditional jump
-    */
-    function isCondJump(instr)
+    // Test of a register which was just the destination of a logical
+    // operation, which already sets the flags identically:
+    // and r, x
+    // test r, r
     {
-        return instr.mnem in jumpInvs;
+        name: 'testAfterLogic',
+        mnems: ['and', 'or', 'xor'],
+        apply: function (instr, opt)
+        {
+            var next = instr.next;
+            var reg = instr.opnds[0];
+
+            if (!(next instanceof x86.instrs.test) ||
+                !(reg instanceof x86.Register) ||
+                next.opnds[0] !== reg ||
+                next.opnds[1] !== reg)
+                return false;
+
+            opt.remInstr(next);
+            return true;
+        }
+    },
+
+    // Test of a register which was just the destination of an addition
+    // or subtraction, when only the zero and sign flags are used:
+    // add r, x
+    // test r, r
+    // je label
+    {
+        name: 'testAfterArith',
+        mnems: ['add', 'sub'],
+        apply: function (instr, opt)
+        {
+            var next = instr.next;
+            var reg = instr.opnds[0];
+
+            if (!(next instanceof x86.instrs.test) ||
+                !(reg instanceof x86.Register) ||
+                next.opnds[0] !== reg ||
+                next.opnds[1] !== reg ||
+                next.next === null ||
+                arraySetHas(x86.zsJumps, next.next.mnem) === false ||
+                x86.flagsLiveAfter(next.next) === true)
+                return false;
+
+            opt.remInstr(next);
+            return true;
+        }
+    },
+
+    // Comparison or test whose flags are never read
+    {
+        name: 'deadCmp',
+        mnems: ['cmp', 'test'],
+        apply: function (instr, opt)
+        {
+            if (x86.flagsLiveAfter(instr) === true)
+                return false;
+
+            opt.remInstr(instr);
+            return true;
+        }
+    },
+
+    // Comparison between a register and 0, replaced by test r, r
+    {
+        name: 'cmpZeroTest',
+        mnems: ['cmp'],
+        apply: function (instr, opt)
+        {
+            var reg = instr.opnds[0];
+
+            if (!(reg instanceof x86.Register) ||
+                x86.isImmVal(instr.opnds[1], 0) === false)
+                return false;
+
+            var testInstr = new x86.instrs.test([reg, reg], opt.x86_64);
+            opt.replInstr(instr, testInstr);
+            return true;
+        }
+    },
+
+    // Return with zero bytes popped, replaced by a ret with no immediate
+    {
+        name: 'retZero',
+        mnems: ['ret'],
+        apply: function (instr, opt)
+        {
+            if (x86.isImmVal(instr.opnds[0], 0) === false)
+                return false;
+
+            var newRet = new x86.instrs.ret([], opt.x86_64);
+            opt.replInstr(instr, newRet);
+            return true;
+        }
     }
+];
 
-    /**
-    Get the name for the logical inverse of a conditional jump instruction
-    */
-    function invCondJump(instr)
+/**
+Number of times each peephole rule was applied, by rule name
+*/
+x86.peepholeHits = {};
+
+/**
+Print the number of times each peephole rule was applied
+*/
+x86.reportPeephole = function ()
+{
+    print('Peephole rule hits:');
+
+    for (var i = 0; i < x86.peepholeRules.length; ++i)
     {
-        var invMnem = jumpInvs[instr.mnem];
-        return instrs[invMnem];
+        var name = x86.peepholeRules[i].name;
+        var hits = x86.peepholeHits[name];
+
+        print('  ' + rightPadStr(name, ' ', 20) + ((hits !== undefined)? hits:0));
     }
+}
+
+/**
+Optimize a sequence of x86 instructions using peephole patterns
+*/
+x86.optimize = function (asm, maxPasses)
+{
+    // Flag to indicate a change occurred
+    var changed = false;
 
-    /**
-    Get the label for a jump
-    */
-    function getJumpLabel(instr)
+    // Optimizer context passed to the rules
+    var opt = {
+        x86_64: asm.x86_64,
+
+        /**
+        Remove an instruction
+        */
+        remInstr: function (instr)
+        {
+            assert (
+                (instr instanceof x86.DataBlock) === false,
+                'removing data block'
+            );
+
+            asm.remInstr(instr);
+            changed = true;
+        },
+
+        /**
+        Add an instruction after another one
+        */
+        addAfter: function (newInstr, prev)
+        {
+            asm.addInstrAfter(newInstr, prev);
+            changed = true;
+        },
+
+        /**
+        Replace an instruction
+        */
+        replInstr: function (oldInstr, newInstr)
+        {
+            asm.replInstr(oldInstr, newInstr);
+            changed = true;
+        }
+    };
+
+    // Build the table of rules applicable to each mnemonic
+    var ruleTable = x86.optimize.ruleTable;
+    if (ruleTable === undefined)
     {
-        return instr.opnds[0].label;
+        ruleTable = x86.optimize.ruleTable = {};
+
+        for (var i = 0; i < x86.peepholeRules.length; ++i)
+        {
+            var rule = x86.peepholeRules[i];
+
+            for (var j = 0; j < rule.mnems.length; ++j)
+            {
+                var mnems = [rule.mnems[j]];
+
+                // The jcc key stands for all conditional jumps
+                if (mnems[0] === 'jcc')
+                {
+                    mnems = [];
+                    for (var mnem in x86.jumpInvs)
+                        mnems.push(mnem);
+                }
+
+                for (var k = 0; k < mnems.length; ++k)
+                {
+                    if (ruleTable[mnems[k]] === undefined)
+                        ruleTable[mnems[k]] = [];
+                    ruleTable[mnems[k]].push(rule);
+                }
+            }
+        }
     }
 
     // Until no change occurred
@@ -179,8 +766,7 @@ x86.optimize = function (asm, maxPasses)
     {
         //print(asm);
 
-        // Flag to indicate a change occurred
-        var changed = false;
+        changed = false;
 
         // For each instruction
         for (var instr = asm.getFirstInstr(); instr !== null; instr = instr.next)
@@ -197,147 +783,36 @@ x86.optimize = function (asm, maxPasses)
         // For each instruction
         for (var instr = asm.getFirstInstr(); instr !== null; instr = instr.next)
         {
-            //
-            // TODO: ****
-            // convert instr constructors to use arguments?
-            // simplify assembler helper functions?
-            //
-
-            // If this is a jump and the next instruction is not a data block
-            if ((isDirectJump(instr) === true ||
-                 isCondJump(instr) === true) &&
-                (instr.next instanceof x86.DataBlock) === false)
-            {
-                var label = getJumpLabel(instr);
-
-                // If this is a sequence of instructions of the form:
-                // jcc labelT
-                // jmp labelF
-                // labelT:
-                // ...
-                //
-                // Replace it by:
-                // jnc labelF:
-                // labelT:
-                // ..
-                if (isCondJump(instr) === true &&
-                    isDirectJump(instr.next) === true &&
-                    label === instr.next.next)
-                {
-                    // Create the inverse logical jump
-                    var invJmpCtor = invCondJump(instr);
-                    var labelF = getJumpLabel(instr.next);
-                    var newJmp = new invJmpCtor([new x86.LabelRef(labelF)], x86_64);               
+            var isLabel = instr instanceof x86.Label;
 
-                    // Remove the unconditional jump
-                    remInstr(instr.next);
+            // Jumps followed by a data block are stack info jumps
+            // which must be left untouched
+            if (instr.opnds[0] instanceof x86.LabelRef &&
+                instr.next instanceof x86.DataBlock)
+                continue;
 
-                    // Replace the conditional jump by its inverse
-                    replInstr(instr, newJmp);
-                }
+            var rules = ruleTable[isLabel? 'label':instr.mnem];
 
-                // If this is a jump to a jump
-                else if (isDirectJump(label.next) === true)
+            if (rules !== undefined)
+            {
+                // Apply the first matching rule
+                for (var i = 0; i < rules.length; ++i)
                 {
-                    var j2Label = getJumpLabel(label.next);
+                    var rule = rules[i];
 
-                    // If the second jump label is not the same as ours
-                    if (j2Label !== label)
+                    if (rule.apply(instr, opt) === true)
                     {
-                        // Jump directly to the second label
-                        var ctor = instrs[instr.mnem];
-                        var newJmp = new ctor([new x86.LabelRef(j2Label)], x86_64);
-                        replInstr(instr, newJmp);
+                        var hits = x86.peepholeHits[rule.name];
+                        x86.peepholeHits[rule.name] =
+                            (hits !== undefined)? hits + 1:1;
+                        break;
                     }
                 }
-
-                // If this is a jump to the next instruction
-                else if (label === instr.next)
-                {
-                    // Remove the jump
-                    remInstr(instr);
-                }
-
-                // If this is an unconditional jump and the next
-                // instruction is not a label
-                else if (isDirectJump(instr) === true &&
-                         instr.next !== null &&
-                         (instr.next instanceof x86.Label) === false)
-                {
-                    // Remove the instruction after the jump
-                    remInstr(instr.next);
-                }
             }
 
-            // If this is a label
-            else if (instr instanceof x86.Label)
-            {
-                // If the reference count is 0 and this label is
-                // not exported, remove it
-                if (instr.refCount === 0 && instr.exported === false)
-                    remInstr(instr);
-
-                // Reset the reference count for the label
+            // Reset the reference count for labels
+            if (isLabel === true)
                 instr.refCount = 0;
-            }
-
-            // If this is a move instruction
-            else if (instr instanceof instrs.mov)
-            {
-                // If the source and destination are the same
-                if (instr.opnds[0] === instr.opnds[1])
-                {
-                    // Remove the instruction
-                    remInstr(instr);
-                }
-
-                // If this is a move of 0 into a 32 or 64 bit register
-                else if (instr.opnds[0] instanceof x86.Register &&
-                         instr.opnds[0].size >= 32 &&
-                         instr.opnds[1] instanceof x86.Immediate &&
-                         instr.opnds[1].value === 0)
-                {
-                    // Replace the move by xor r, r
-                    var reg = instr.opnds[0];
-                    var newInstr = new instrs.xor([reg, reg], x86_64);
-                    replInstr(instr, newInstr);
-                }
-            }
-
-            // If this is an addition or subtraction
-            else if (instr instanceof instrs.add ||
-                     instr instanceof instrs.sub)
-            {
-                // If the second operand is immediate 0
-                if (instr.opnds.length === 2 &&
-                    instr.opnds[1] instanceof x86.Immediate &&
-                    instr.opnds[1].value === 0)
-                {
-                    // Remove the instruction
-                    remInstr(instr);
-                }
-            }
-
-            // If this is a comparison between a register and 0
-            else if (instr instanceof instrs.cmp &&
-                     instr.opnds[0] instanceof x86.Register &&
-                     instr.opnds[1] instanceof x86.Immediate &&
-                     instr.opnds[1].value === 0)
-            {
-                var reg = instr.opnds[0];
-                var testInstr = new instrs.test([reg, reg], x86_64);
-                replInstr(instr, testInstr);
-            }
-
-            // If this is a return with zero bytes popped
-            else if (instr instanceof instrs.ret &&
-                     instr.opnds[0] instanceof x86.Immediate &&
-                     instr.opnds[0].value === 0)
-            {
-                // Replace it by a ret with no immediate
-                var newRet = new instrs.ret([], x86_64);
-                replInstr(instr, newRet);
-            }
         }
 
         // If no changes occurred, stop
@@ -345,4 +820,3 @@ x86.optimize = function (asm, maxPasses)
             break;
     }
 };
-
@@ -1154,9 +1154,21 @@ x86.allocOpnds = function (
             }
         }
 
-        // If the dest is this operand and the use is 
-        // still live after this instruction
-        var destNeedsOpnd = destIsOpnd0 && opndIdx === 0 && liveOutFunc(use);
+        // If the dest is this operand and the use is still live after
+        // this instruction or is also read by another operand
+        var destNeedsOpnd = false;
+        if (destIsOpnd0 && opndIdx === 0)
+        {
+            destNeedsOpnd = liveOutFunc(use);
+
+            for (var otherIdx = 1;
+                 otherIdx < instr.uses.length && destNeedsOpnd === false;
+                 ++otherIdx)
+            {
+                if (instr.uses[otherIdx] === use)
+                    destNeedsOpnd = true;
+            }
+        }
 
         // Value for which this operand is being allocated
         var mapVal = (destIsOpnd0 && opndIdx === 0)? instr:use;
@@ -54,13 +54,20 @@ Test suite for x86 code generation
 tests.x86 = tests.x86 || tests.testSuite();
 
 /**
-Test x86 instruction encodings
+Test x86 instruction encodings. If a case function is given, it is
+called with each test case instead of checking its encodings.
 */
-tests.x86.asmEncoding = function ()
+tests.x86.asmEncoding = function (caseFunc)
 {
     // Test encodings for 32-bit and 64-bit
     function test(codeFunc, enc32, enc64)
     {
+        if (caseFunc !== undefined)
+        {
+            caseFunc(codeFunc, enc32, enc64);
+            return;
+        }
+
         // Test either a 32-bit or 64-bit encoding
         function testEnc(enc, x86_64)
         {
@@ -224,6 +231,17 @@ tests.x86.asmEncoding = function ()
         '4421E5'
     );
 
+    // andpd
+    test(
+        function (a) { a.andpd(a.xmm1, a.xmm2); },
+        '660F54CA'
+    );
+    test(
+        function (a) { a.andpd(a.xmm9, a.xmm10); },
+        false,
+        '66450F54CA'
+    );
+
     // cmovcc
     test(
         function (a) { a.cmovg(a.esi, a.edi); }, 
@@ -284,6 +302,17 @@ tests.x86.asmEncoding = function ()
         'F2480F2DD4'
     );
 
+    // cvttsd2si
+    test(
+        function (a) { a.cvttsd2si(a.ecx, a.xmm6); },
+        'F20F2CCE'
+    );
+    test(
+        function (a) { a.cvttsd2si(a.rdx, a.xmm4); },
+        false,
+        'F2480F2CD4'
+    );
+
     // cvtsi2sd
     test(
         function (a) { a.cvtsi2sd(a.xmm7, a.edi); }, 
@@ -898,6 +927,90 @@ tests.x86.asmEncoding = function ()
     );
 }
 
+/**
+Measure the assembler throughput, in instructions per second. The
+instruction encoding test cases are assembled into one code block per
+mode, with jumps of varied lengths between them.
+*/
+x86.asmBenchmark = function (numIters)
+{
+    if (numIters === undefined)
+        numIters = 100;
+
+    // Code generation functions of the test cases, for each mode
+    var cases32 = [];
+    var cases64 = [];
+
+    tests.x86.asmEncoding(
+        function (codeFunc, enc32, enc64)
+        {
+            if (enc32 !== false)
+                cases32.push(codeFunc);
+            if (enc64 !== false)
+                cases64.push(codeFunc);
+        }
+    );
+
+    // Generate the code for all the cases of a mode
+    function genCode(cases, x86_64)
+    {
+        var assembler = new x86.Assembler(x86_64);
+
+        var labels = [];
+        for (var i = 0; i < cases.length; ++i)
+            labels.push(new x86.Label('CASE_' + i));
+
+        for (var i = 0; i < cases.length; ++i)
+        {
+            assembler.addInstr(labels[i]);
+
+            cases[i](assembler);
+
+            // Jump back to a nearer or farther case, and now
+            // and then forward past a few cases
+            assembler.jne(labels[i >> 1]);
+            if (i % 16 === 0)
+                assembler.jmp(labels[Math.min(i + 8, cases.length - 1)]);
+        }
+
+        return assembler;
+    }
+
+    var numInstrs = 0;
+    var codeSize = 0;
+
+    var startTime = currentTimeMillis();
+
+    for (var iter = 0; iter < numIters; ++iter)
+    {
+        var modes = [[cases32, false], [cases64, true]];
+
+        for (var m = 0; m < modes.length; ++m)
+        {
+            var assembler = genCode(modes[m][0], modes[m][1]);
+
+            for (var instr = assembler.getFirstInstr(); 
+                 instr !== null; 
+                 instr = instr.next)
+            {
+                if (!(instr instanceof x86.Label))
+                    numInstrs++;
+            }
+
+            codeSize += assembler.assemble(true).size;
+        }
+    }
+
+    var time = Math.max(currentTimeMillis() - startTime, 1);
+
+    print(
+        'assembler: ' + (numInstrs / numIters) + ' instrs, ' +
+        (codeSize / numIters) + ' bytes, ' +
+        (time / numIters).toFixed(1) + ' ms/iter, ' +
+        Math.round(numInstrs * 1000 / time) + ' instrs/s'
+    );
+}
+
 /**
 Test the execution of x86 code snippets
 */
@@ -1094,5 +1207,25 @@ tests.x86.asmExecution = function ()
         }},
         11
     );
+
+    // Square root, rounding and truncation
+    test(
+        function (a) { with (a) {
+            push(regc);
+
+            mov(rega, 50);
+            cvtsi2sd(xmm0, rega);
+            sqrtsd(xmm0, xmm0);         // xmm0 = 7.07...
+            cvttsd2si(regc, xmm0);      // regc = 7
+            roundsd(xmm0, xmm0, 2);     // xmm0 = 8, rounded up
+            cvttsd2si(rega, xmm0);      // rega = 8
+            add(rega, regc);
+
+            pop(regc);
+
+            ret();
+        }},
+        15
+    );
 }
 
@@ -160,6 +160,8 @@ tests.x86.irToAsm = function ()
                 retVal
             );
         }
+
+        return irFunc;
     }
 
     // Simple IIR add tests, 1 argument, no spills needed
@@ -1425,7 +1427,7 @@ tests.x86.irToAsm = function ()
     );
 
     // JavaScript Fibonacci test (Tachyon function)
-    test('                                              \
+    var fibSrc = '                                      \
         function test(ctx, n)                           \
         {                                               \
             "tachyon:cproxy";                           \
@@ -1473,10 +1475,64 @@ tests.x86.irToAsm = function ()
                                                         \
             return iir.sub(x, y);                       \
         }                                               \
-        ',
-        55,
-        [10]
-    );
+    ';
+    test(fibSrc, 55, [10]);
+
+    // Direct calls linked through the far jump stubs, as when the
+    // callee is out of range of a 32-bit offset
+    if (backend.x86_64 === true)
+    {
+        backend.farDirectRefs = true;
+
+        try
+        {
+            var irFunc = test(fibSrc, 55, [10]);
+        }
+
+        finally
+        {
+            backend.farDirectRefs = false;
+        }
+
+        var codeBlock = irFunc.codeBlock;
+        var numFar = 0;
+
+        for (var i = 0; i < codeBlock.imports.length; ++i)
+        {
+            var ref = codeBlock.imports[i];
+
+            if (ref.entry === undefined)
+                continue;
+
+            // The call must go to the far jump stub of the block
+            var relOffset = 0;
+            for (var j = 3; j >= 0; --j)
+                relOffset = relOffset * 256 + codeBlock.readByte(ref.pos + j);
+            relOffset = relOffset | 0;
+
+            assert (
+                relOffset === ref.stubPos - (ref.pos + 4),
+                'direct call not linked through its far jump stub'
+            );
+
+            // The stub must hold the absolute entry point address
+            var entryAddr = ref.value.codeBlock.getExportAddr(ref.entry);
+            for (var j = 0; j < entryAddr.length; ++j)
+            {
+                assert (
+                    codeBlock.readByte(ref.stubPos + 6 + j) === entryAddr[j],
+                    'invalid entry point address in far jump stub'
+                );
+            }
+
+            numFar++;
+        }
+
+        assert (
+            numFar > 0,
+            'no direct calls in the test function'
+        );
+    }
 
     // Regression test: infinite loop code
     test('                                              \
@@ -1790,6 +1846,85 @@ tests.x86.irToAsm = function ()
 
 
 
+    // Edge profiling and profile-guided block layout
+    var profile = new EdgeProfile();
+    params.edgeProfile = profile;
+    var irFunc = test('                             \
+        function test(ctx, v1)                      \
+        {                                           \
+            "tachyon:cproxy";                       \
+            "tachyon:arg ctx rptr";                 \
+            "tachyon:arg v1 pint";                  \
+            "tachyon:ret pint";                     \
+                                                    \
+            var sum = pint(0);                      \
+            for (var i = pint(0); i < v1; ++i)      \
+            {                                       \
+                if (i < pint(2))                    \
+                    sum += pint(1);                 \
+                else                                \
+                    sum += pint(3);                 \
+            }                                       \
+                                                    \
+            return sum;                             \
+        }                                           \
+        ',
+        11,
+        [5]
+    );
+    params.edgeProfile = null;
+    profile.collect();
+
+    var counts = profile.getFuncCounts(irFunc);
+    assert (
+        counts !== undefined,
+        'no edge counts for profiled function'
+    );
+
+    var cfg = irFunc.lirCFG;
+    var order = orderBlocks(cfg.entry, cfg.blocks, { blockProfile: profile });
+    var ifFound = false;
+
+    assert (
+        order.length === cfg.blocks.length,
+        'block ordering does not cover all blocks'
+    );
+
+    for (var i = 0; i < order.length; ++i)
+    {
+        var block = order[i];
+
+        // Each block must come after one of its predecessors
+        var predFound = (block === cfg.entry);
+        for (var j = 0; j < i; ++j)
+            if (arraySetHas(block.preds, order[j]) === true)
+                predFound = true;
+
+        assert (
+            predFound,
+            'block placed before all of its predecessors'
+        );
+
+        // The if block must fall through to its most frequent target
+        var targets = block.getLastInstr().targets;
+        if (targets.length === 2 &&
+            counts.getCount(block, targets[0]) === 2 &&
+            counts.getCount(block, targets[1]) === 3)
+        {
+            assert (
+                order[i+1] === targets[1],
+                'hot if target not placed after the branch'
+            );
+
+            ifFound = true;
+        }
+    }
+
+    assert (
+        ifFound,
+        'no edge counts found for the if branch'
+    );
+
     /*
     // TODO: 
     // Add unit tests for problematic compilation cases
@@ -1824,3 +1959,172 @@ tests.x86.irToAsm = function ()
 
 }
 
+/**
+Test the peephole optimizer rules
+*/
+tests.x86.peephole = function ()
+{
+    // Check if we are running in 32-bit or 64-bit
+    const x86_64 = PLATFORM_64BIT;
+
+    // Test that optimized code still produces the expected value, and
+    // that the expected rules were applied
+    function test(genFunc, retVal, ruleNames)
+    {
+        // Create an assembler to generate code into
+        var assembler = new x86.Assembler(x86_64);
+
+        // Generate the code
+        genFunc(assembler);
+
+        // Save the rule hit counts before optimizing
+        var prevHits = {};
+        for (var i = 0; i < ruleNames.length; ++i)
+        {
+            var hits = x86.peepholeHits[ruleNames[i]];
+            prevHits[ruleNames[i]] = (hits !== undefined)? hits:0;
+        }
+
+        // Run the peephole optimizer
+        x86.optimize(assembler);
+
+        for (var i = 0; i < ruleNames.length; ++i)
+        {
+            var hits = x86.peepholeHits[ruleNames[i]];
+
+            if (hits === undefined || hits <= prevHits[ruleNames[i]])
+            {
+                error(
+                    'peephole rule "' + ruleNames[i] + '" not applied to:\n' +
+                    '\n' +
+                    assembler.toString(true)
+                );
+            }
+        }
+
+        // Assemble to a code block (code only, no header)
+        var codeBlock = assembler.assemble(true);
+
+        var blockAddr = codeBlock.getAddress();
+
+        var ctxPtr = x86_64? [0,0,0,0,0,0,0,0]:[0,0,0,0];
+
+        var ret = callTachyonFFI(
+            [],
+            'int',
+            blockAddr,
+            ctxPtr,
+            []
+        );
+
+        if (ret !== retVal)
+        {
+            error(
+                'invalid return value for:\n'+
+                '\n' +
+                assembler.toString(true) + '\n' +
+                '\n' +
+                'got:\n' +
+                ret + '\n' +
+                'expected:\n' +
+                retVal
+            );
+        }
+    }
+
+    // GP register aliases for 32-bit and 64-bit
+    var rega = x86_64? x86.regs.rax:x86.regs.eax;
+    var regc = x86_64? x86.regs.rcx:x86.regs.ecx;
+
+    // Move back into the source of a move
+    test(
+        function (a) { with (a) {
+            mov(rega, 7);
+            mov(regc, rega);
+            mov(rega, regc);
+            ret();
+        }},
+        7,
+        ['movBack']
+    );
+
+    // Move followed by an addition
+    test(
+        function (a) { with (a) {
+            mov(regc, 3);
+            mov(rega, regc);
+            add(rega, 4);
+            ret();
+        }},
+        7,
+        ['addMovLea']
+    );
+
+    // Conditional jump over an unconditional jump
+    test(
+        function (a) { with (a) {
+            var L1 = new x86.Label('L1');
+            var L2 = new x86.Label('L2');
+            mov(rega, 1);
+            cmp(rega, 1);
+            je(L1);
+            jmp(L2);
+            addInstr(L1);
+            mov(rega, 2);
+            ret();
+            addInstr(L2);
+            mov(rega, 0);
+            ret();
+        }},
+        2,
+        ['invertCondJump']
+    );
+
+    // Jump to a jump
+    test(
+        function (a) { with (a) {
+            var L1 = new x86.Label('L1');
+            var L2 = new x86.Label('L2');
+            mov(rega, 1);
+            cmp(rega, 1);
+            je(L1);
+            mov(rega, 0);
+            ret();
+            addInstr(L2);
+            mov(rega, 2);
+            ret();
+            addInstr(L1);
+            jmp(L2);
+        }},
+        2,
+        ['jumpThreading']
+    );
+
+    // Test after a logical operation
+    test(
+        function (a) { with (a) {
+            var L1 = new x86.Label('L1');
+            mov(rega, 6);
+            and(rega, 3);
+            test(rega, rega);
+            jne(L1);
+            mov(rega, 0);
+            addInstr(L1);
+            ret();
+        }},
+        2,
+        ['testAfterLogic']
+    );
+
+    // Dead flag-setting instructions
+    test(
+        function (a) { with (a) {
+            mov(rega, 5);
+            add(rega, 0);
+            cmp(rega, 3);
+            ret();
+        }},
+        5,
+        ['addZero', 'deadCmp']
+    );
+}
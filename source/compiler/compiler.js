@@ -97,6 +97,14 @@ function compileAST(ast, params)
     
     var ir = unitToIR(ast, params);
 
+    return compileUnit(ir, params);
+};
+
+/**
+Lower, compile and link the IR of a code unit
+*/
+function compileUnit(ir, params)
+{
     lowerIRFunc(ir, params);
 
     compileIR(ir, params);
@@ -105,7 +113,7 @@ function compileAST(ast, params)
 
     // Return the compiled IR function
     return ir;
-};
+}
 
 /**
 Compile a source string to compiled IR
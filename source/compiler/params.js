@@ -200,5 +200,39 @@ function CompParams(cfgObj)
     @field
     */
     this.printASM = false;
+
+    /**
+    Edge profile to record into. When set, the generated code
+    increments a counter on every CFG edge it takes.
+    @field
+    */
+    this.edgeProfile = null;
+
+    /**
+    Edge profile used to guide the block layout
+    @field
+    */
+    this.blockProfile = null;
+
+    /**
+    Type feedback to record into and to specialize the code with.
+    When set, arithmetic, comparison and property access sites are
+    compiled in the baseline or speculative tier.
+    @field
+    */
+    this.typeFeedback = null;
+
+    /**
+    Static type specialization, when the code is compiled using the
+    results of a type analysis run before lowering
+    @field
+    */
+    this.typeSpec = null;
+
+    /**
+    List of the inlining decisions made, if they should be reported
+    @field
+    */
+    this.inlineReport = null;
 }
 
@@ -259,6 +259,17 @@ v8::Handle<v8::Value> v8Proxy_currentTimeMillis(const v8::Arguments& args)
     return v8::Number::New(currentTimeMillis());
 }
 
+v8::Handle<v8::Value> v8Proxy_currentTimeNanos(const v8::Arguments& args)
+{
+    if (args.Length() != 0)
+    {
+        printf("Error in currentTimeNanos -- 0 argument expected\n");
+        exit(1);
+    }
+
+    return v8::Number::New(currentTimeNanos());
+}
+
 #define ACTIVATE_HEAP_PROFILING_not
 
 extern "C" 
@@ -794,6 +805,11 @@ void init_d8_extensions(v8::Handle<v8::ObjectTemplate> global_template)
         v8::FunctionTemplate::New(v8Proxy_currentTimeMillis)
     );
 
+    global_template->Set(
+        v8::String::New("currentTimeNanos"), 
+        v8::FunctionTemplate::New(v8Proxy_currentTimeNanos)
+    );
+
     global_template->Set(
         v8::String::New("memAllocatedKBs"), 
         v8::FunctionTemplate::New(v8Proxy_memAllocatedKBs)
@@ -46,6 +46,7 @@
 // Posix headers
 #include <sys/mman.h>
 #include <sys/time.h>
+#include <time.h>
 
 // C/C++ headers
 #include <assert.h>
@@ -284,6 +285,23 @@ int currentTimeMillis()
     return timeMs;
 }
 
+double currentTimeNanos()
+{
+    struct timespec timeSpec;
+
+    // Use the monotonic clock so that benchmark timings are not
+    // affected by adjustments of the system time
+    int r = clock_gettime(CLOCK_MONOTONIC, &timeSpec);
+
+    if (r != 0)
+    {
+        printf("Error in currentTimeNanos\n");
+        exit(0);
+    }
+
+    return timeSpec.tv_sec * 1000000000.0 + timeSpec.tv_nsec;
+}
+
 /*---------------------------------------------------------------------------*/
 
 uint8_t* allocMemoryBlock(size_t size, int exec)
@@ -71,6 +71,8 @@ double currentTimeSecs();
 
 int currentTimeMillis();
 
+double currentTimeNanos();
+
 /*---------------------------------------------------------------------------*/
 
 typedef intptr_t word; // must correspond to natural word width of CPU
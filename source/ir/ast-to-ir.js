@@ -221,6 +221,42 @@ function stmtListToIRFunc(
         localMap.set(symName, argVal);
     }
 
+    // Block at which the function body begins
+    var bodyBlock = entryBlock;
+
+    // Loop for self tail calls, if any
+    var tailLoop = null;
+
+    // If the function calls itself in tail position, create a loop header
+    // after the argument values so that the self tail calls can jump to it
+    if (astNode instanceof FunctionExpr &&
+        newFunc.cProxy !== true &&
+        newFunc.usesArguments !== true &&
+        newFunc.usesEval !== true &&
+        hasSelfTailCall(bodyStmts, funcName))
+    {
+        bodyBlock = cfg.getNewBlock('tail_loop');
+        entryBlock.addInstr(new JumpInstr(bodyBlock));
+
+        var thisPhi = new PhiInstr([thisVal], [entryBlock]);
+        bodyBlock.addInstr(thisPhi, 'this');
+        thisVal = thisPhi;
+
+        var argPhis = [];
+        for (var i = 0; i < newFunc.argVars.length; ++i)
+        {
+            var symName = newFunc.argVars[i].toString();
+
+            var argPhi = new PhiInstr([localMap.get(symName)], [entryBlock]);
+            bodyBlock.addInstr(argPhi, symName);
+            localMap.set(symName, argPhi);
+
+            argPhis.push(argPhi);
+        }
+
+        tailLoop = new TailLoop(bodyBlock, thisPhi, argPhis);
+    }
+
     // For each local variable declaration
     for (var i in localVars)
     {
@@ -240,7 +276,7 @@ function stmtListToIRFunc(
     // Create a context for the function body
     var bodyContext = new IRConvContext(
         bodyStmts, 
-        entryBlock,
+        bodyBlock,
         null,
         [],
         localMap,
@@ -251,7 +287,8 @@ function stmtListToIRFunc(
         cfg,
         funcObj,
         thisVal,
-        params
+        params,
+        tailLoop
     );
 
     // If the function uses the arguments object
@@ -666,6 +703,76 @@ function getIRFuncObj(
     return newFunc;
 }
 
+/**
+@class Loop header self tail calls of a function jump to. The phi nodes
+merge the this and argument values of the self tail calls.
+*/
+function TailLoop(block, thisPhi, argPhis)
+{
+    /**
+    Loop header block
+    @field
+    */
+    this.block = block;
+
+    /**
+    Phi node for the this value
+    @field
+    */
+    this.thisPhi = thisPhi;
+
+    /**
+    Phi nodes for the argument values
+    @field
+    */
+    this.argPhis = argPhis;
+}
+
+/**
+Test if a return statement returns the value of a call to a function of a
+given name. Such a call is in tail position.
+*/
+function isSelfTailCall(retStmt, funcName)
+{
+    var expr = retStmt.expr;
+
+    return (
+        expr instanceof CallExpr &&
+        expr.fn instanceof Ref &&
+        expr.fn.id.toString() === funcName
+    );
+}
+
+/**
+Test if a function body contains self tail calls, excluding those
+of nested functions
+*/
+function hasSelfTailCall(bodyStmts, funcName)
+{
+    var found = false;
+
+    var walkCtx = {
+        walk_statement: function (ast)
+        {
+            if (ast instanceof ReturnStatement && isSelfTailCall(ast, funcName))
+                found = true;
+
+            return ast_walk_statement(ast, this);
+        },
+        walk_expr: function (ast)
+        {
+            if (ast instanceof FunctionExpr)
+                return ast;
+
+            return ast_walk_expr(ast, this);
+        }
+    };
+
+    ast_walk_statements(bodyStmts, walkCtx);
+
+    return found;
+}
+
 /**
 @class IR Conversion context
 */
@@ -682,7 +789,8 @@ function IRConvContext(
     cfg,
     funcObj,
     thisVal,
-    params
+    params,
+    tailLoop
 )
 {
     // Ensure that the arguments are valid
@@ -738,6 +846,10 @@ function IRConvContext(
         params instanceof CompParams,
         'invalid compilation parameters in IR conversion context'
     );
+    assert (
+        tailLoop instanceof TailLoop || tailLoop === null,
+        'invalid tail loop in IR conversion context'
+    );
 
     /**
     AST node to convert
@@ -828,6 +940,12 @@ function IRConvContext(
     @field
     */
     this.params = params;
+
+    /**
+    Loop self tail calls jump to, null if there is none
+    @field
+    */
+    this.tailLoop = tailLoop;
 }
 IRConvContext.prototype = {};
 
@@ -946,7 +1064,8 @@ IRConvContext.prototype.pursue = function (astNode)
         this.cfg,
         this.funcObj,
         this.thisVal,
-        this.params
+        this.params,
+        this.tailLoop
     );
 };
 
@@ -972,7 +1091,8 @@ IRConvContext.prototype.branch = function (
         this.cfg,
         this.funcObj,
         this.thisVal,
-        this.params
+        this.params,
+        this.tailLoop
     );
 };
 
@@ -1590,8 +1710,18 @@ function stmtToIR(context)
         // Get the return type for this function
         var retType = context.cfg.ownerFunc.retType;
 
+        // If this is a self tail call which can jump to the tail loop
+        if (astStmt.expr !== null &&
+            context.tailLoop !== null &&
+            context.throwList === null &&
+            context.withVal === null &&
+            isSelfTailCall(astStmt, context.cfg.ownerFunc.funcName))
+        {
+            selfTailCallToIR(context);
+        }
+
         // If there is a return expression
-        if (astStmt.expr !== null)
+        else if (astStmt.expr !== null)
         {
             // Compile the return expression
             var retContext = context.pursue(astStmt.expr);
@@ -1916,27 +2046,85 @@ function stmtToIR(context)
             catchBlock.addPred(throwExit);
         }
 
-        // Create a new context for the catch statement
-        var catchCtx = context.branch(
-            astStmt.catch_part.statement,
-            catchBlock,
-            catchLocals
-        );
+        // If nothing can throw in the try body, the catch is unreachable
+        if (catchBlock === null)
+        {
+            var catchCtx = context.pursue(null);
+            catchCtx.terminate();
+        }
+
+        // If there is a catch clause
+        else if (astStmt.catch_part !== null)
+        {
+            // Create a new context for the catch statement
+            var catchCtx = context.branch(
+                astStmt.catch_part.statement,
+                catchBlock,
+                catchLocals
+            );
 
-        // TODO: disabled until catch scope issues are fixed in parser
-        /*
-        // Create a new shared map for the catch block
-        catchCtx.sharedMap = context.sharedMap.copy();
+            // Create a new shared map for the catch block, the catch
+            // variable shadows variables of the same name
+            catchCtx.sharedMap = context.sharedMap.copy();
 
-        // Set the exception value in a mutable cell
-        var catchVal = catchBlock.addInstr(new CatchInstr());
-        var catchCell = catchBlock.addInstr(new MakeCellInstr());
-        catchBlock.addInstr(new PutCellInstr(catchCell, catchVal));
-        catchCtx.sharedMap.set(astStmt.id.toString(), catchCell);
-        */
+            // Get the exception value
+            var catchName = astStmt.catch_part.id.toString();
+            var catchVal = insertPrimCallIR(catchCtx, 'getExcVal', []);
+
+            // Test if the catch variable is captured by a closure
+            var catchEscapes = (catchName in astStmt.catch_part.esc_vars);
+
+            if (catchEscapes)
+            {
+                // Set the exception value in a mutable cell
+                var catchCell = insertPrimCallIR(catchCtx, 'makeCell', []);
+                insertPrimCallIR(
+                    catchCtx,
+                    'set_cell_val',
+                    [catchCell, catchVal]
+                );
+                catchCtx.sharedMap.set(catchName, catchCell);
+            }
+            else
+            {
+                // Bind the exception value as a local variable
+                var outerVal = catchLocals.has(catchName)?
+                               catchLocals.get(catchName):undefined;
+                if (catchCtx.sharedMap.has(catchName))
+                    catchCtx.sharedMap.rem(catchName);
+                catchCtx.localMap.set(catchName, catchVal);
+            }
 
-        // Compile the catch statement
-        stmtToIR(catchCtx);
+            // Compile the catch statement
+            stmtToIR(catchCtx);
+
+            // Restore the binding shadowed by the catch variable, if any
+            if (!catchCtx.isTerminated() && !catchEscapes)
+            {
+                if (outerVal !== undefined)
+                    catchCtx.localMap.set(catchName, outerVal);
+                else
+                    catchCtx.localMap.rem(catchName);
+            }
+        }
+
+        // Otherwise, there is only a finally clause
+        else
+        {
+            // The finally statement is executed and the exception rethrown
+            var catchCtx = context.branch(
+                astStmt.finally_part,
+                catchBlock,
+                catchLocals
+            );
+
+            var excVal = insertPrimCallIR(catchCtx, 'getExcVal', []);
+
+            stmtToIR(catchCtx);
+
+            if (!catchCtx.isTerminated())
+                insertPrimCallIR(catchCtx, 'throwExc', [excVal]);
+        }
 
         // Merge the finally contexts
         //var finallyLocals = new HashMap();
@@ -1977,6 +2165,136 @@ function stmtToIR(context)
     }
 }
 
+/**
+Convert a return statement with a self tail call into IR code. If the
+callee is the current function, the call becomes a jump to the tail loop
+header, otherwise a regular call is made.
+*/
+function selfTailCallToIR(context)
+{
+    var callExpr = context.astNode.expr;
+    var tailLoop = context.tailLoop;
+    var ownerFunc = context.cfg.ownerFunc;
+
+    // Compile the function argument list
+    var argsContext = context.pursue(callExpr.args);
+    var argVals = exprListToIR(argsContext);
+
+    // Compile the function expression
+    var funcContext = argsContext.pursue(callExpr.fn);
+    exprToIR(funcContext);
+    var funcVal = funcContext.getOutValue();
+
+    // If this is a static call, the this value is undefined, otherwise
+    // it is the global object
+    if (funcVal instanceof IRFunction)
+        var thisVal = IRConst.getConst(undefined);
+    else
+        var thisVal = insertGetGlobal(funcContext);
+
+    // Compute the argument values passed to the tail loop, missing
+    // arguments are undefined and extra arguments are dropped
+    var loopArgs = [];
+    for (var i = 0; i < tailLoop.argPhis.length; ++i)
+    {
+        if (i < argVals.length)
+            loopArgs.push(argVals[i]);
+        else
+            loopArgs.push(IRConst.getConst(undefined));
+    }
+
+    // Test if the argument types match those of the tail loop
+    var typesMatch = (thisVal.type === tailLoop.thisPhi.type);
+    for (var i = 0; i < loopArgs.length; ++i)
+        if (loopArgs[i].type !== tailLoop.argPhis[i].type)
+            typesMatch = false;
+
+    // Static calls with mismatched arguments are not transformed
+    if (funcVal instanceof IRFunction &&
+        (funcVal !== ownerFunc || argVals.length !== loopArgs.length))
+        typesMatch = false;
+
+    /**
+    Jump from a block to the tail loop header
+    */
+    function jumpToLoop(block)
+    {
+        tailLoop.thisPhi.addIncoming(thisVal, block);
+        for (var i = 0; i < loopArgs.length; ++i)
+            tailLoop.argPhis[i].addIncoming(loopArgs[i], block);
+
+        block.addInstr(new JumpInstr(tailLoop.block));
+    }
+
+    /**
+    Call the function and return its value
+    */
+    function callAndRet(callContext)
+    {
+        if (funcVal instanceof IRFunction)
+        {
+            var retVal = insertExceptIR(
+                callContext,
+                new CallFuncInstr(
+                    [
+                        funcVal,
+                        IRConst.getConst(undefined),
+                        IRConst.getConst(undefined)
+                    ].concat(argVals)
+                )
+            );
+        }
+        else
+        {
+            var retVal = insertExceptIR(
+                callContext,
+                new JSCallInstr([funcVal, thisVal].concat(argVals))
+            );
+        }
+
+        callContext.addInstr(new RetInstr(retVal));
+    }
+
+    // If the arguments cannot be passed to the tail loop, make a regular call
+    if (typesMatch === false)
+    {
+        callAndRet(funcContext);
+    }
+
+    // If this is a static call to the current function, jump unconditionally
+    else if (funcVal instanceof IRFunction)
+    {
+        jumpToLoop(funcContext.getExitBlock());
+    }
+
+    // Otherwise, test if the callee is the current function object
+    else
+    {
+        var loopBlock = context.cfg.getNewBlock('self_tail');
+        var callBlock = context.cfg.getNewBlock('tail_call');
+
+        funcContext.addInstr(
+            new IfInstr(
+                [funcVal, context.funcObj],
+                'EQ',
+                loopBlock,
+                callBlock
+            )
+        );
+
+        jumpToLoop(loopBlock);
+
+        var callContext = context.branch(
+            null,
+            callBlock,
+            context.localMap.copy()
+        );
+        callContext.bridge();
+
+        callAndRet(callContext);
+    }
+}
+
 /**
 Convert an AST expression list into IR code
 @returns a list of values for the evaluated expressions
@@ -4012,7 +4330,8 @@ function createLoopEntry(
         context.cfg,
         context.funcObj,
         context.thisVal,
-        context.params
+        context.params,
+        context.tailLoop
     );
 }
 
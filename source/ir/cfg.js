@@ -1000,6 +1000,19 @@ ControlFlowGraph.prototype.getBlockItr = function (type)
     }
 };
 
+/**
+Get the number of instructions in the CFG
+*/
+ControlFlowGraph.prototype.getNumInstrs = function ()
+{
+    var numInstrs = 0;
+
+    for (var i = 0; i < this.blocks.length; ++i)
+        numInstrs += this.blocks[i].instrs.length;
+
+    return numInstrs;
+};
+
 /** 
 Returns an instruction iterator. Depending on the given type, the order of
 visited instructions might have certain properties.
@@ -100,13 +100,30 @@ function constProp(cfg, params)
     // Test if a basic block is reachable
     function isReachable(block)
     {
-        return (reachable[block.blockId] === true);
+        return reachable.has(block.blockId);
     }
 
     // Test if an edge was visited
     function edgeReachable(pred, succ)
     {
-        return (edgeVisited[pred.blockId][succ.blockId] === true);
+        return edgeVisited.has(edgeIndex.getIndex(pred, succ));
+    }
+
+    // Queue the dests of an instruction in reachable blocks into
+    // the SSA work list
+    function queueDests(instr)
+    {
+        for (var i = 0; i < instr.dests.length; ++i)
+        {
+            var dest = instr.dests[i];
+
+            if (reachable.has(dest.parentBlock.blockId) &&
+                !ssaQueued.has(dest.instrId))
+            {
+                ssaQueued.add(dest.instrId);
+                ssaWorkList.push(dest);
+            }
+        }
     }
 
     // Queue a CFG edge into the CFG work list
@@ -148,28 +165,25 @@ function constProp(cfg, params)
     // List of SSA edges to be processed
     var ssaWorkList = [];
 
-    // Reachable blocks, indexed by block id
-    var reachable = [];
+    // Instructions in the SSA work list
+    var ssaQueued = new BitSet(cfg.nextInstrId);
+
+    // Reachable blocks
+    var reachable = new BitSet(cfg.nextBlockId);
 
-    // Visited edges, indexed by predecessor id, successor id
-    var edgeVisited = [];
+    // Visited edges
+    var edgeIndex = new EdgeIndex(cfg);
+    var edgeVisited = new BitSet(edgeIndex.size);
 
     // Instruction values, indexed by instr id
     var instrVals = [];
 
-    // Initialize all edges to unvisited
-    for (var itr = cfg.getBlockItr(); itr.valid(); itr.next())
-        edgeVisited[itr.get().blockId] = [];
-    for (var itr = cfg.getEdgeItr(); itr.valid(); itr.next())
-        edgeVisited[itr.get().pred.blockId][itr.get().succ.blockId] = undefined;
-
     // Initialize all instruction values to top
     for (var itr = cfg.getInstrItr(); itr.valid(); itr.next())
         instrVals[itr.get().instrId] = TOP;
 
     // Add the entry block to the CFG work list
-    cfgWorkList.push({pred: cfg.entry, succ:cfg.entry});
-    edgeVisited[cfg.entry.blockId][cfg.entry.blockId] = undefined;
+    cfgWorkList.push({pred: null, succ:cfg.entry});
 
     // Until a fixed point is reached
     while (cfgWorkList.length > 0 || ssaWorkList.length > 0)
@@ -182,23 +196,26 @@ function constProp(cfg, params)
             var pred = edge.pred;
             var succ = edge.succ;
 
-            // Test if this edge has already been visited
-            var firstEdgeVisit = (edgeVisited[pred.blockId][succ.blockId] !== true);
+            // If this is not the first visit of this edge, do nothing.
+            // The entry block has no incoming edge.
+            if (pred !== null)
+            {
+                var edgeIdx = edgeIndex.getIndex(pred, succ);
 
-            // If this is not the first visit of this edge, do nothing
-            if (!firstEdgeVisit)
-                continue;
+                if (edgeVisited.has(edgeIdx))
+                    continue;
+
+                // Mark the edge as visited
+                edgeVisited.add(edgeIdx);
+            }
 
             // Test if this is the first visit to this block
-            var firstVisit = (reachable[succ.blockId] !== true);
+            var firstVisit = !reachable.has(succ.blockId);
 
             //print('iterating cfg: ' + succ.getBlockName() + (firstVisit? ' (first visit)':''));
 
-            // Mark the edge as visited
-            edgeVisited[pred.blockId][succ.blockId] = true;
-
             // Mark the successor block as reachable
-            reachable[succ.blockId] = true;
+            reachable.add(succ.blockId);
 
             // For each instruction in the successor block
             for (var i = 0; i < succ.instrs.length; ++i)
@@ -215,18 +232,8 @@ function constProp(cfg, params)
                 // Evaluate the instruction
                 instrVals[instr.instrId] = evalInstr(instr);
 
-                // For each dest of the instruction
-                for (var j = 0; j < instr.dests.length; ++j)
-                {
-                    var dest = instr.dests[j];
-
-                    // If the block of the destination is reachable
-                    if (reachable[dest.parentBlock.blockId] === true)
-                    {
-                        // Add the dest to the SSA work list
-                        ssaWorkList.push(dest);
-                    }
-                }
+                // Add the dests to the SSA work list
+                queueDests(instr);
             }
         }
 
@@ -235,6 +242,7 @@ function constProp(cfg, params)
         {
             // Remove an edge from the SSA work list
             var v = ssaWorkList.pop();
+            ssaQueued.rem(v.instrId);
 
             // Evaluate the value of the edge dest
             var t = evalInstr(v);
@@ -250,18 +258,8 @@ function constProp(cfg, params)
                 // Update the value for this instruction
                 instrVals[v.instrId] = t;
                 
-                // For each dest of v
-                for (var i = 0; i < v.dests.length; ++i)
-                {
-                    var dest = v.dests[i];
-
-                    // If the block of the destination is reachable
-                    if (reachable[dest.parentBlock.blockId] === true)
-                    {
-                        // Add the dest to the SSA work list
-                        ssaWorkList.push(dest);
-                    }
-                }
+                // Add the dests of v to the SSA work list
+                queueDests(v);
             }
         }
     }
@@ -0,0 +1,393 @@
+/* _________________________________________________________________________
+ *
+ *             Tachyon : A Self-Hosted JavaScript Virtual Machine
+ *
+ *
+ *  This file is part of the Tachyon JavaScript project. Tachyon is
+ *  distributed at:
+ *  http://github.com/Tachyon-Team/Tachyon
+ *
+ *
+ *  Copyright (c) 2011, Universite de Montreal
+ *  All rights reserved.
+ *
+ *  This software is licensed under the following license (Modified BSD
+ *  License):
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the Universite de Montreal nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL UNIVERSITE DE
+ *  MONTREAL BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * _________________________________________________________________________
+ */
+
+/**
+@fileOverview
+Dataflow analysis framework. Sets of blocks, edges and values are
+represented by bit sets over dense id numbers, and blocks are processed in
+reverse post-order.
+*/
+
+/**
+Compute a reverse post-order of the blocks reachable from an entry block
+*/
+function getBlockRPO(entry)
+{
+    var order = [];
+    var visited = [];
+
+    // Stack of blocks and indices of the next successor to visit
+    var blockStack = [entry];
+    var succStack = [0];
+    visited[entry.blockId] = true;
+
+    while (blockStack.length > 0)
+    {
+        var top = blockStack.length - 1;
+        var block = blockStack[top];
+        var succIdx = succStack[top];
+
+        if (succIdx < block.succs.length)
+        {
+            succStack[top] = succIdx + 1;
+
+            var succ = block.succs[succIdx];
+
+            if (visited[succ.blockId] !== true)
+            {
+                visited[succ.blockId] = true;
+                blockStack.push(succ);
+                succStack.push(0);
+            }
+        }
+        else
+        {
+            order.push(block);
+            blockStack.pop();
+            succStack.pop();
+        }
+    }
+
+    order.reverse();
+
+    return order;
+}
+
+/**
+@class Work list of blocks, processed in a fixed order such as a reverse
+post-order. A block is in the list at most once. Blocks are removed in
+order, from the position of the last block removed, so that each pass
+over the list follows the order.
+*/
+function BlockWorkList(blocks)
+{
+    /**
+    Blocks, in processing order
+    @field
+    */
+    this.blocks = blocks;
+
+    /**
+    Position of each block in the order, indexed by block id
+    @field
+    */
+    this.blockPos = [];
+
+    for (var i = 0; i < blocks.length; ++i)
+        this.blockPos[blocks[i].blockId] = i;
+
+    /**
+    Positions of the blocks in the list
+    @field
+    */
+    this.queued = new BitSet(blocks.length);
+
+    /**
+    Position at which to look for the next block
+    @field
+    */
+    this.curPos = 0;
+
+    /**
+    Number of blocks in the list
+    @field
+    */
+    this.length = 0;
+}
+BlockWorkList.prototype = {};
+
+/**
+Add a block to the work list, if it is not already queued.
+Blocks which are not part of the order are ignored.
+*/
+BlockWorkList.prototype.add = function (block)
+{
+    var pos = this.blockPos[block.blockId];
+
+    if (pos === undefined || this.queued.has(pos))
+        return;
+
+    this.queued.add(pos);
+    this.length++;
+};
+
+/**
+Add all the blocks of the order to the work list
+*/
+BlockWorkList.prototype.addAll = function ()
+{
+    for (var i = 0; i < this.blocks.length; ++i)
+        this.add(this.blocks[i]);
+};
+
+/**
+Test if the work list is empty
+*/
+BlockWorkList.prototype.isEmpty = function ()
+{
+    return (this.length === 0);
+};
+
+/**
+Remove the next block from the work list
+*/
+BlockWorkList.prototype.remNext = function ()
+{
+    assert (
+        this.length > 0,
+        'work list is empty'
+    );
+
+    var pos = this.queued.nextSet(this.curPos);
+
+    if (pos === -1)
+        pos = this.queued.nextSet(0);
+
+    this.queued.rem(pos);
+    this.length--;
+    this.curPos = pos + 1;
+
+    return this.blocks[pos];
+};
+
+/**
+@class Dense numbering of the values used in a CFG. Instructions are
+numbered by their instruction id, other values, such as constants, follow.
+*/
+function ValueIndex(cfg)
+{
+    /**
+    Index of the first value which is not an instruction
+    @field
+    */
+    this.numInstrIds = cfg.nextInstrId;
+
+    /**
+    Values which are not instructions, by index
+    @field
+    */
+    this.otherVals = [];
+
+    /**
+    Map of values which are not instructions to their index
+    @field
+    */
+    this.otherIdxs = new HashMap();
+
+    for (var itr = cfg.getInstrItr(); itr.valid(); itr.next())
+    {
+        var instr = itr.get();
+
+        for (var i = 0; i < instr.uses.length; ++i)
+        {
+            var use = instr.uses[i];
+
+            if (!(use instanceof IRInstr) && !this.otherIdxs.has(use))
+            {
+                this.otherIdxs.set(use, this.numInstrIds + this.otherVals.length);
+                this.otherVals.push(use);
+            }
+        }
+    }
+
+    /**
+    Number of values indexed
+    @field
+    */
+    this.size = this.numInstrIds + this.otherVals.length;
+
+    /**
+    Instructions, by index
+    @field
+    */
+    this.instrs = [];
+
+    for (var itr = cfg.getInstrItr(); itr.valid(); itr.next())
+        this.instrs[itr.get().instrId] = itr.get();
+}
+ValueIndex.prototype = {};
+
+/**
+Get the index of a value, or -1 if the value is not used in the CFG
+*/
+ValueIndex.prototype.getIndex = function (val)
+{
+    if (val instanceof IRInstr)
+        return val.instrId;
+
+    var idx = this.otherIdxs.get(val);
+
+    return (idx === HashMap.NOT_FOUND)? -1:idx;
+};
+
+/**
+Get the value with a given index
+*/
+ValueIndex.prototype.getValue = function (idx)
+{
+    if (idx < this.numInstrIds)
+        return this.instrs[idx];
+
+    return this.otherVals[idx - this.numInstrIds];
+};
+
+/**
+@class Dense numbering of the edges of a CFG. The edges leaving a block are
+numbered consecutively, in the order of the block successors.
+*/
+function EdgeIndex(cfg)
+{
+    /**
+    Index of the first edge leaving each block, indexed by block id
+    @field
+    */
+    this.firstEdge = [];
+
+    var numEdges = 0;
+
+    for (var i = 0; i < cfg.blocks.length; ++i)
+    {
+        var block = cfg.blocks[i];
+
+        this.firstEdge[block.blockId] = numEdges;
+        numEdges += block.succs.length;
+    }
+
+    /**
+    Number of edges indexed
+    @field
+    */
+    this.size = numEdges;
+}
+EdgeIndex.prototype = {};
+
+/**
+Get the index of an edge
+*/
+EdgeIndex.prototype.getIndex = function (pred, succ)
+{
+    var succIdx = pred.succs.indexOf(succ);
+
+    assert (
+        succIdx !== -1,
+        'invalid CFG edge'
+    );
+
+    return this.firstEdge[pred.blockId] + succIdx;
+};
+
+/**
+Solve a dataflow problem whose sets are bit sets and whose meet operation is
+the union, iterating to a fixed point. For a forward problem, the input set
+of a block is the meet of the edges from its predecessors, and its output
+set is computed by the transfer function. For a backward problem, the
+output set of a block is the meet of the edges from its successors, and its
+input set is computed by the transfer function.
+
+@param blocks blocks to analyze, in reverse post-order
+@param backward flag indicating that this is a backward problem
+@param setSize size of the bit sets
+@param edgeFunc function (pred, succ, srcSet, dstSet) which adds the
+       contribution of an edge to the meet set of a block. srcSet is the
+       transferred set of the other block of the edge.
+@param transFunc function (block, set) which transforms the meet set of a
+       block in place
+@returns an object with the input and output sets, indexed by block id
+*/
+function solveDataflow(blocks, backward, setSize, edgeFunc, transFunc)
+{
+    // For backward problems, visit the blocks in post-order
+    var order = backward? blocks.slice(0).reverse():blocks;
+
+    var workList = new BlockWorkList(order);
+    workList.addAll();
+
+    // Meet and transferred sets, indexed by block id
+    var meetSets = [];
+    var transSets = [];
+
+    while (workList.isEmpty() === false)
+    {
+        var block = workList.remNext();
+
+        // Compute the meet of the incoming edges
+        var meetSet = new BitSet(setSize);
+        var edgeBlocks = backward? block.succs:block.preds;
+        for (var i = 0; i < edgeBlocks.length; ++i)
+        {
+            var other = edgeBlocks[i];
+            var srcSet = transSets[other.blockId];
+
+            if (srcSet === undefined)
+                continue;
+
+            if (backward)
+                edgeFunc(block, other, srcSet, meetSet);
+            else
+                edgeFunc(other, block, srcSet, meetSet);
+        }
+
+        meetSets[block.blockId] = meetSet;
+
+        // Apply the transfer function
+        var transSet = meetSet.copy();
+        transFunc(block, transSet);
+
+        var oldSet = transSets[block.blockId];
+
+        // If the transferred set changed, queue the dependent blocks
+        if (oldSet === undefined || !oldSet.equal(transSet))
+        {
+            transSets[block.blockId] = transSet;
+
+            var depBlocks = backward? block.preds:block.succs;
+            for (var i = 0; i < depBlocks.length; ++i)
+                workList.add(depBlocks[i]);
+        }
+    }
+
+    return {
+        inSets: backward? transSets:meetSets,
+        outSets: backward? meetSets:transSets
+    };
+}
+
@@ -0,0 +1,540 @@
+/* _________________________________________________________________________
+ *
+ *             Tachyon : A Self-Hosted JavaScript Virtual Machine
+ *
+ *
+ *  This file is part of the Tachyon JavaScript project. Tachyon is
+ *  distributed at:
+ *  http://github.com/Tachyon-Team/Tachyon
+ *
+ *
+ *  Copyright (c) 2011, Universite de Montreal
+ *  All rights reserved.
+ *
+ *  This software is licensed under the following license (Modified BSD
+ *  License):
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the Universite de Montreal nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL UNIVERSITE DE
+ *  MONTREAL BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * _________________________________________________________________________
+ */
+
+/**
+@fileOverview
+Type feedback collection and feedback-driven speculative lowering of
+HIR arithmetic, comparison and property access instructions.
+
+Code compiled with a type feedback object passes every feedback site
+through one of two tiers. Baseline sites call a wrapper which records
+the tags of the operands in a feedback cell before calling the generic
+primitive. Sites which are hot and have only seen the types a fast path
+handles are lowered to an inlined guarded fast path instead. When a
+guard fails, execution continues in the generic primitive, within the
+same frame, so no frame state needs to be reconstructed. The failure
+is counted, and sites which fail too often are deoptimized back to
+the baseline tier the next time the code is compiled. Functions which
+have no feedback yet get their loops versioned for on-stack replacement
+(see osr.js), so that long-running loops reach the speculative tier
+during their first run.
+
+Each feedback cell is laid out as follows:
+- byte 0: tag bits seen for the first operand
+- byte 1: tag bits seen for the second operand
+- byte 2: guard failure count (saturating)
+- byte 3: unused
+- bytes 4-7: execution count (baseline tier only)
+*/
+
+/**
+@class Type feedback gathered over runs of compiled code
+*/
+function TypeFeedback()
+{
+    /**
+    @field Feedback site information for each function, by function key
+    */
+    this.funcs = {};
+
+    /**
+    @field Feedback cell memory blocks allocated for compiled functions
+    */
+    this.cells = [];
+
+    /**
+    @field Execution count above which a site is considered hot
+    */
+    this.hotThreshold = TypeFeedback.HOT_THRESHOLD;
+
+    /**
+    @field Guard failure count above which a site is deoptimized
+    */
+    this.deoptThreshold = TypeFeedback.DEOPT_THRESHOLD;
+
+    /**
+    @field Back edge count at which loops of functions without feedback
+    transfer to their speculative version, or 0 to disable OSR
+    */
+    this.osrThreshold = TypeFeedback.HOT_THRESHOLD;
+
+    /**
+    @field Number of baseline and speculative sites compiled
+    */
+    this.numBaseline = 0;
+    this.numSpec = 0;
+
+    /**
+    @field Number of loops versioned for OSR
+    */
+    this.numOsrLoops = 0;
+}
+
+/**
+Default execution count above which a site is considered hot
+*/
+TypeFeedback.HOT_THRESHOLD = 1000;
+
+/**
+Default guard failure count above which a site is deoptimized
+*/
+TypeFeedback.DEOPT_THRESHOLD = 16;
+
+/**
+Size of a feedback cell, in bytes
+*/
+TypeFeedback.CELL_SIZE = 8;
+
+/**
+Tag bits recorded for immediate integers. Integers have their two low
+bits cleared, so their reference tag reads as either 0 or 4.
+*/
+TypeFeedback.INT_BITS = (1 << 0) | (1 << 4);
+
+/**
+Tag bits recorded for arrays
+*/
+TypeFeedback.ARRAY_BITS = (1 << 5);
+
+/**
+Feedback site kinds. Each kind names the HIR instruction class, the
+generic primitive, the tags its fast path expects for each operand and
+the source of the fast path, with v1 and v2 as the operands.
+*/
+TypeFeedback.siteKinds = [
+
+    {
+        instrClass: JSAddInstr,
+        prim: 'add',
+        tags: [TypeFeedback.INT_BITS, TypeFeedback.INT_BITS],
+        fastPath: '                                         \
+            if (boxIsInt(v1) && boxIsInt(v2))               \
+            {                                               \
+                var r;                                      \
+                if (r = iir.add_ovf(v1, v2))                \
+                    return r;                               \
+            }'
+    },
+
+    {
+        instrClass: JSSubInstr,
+        prim: 'sub',
+        tags: [TypeFeedback.INT_BITS, TypeFeedback.INT_BITS],
+        fastPath: '                                         \
+            if (boxIsInt(v1) && boxIsInt(v2))               \
+            {                                               \
+                var r;                                      \
+                if (r = iir.sub_ovf(v1, v2))                \
+                    return r;                               \
+            }'
+    },
+
+    {
+        instrClass: JSMulInstr,
+        prim: 'mul',
+        tags: [TypeFeedback.INT_BITS, TypeFeedback.INT_BITS],
+        fastPath: '                                         \
+            if (boxIsInt(v1) && boxIsInt(v2))               \
+            {                                               \
+                var i1 = iir.icast(IRType.pint, v1);        \
+                i1 = i1 >> TAG_NUM_BITS_INT;                \
+                var i2 = iir.icast(IRType.pint, v2);        \
+                var r;                                      \
+                if (r = iir.mul_ovf(i1, i2))                \
+                    return iir.icast(IRType.box, r);        \
+            }'
+    },
+
+    {
+        instrClass: JSLtInstr,
+        prim: 'lt',
+        tags: [TypeFeedback.INT_BITS, TypeFeedback.INT_BITS],
+        fastPath: '                                         \
+            if (boxIsInt(v1) && boxIsInt(v2))               \
+            {                                               \
+                if (iir.if_lt(v1, v2))                      \
+                    return true;                            \
+                else                                        \
+                    return false;                           \
+            }'
+    },
+
+    {
+        instrClass: JSLeInstr,
+        prim: 'le',
+        tags: [TypeFeedback.INT_BITS, TypeFeedback.INT_BITS],
+        fastPath: '                                         \
+            if (boxIsInt(v1) && boxIsInt(v2))               \
+            {                                               \
+                if (iir.if_le(v1, v2))                      \
+                    return true;                            \
+                else                                        \
+                    return false;                           \
+            }'
+    },
+
+    {
+        instrClass: JSGtInstr,
+        prim: 'gt',
+        tags: [TypeFeedback.INT_BITS, TypeFeedback.INT_BITS],
+        fastPath: '                                         \
+            if (boxIsInt(v1) && boxIsInt(v2))               \
+            {                                               \
+                if (iir.if_gt(v1, v2))                      \
+                    return true;                            \
+                else                                        \
+                    return false;                           \
+            }'
+    },
+
+    {
+        instrClass: JSGeInstr,
+        prim: 'ge',
+        tags: [TypeFeedback.INT_BITS, TypeFeedback.INT_BITS],
+        fastPath: '                                         \
+            if (boxIsInt(v1) && boxIsInt(v2))               \
+            {                                               \
+                if (iir.if_ge(v1, v2))                      \
+                    return true;                            \
+                else                                        \
+                    return false;                           \
+            }'
+    },
+
+    {
+        instrClass: GetPropInstr,
+        prim: 'getProp',
+        tags: [TypeFeedback.ARRAY_BITS, TypeFeedback.INT_BITS],
+        fastPath: '                                         \
+            if (boxIsArray(v1) && boxIsInt(v2) && v2 >= 0)  \
+            {                                               \
+                var elem = getElemArr(v1, v2);              \
+                if (elem !== UNDEFINED)                     \
+                    return elem;                            \
+            }'
+    }
+];
+
+/**
+Get the feedback site kind of an instruction, if it is a feedback site
+*/
+TypeFeedback.getSiteKind = function (instr)
+{
+    for (var i = 0; i < TypeFeedback.siteKinds.length; ++i)
+    {
+        var kind = TypeFeedback.siteKinds[i];
+
+        if (instr instanceof kind.instrClass)
+            return kind;
+    }
+
+    return undefined;
+}
+
+/**
+Generate the source of a baseline site wrapper, which records the
+operand tags before calling the generic primitive
+*/
+TypeFeedback.genBaseline = function (primName)
+{
+    return '                                                \
+    function ' + primName + '_fbrec(cell, v1, v2)           \
+    {                                                       \
+        "tachyon:static";                                   \
+        "tachyon:noglobal";                                 \
+        "tachyon:arg cell rptr";                            \
+                                                            \
+        fbCountHit(cell);                                   \
+        fbRecordTag(cell, pint(0), v1);                     \
+        fbRecordTag(cell, pint(1), v2);                     \
+                                                            \
+        return ' + primName + '(v1, v2);                    \
+    }';
+}
+
+/**
+Generate the source of a speculative site wrapper, which tries the fast
+path of the site kind and falls back to the generic primitive
+*/
+TypeFeedback.genSpec = function (primName, fastPath)
+{
+    return '                                                \
+    function ' + primName + '_fbspec(cell, v1, v2)          \
+    {                                                       \
+        "tachyon:static";                                   \
+        "tachyon:noglobal";                                 \
+        "tachyon:arg cell rptr";                            \
+                                                            \
+        ' + fastPath + '                                    \
+                                                            \
+        /* Guard failure, fall back to the generic path */  \
+        fbGuardFail(cell);                                  \
+                                                            \
+        return ' + primName + '(v1, v2);                    \
+    }';
+}
+
+/**
+Load feedback from a file
+*/
+TypeFeedback.readFile = function (fileName)
+{
+    var feedback = new TypeFeedback();
+
+    var data = JSON.parse(readFile(fileName));
+
+    for (var funcKey in data)
+        feedback.funcs[funcKey] = data[funcKey];
+
+    return feedback;
+}
+
+/**
+Write the feedback to a file
+*/
+TypeFeedback.prototype.writeFile = function (fileName)
+{
+    this.collect();
+
+    writeFile(fileName, JSON.stringify(this.funcs));
+}
+
+/**
+Prepare the lowering of the feedback sites of a CFG. Allocates the
+feedback cells of the function and returns the state used by
+lowerSite.
+*/
+TypeFeedback.prototype.beginFunc = function (cfg)
+{
+    var irFunc = cfg.ownerFunc;
+
+    // Number the feedback sites of the function
+    var numSites = 0;
+    for (var itr = cfg.getInstrItr(); itr.valid(); itr.next())
+    {
+        var instr = itr.get();
+
+        if (TypeFeedback.getSiteKind(instr) !== undefined)
+            instr.fbSite = numSites++;
+    }
+
+    var funcKey = irFunc.getProfileKey();
+
+    var cells = {
+        funcKey: funcKey,
+        sites: this.funcs[funcKey],
+        numSites: numSites,
+        specSites: [],
+        memBlock: null,
+        addrs: []
+    };
+
+    if (numSites === 0)
+        return cells;
+
+    var numBytes = numSites * TypeFeedback.CELL_SIZE;
+
+    cells.memBlock = allocZeroedBlock(numBytes);
+
+    for (var i = 0; i < numSites; ++i)
+    {
+        var addrBytes = getBlockAddr(cells.memBlock, i * TypeFeedback.CELL_SIZE);
+        cells.addrs.push(addrToNum(addrBytes));
+    }
+
+    this.cells.push(cells);
+
+    // If the function has no feedback yet, version its loops so that
+    // long-running loops get to run speculative code
+    if (cells.sites === undefined && this.osrThreshold > 0)
+        this.numOsrLoops += osrVersionLoops(cfg, this.osrThreshold);
+
+    return cells;
+}
+
+/**
+Test if a feedback site should be compiled speculatively
+*/
+TypeFeedback.prototype.isSpecSite = function (kind, site, instr)
+{
+    if (site !== undefined && site.deopt === true)
+        return false;
+
+    // Sites of loop versions entered through OSR are always speculative
+    if (instr.fbOsr === true)
+        return true;
+
+    if (site === undefined)
+        return false;
+
+    if (site.hits < this.hotThreshold)
+        return false;
+
+    // Each operand must have been seen with the expected tags only
+    for (var i = 0; i < kind.tags.length; ++i)
+    {
+        if (site.tags[i] === 0 || (site.tags[i] & ~kind.tags[i]) !== 0)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+Lower a feedback site. Returns the primitive to call along with its
+arguments, or undefined if the instruction is not a feedback site.
+*/
+TypeFeedback.prototype.lowerSite = function (cells, instr, params)
+{
+    var kind = TypeFeedback.getSiteKind(instr);
+
+    if (kind === undefined || instr.fbSite === undefined)
+        return undefined;
+
+    var siteIdx = instr.fbSite;
+
+    var site = (cells.sites !== undefined)? cells.sites[siteIdx]:undefined;
+
+    if (this.isSpecSite(kind, site, instr))
+    {
+        var primFunc = genSpecPrim(
+            instr.constructor,
+            TypeFeedback.genSpec,
+            [kind.prim, kind.fastPath],
+            params
+        );
+
+        // The fast path is inlined into the caller
+        primFunc.inline = true;
+
+        cells.specSites.push(siteIdx);
+        this.numSpec++;
+    }
+    else
+    {
+        var primFunc = genSpecPrim(
+            instr.constructor,
+            TypeFeedback.genBaseline,
+            [kind.prim],
+            params
+        );
+
+        this.numBaseline++;
+    }
+
+    return {
+        func: primFunc,
+        args: [IRConst.getConst(cells.addrs[siteIdx], IRType.rptr)].concat(
+            instr.uses
+        )
+    };
+}
+
+/**
+Read the values of the feedback cells into the feedback
+*/
+TypeFeedback.prototype.collect = function ()
+{
+    for (var i = 0; i < this.cells.length; ++i)
+    {
+        var cells = this.cells[i];
+
+        var sites = this.funcs[cells.funcKey];
+        if (sites === undefined)
+            sites = this.funcs[cells.funcKey] = {};
+
+        for (var j = 0; j < cells.numSites; ++j)
+        {
+            var site = sites[j];
+            if (site === undefined)
+                site = sites[j] = { tags: [0, 0], hits: 0, fails: 0 };
+
+            var cellOfs = j * TypeFeedback.CELL_SIZE;
+            var readByte = function (k)
+            {
+                return readFromMemoryBlock(cells.memBlock, cellOfs + k);
+            };
+
+            site.tags[0] |= readByte(0);
+            site.tags[1] |= readByte(1);
+            site.fails += readByte(2);
+
+            var hits = 0;
+            for (var k = 7; k >= 4; --k)
+                hits = hits * 256 + readByte(k);
+            site.hits += hits;
+
+            // Sites whose guards fail too often go back to the baseline
+            if (site.fails > this.deoptThreshold)
+                site.deopt = true;
+
+            // Clear the cell so that it is not collected twice
+            for (var k = 0; k < TypeFeedback.CELL_SIZE; ++k)
+                writeToMemoryBlock(cells.memBlock, cellOfs + k, 0);
+        }
+    }
+}
+
+/**
+Print a summary of the feedback sites compiled
+*/
+TypeFeedback.prototype.report = function ()
+{
+    this.collect();
+
+    print('type feedback: ' + this.numSpec + ' speculative sites, ' +
+          this.numBaseline + ' baseline sites, ' +
+          this.numOsrLoops + ' OSR loops');
+
+    for (var funcKey in this.funcs)
+    {
+        var sites = this.funcs[funcKey];
+
+        for (var siteIdx in sites)
+        {
+            var site = sites[siteIdx];
+
+            if (site.deopt === true)
+                print('  deoptimized: ' + funcKey + ' site ' + siteIdx);
+        }
+    }
+}
@@ -266,6 +266,20 @@ IRFunction.prototype.getValName = function ()
     return '<fn' + (this.funcName? (' "' + this.funcName + '"'):'') + '>';
 };
 
+/**
+Get a key identifying this function across compilations, used to store
+its profiling data
+*/
+IRFunction.prototype.getProfileKey = function ()
+{
+    var key = this.funcName;
+
+    if (this.astNode !== undefined && this.astNode.loc !== undefined)
+        key += '@' + this.astNode.loc.to_string();
+
+    return key;
+};
+
 /**
 Create a deep copy of the function
 */
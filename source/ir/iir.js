@@ -88,6 +88,7 @@ var iir =
     // Low-level stack access
     get_ra      : GetRetAddrInstr,
     get_bp      : GetBasePtrInstr,
+    unwind      : UnwindInstr,
 
     // Low-level trace print
     trace_print : TracePrintInstr,
@@ -106,6 +107,7 @@ var iir =
     mul         : MulInstr,
     div         : DivInstr,
     mod         : ModInstr,
+    isqrt       : ISqrtInstr,
 
     // Arithmetic instructions with overflow handling
     add_ovf     : AddOvfInstr,
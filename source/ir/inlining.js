@@ -62,9 +62,11 @@ function isInlinable(calleeFunc)
 }
 
 /**
-Inline an IR function at a call site
+Inline an IR function at a call site. The high-level CFG of the callee
+is inlined if useHIR is true or if the callee has not been lowered yet.
+Returns the list of blocks copied from the callee.
 */
-function inlineCall(callInstr, calleeFunc)
+function inlineCall(callInstr, calleeFunc, useHIR)
 {
     // Ensure that the call site is valid
     assert (
@@ -90,7 +92,7 @@ function inlineCall(callInstr, calleeFunc)
     //
     // Copy the callee function's High-level CFG
     //var calleeCFG = calleeFunc.hirCFG.copy();
-    if (calleeFunc.lirCFG)
+    if (calleeFunc.lirCFG && useHIR !== true)
         var calleeCFG = calleeFunc.lirCFG.copy();
     else
         var calleeCFG = calleeFunc.hirCFG.copy();
@@ -280,5 +282,320 @@ function inlineCall(callInstr, calleeFunc)
     callBlock.addInstr(
         new JumpInstr(calleeCFG.entry)
     );
+
+    return calleeCFG.blocks;
+}
+
+
+/**
+Size of an IR function's high-level CFG, in instructions
+*/
+function getFuncSize(irFunc)
+{
+    if (irFunc.hirCFG === null)
+        return 0;
+
+    var size = 0;
+    for (var i = 0; i < irFunc.hirCFG.blocks.length; ++i)
+        size += irFunc.hirCFG.blocks[i].instrs.length;
+
+    return size;
+}
+
+/**
+Find the function a JS call instruction calls, if it is a function
+declared at the top level of the compilation unit and called through
+the global object, or a top-level function the static type analysis
+proves to be the only callee. Returns null if the callee is not known.
+*/
+function getKnownCallee(callInstr)
+{
+    if (callInstr.taCallee !== undefined)
+        return callInstr.taCallee;
+
+    var funcVal = callInstr.uses[0];
+
+    if (!(funcVal instanceof GetGlobalInstr) ||
+        !(funcVal.uses[1] instanceof IRConst) ||
+        typeof funcVal.uses[1].value !== 'string')
+        return null;
+
+    var funcName = funcVal.uses[1].value;
+
+    var unitFunc = callInstr.parentBlock.parentCFG.ownerFunc;
+    while (unitFunc.parentFunc !== null)
+        unitFunc = unitFunc.parentFunc;
+
+    var callee = unitFunc.getChild(funcName);
+
+    // The callee must be a direct child of the unit
+    if (callee === null || callee.parentFunc !== unitFunc)
+        return null;
+
+    return callee;
+}
+
+/**
+Perform cost-driven inlining of calls to known user functions. Each
+inlined call is guarded by a test of the callee closure, the original
+call being made if the guard fails. Returns the number of calls inlined.
+*/
+function inlineCalls(cfg, params)
+{
+    assert (
+        params instanceof CompParams,
+        'expected compilation parameters'
+    );
+
+    var callerFunc = cfg.ownerFunc;
+    var callerSize = 0;
+    for (var i = 0; i < cfg.blocks.length; ++i)
+        callerSize += cfg.blocks[i].instrs.length;
+
+    // Size the function may grow to through inlining
+    var maxSize =
+        callerSize * inlineCalls.MAX_GROWTH_FACTOR + inlineCalls.GROWTH_SLACK;
+    var curSize = callerSize;
+
+    // Compute the loop depth of the call sites
+    var loops = findNaturalLoops(computeDoms(cfg));
+    function loopDepth(block)
+    {
+        var depth = 0;
+        for (var i = 0; i < loops.length; ++i)
+            if (loops[i].body[block.blockId] === true)
+                depth++;
+
+        return depth;
+    }
+
+    // Collect the initial call sites
+    var work = [];
+    for (var itr = cfg.getInstrItr(); itr.valid(); itr.next())
+    {
+        var instr = itr.get();
+
+        if (instr instanceof JSCallInstr)
+        {
+            work.push({
+                instr: instr,
+                depth: loopDepth(instr.parentBlock),
+                chain: [callerFunc]
+            });
+        }
+    }
+
+    var numInlined = 0;
+
+    while (work.length > 0)
+    {
+        var site = work.shift();
+        var callInstr = site.instr;
+
+        var callee = getKnownCallee(callInstr);
+        if (callee === null)
+            continue;
+
+        var calleeSize = getFuncSize(callee);
+
+        // Budget for the callee size, larger at frequent call sites
+        var budget =
+            inlineCalls.MAX_CALLEE_SIZE +
+            inlineCalls.LOOP_DEPTH_BONUS *
+            Math.min(site.depth, inlineCalls.MAX_LOOP_DEPTH);
+
+        // Number of times the callee already appears in the inlining chain
+        var numRec = 0;
+        for (var i = 0; i < site.chain.length; ++i)
+            if (site.chain[i] === callee)
+                numRec++;
+
+        var reason;
+        if (callInstr.targets.length > 0)
+            reason = 'call has branch targets';
+        else if (callee.usesArguments || callee.usesEval || callee.cProxy ||
+            callee.childFuncs.length > 0 || callee.hirCFG === null ||
+            isInlinable(callee) === false)
+            reason = 'not inlinable';
+        else if (calleeSize > budget)
+            reason = 'callee too large (' + calleeSize + ' > ' + budget + ')';
+        else if (numRec > inlineCalls.MAX_RECURSION)
+            reason = 'recursion limit';
+        else if (site.chain.length > inlineCalls.MAX_INLINE_DEPTH)
+            reason = 'inlining depth limit';
+        else if (curSize + calleeSize > maxSize)
+            reason = 'caller growth limit';
+
+        // Calls which are not inlined are made directly when possible,
+        // bypassing the closure dispatch of the generic call primitives
+        var direct =
+            reason !== undefined &&
+            callInstr.targets.length === 0 &&
+            callee.usesArguments === false &&
+            callee.usesEval === false &&
+            callee.cProxy === false;
+
+        if (params.inlineReport instanceof Array)
+        {
+            params.inlineReport.push(
+                callerFunc.funcName + ' -> ' + callee.funcName +
+                ' (loop depth ' + site.depth + '): ' +
+                ((reason === undefined)?
+                 ('inlined, +' + calleeSize + ' instrs'):
+                 ('not inlined, ' + reason + (direct? ', direct call':'')))
+            );
+        }
+
+        if (reason !== undefined)
+        {
+            if (direct === true)
+                guardCall(cfg, callInstr, callee, params);
+
+            continue;
+        }
+
+        var newBlocks = inlineGuardedCall(cfg, callInstr, callee, params);
+        curSize += calleeSize;
+        numInlined++;
+
+        // Queue the calls of the inlined body
+        var chain = site.chain.concat([callee]);
+        for (var i = 0; i < newBlocks.length; ++i)
+        {
+            var block = newBlocks[i];
+
+            for (var j = 0; j < block.instrs.length; ++j)
+            {
+                if (block.instrs[j] instanceof JSCallInstr)
+                {
+                    work.push({
+                        instr: block.instrs[j],
+                        depth: site.depth,
+                        chain: chain
+                    });
+                }
+            }
+        }
+    }
+
+    return numInlined;
+}
+
+/**
+Base size budget for inlined callees, in HIR instructions
+*/
+inlineCalls.MAX_CALLEE_SIZE = 30;
+
+/**
+Extra callee size budget per loop nesting level of the call site
+*/
+inlineCalls.LOOP_DEPTH_BONUS = 20;
+
+/**
+Maximum loop depth considered for the size budget
+*/
+inlineCalls.MAX_LOOP_DEPTH = 3;
+
+/**
+Number of times a function may be inlined into its own inlined body
+*/
+inlineCalls.MAX_RECURSION = 1;
+
+/**
+Maximum length of a chain of nested inlined calls
+*/
+inlineCalls.MAX_INLINE_DEPTH = 4;
+
+/**
+Factor by which inlining may grow a function, plus a fixed slack
+*/
+inlineCalls.MAX_GROWTH_FACTOR = 2;
+inlineCalls.GROWTH_SLACK = 60;
+
+/**
+Inline a known callee at a JS call site, behind a guard testing that the
+called value is a closure of the callee. The original call is made when
+the guard fails. Returns the list of blocks copied from the callee.
+*/
+function inlineGuardedCall(cfg, callInstr, callee, params)
+{
+    var directCall = guardCall(cfg, callInstr, callee, params);
+
+    return inlineCall(directCall, callee, true);
 }
 
+/**
+Replace a JS call site by a direct call to a known callee, behind a guard
+testing that the called value is a closure of the callee. The original
+call is made when the guard fails. Returns the direct call instruction.
+*/
+function guardCall(cfg, callInstr, callee, params)
+{
+    assert (
+        callInstr.targets.length === 0,
+        'cannot guard calls with branch targets'
+    );
+
+    var callBlock = callInstr.parentBlock;
+
+    // Find the index of the call instruction
+    for (var ci = 0; callBlock.instrs[ci] !== callInstr; ++ci);
+
+    // Move the instructions after the call to a continuation block
+    var contBlock = cfg.splitBlock(callBlock, ci + 1);
+
+    var inlBlock = cfg.getNewBlock('call_direct');
+    var slowBlock = cfg.getNewBlock('call_slow');
+    var joinBlock = cfg.getNewBlock('call_join');
+
+    // Direct call to the known callee. Missing arguments are passed as
+    // undefined, extra arguments are already evaluated and can be dropped
+    // since the callee does not use the arguments object.
+    var directUses = [callee].concat(callInstr.uses.slice(0, 2));
+    for (var i = 0; i < callee.getNumArgs(); ++i)
+    {
+        directUses.push(
+            (i + 2 < callInstr.uses.length)?
+            callInstr.uses[i + 2]:IRConst.getConst(undefined)
+        );
+    }
+    var directCall = new CallFuncInstr(directUses);
+    inlBlock.addInstr(directCall);
+    inlBlock.addInstr(new JumpInstr(joinBlock));
+
+    // Original call, made if the guard fails
+    var slowCall = callInstr.copy();
+    slowCall.uses = callInstr.uses.slice(0);
+    slowCall.dests = [];
+    slowBlock.addInstr(slowCall, callInstr.outName);
+    slowBlock.addInstr(new JumpInstr(joinBlock));
+
+    // Merge the call results
+    var resPhi = joinBlock.addInstr(
+        new PhiInstr([directCall, slowCall], [inlBlock, slowBlock]),
+        callInstr.outName
+    );
+    joinBlock.addInstr(new JumpInstr(contBlock));
+
+    // Replace the call by the guard
+    var guard = new CallFuncInstr(
+        [
+            params.staticEnv.getBinding('boxIsClosOf'),
+            IRConst.getConst(undefined),
+            IRConst.getConst(undefined),
+            callInstr.uses[0],
+            callee
+        ]
+    );
+    callBlock.replInstrAtIndex(ci, guard, resPhi);
+    callBlock.addInstr(
+        new IfInstr(
+            [guard, IRConst.getConst(true)],
+            'EQ',
+            inlBlock,
+            slowBlock
+        )
+    );
+
+    return directCall;
+}
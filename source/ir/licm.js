@@ -0,0 +1,626 @@
+/* _________________________________________________________________________
+ *
+ *             Tachyon : A Self-Hosted JavaScript Virtual Machine
+ *
+ *
+ *  This file is part of the Tachyon JavaScript project. Tachyon is
+ *  distributed at:
+ *  http://github.com/Tachyon-Team/Tachyon
+ *
+ *
+ *  Copyright (c) 2011, Universite de Montreal
+ *  All rights reserved.
+ *
+ *  This software is licensed under the following license (Modified BSD
+ *  License):
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the Universite de Montreal nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL UNIVERSITE DE
+ *  MONTREAL BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * _________________________________________________________________________
+ */
+
+/**
+@fileOverview
+Dominator-based global value numbering and loop-invariant code motion.
+*/
+
+/**
+Compute the immediate dominators of the blocks of a CFG, using the
+iterative algorithm of Cooper, Harvey and Kennedy. Returns an object
+holding the immediate dominator of each block and the reverse
+postorder of the reachable blocks.
+*/
+function computeDoms(cfg)
+{
+    // Compute a postorder of the reachable blocks
+    var postOrder = [];
+    var visited = [];
+    var stack = [{ block: cfg.entry, next: 0 }];
+    visited[cfg.entry.blockId] = true;
+
+    while (stack.length > 0)
+    {
+        var top = stack[stack.length-1];
+
+        if (top.next < top.block.succs.length)
+        {
+            var succ = top.block.succs[top.next++];
+
+            if (visited[succ.blockId] !== true)
+            {
+                visited[succ.blockId] = true;
+                stack.push({ block: succ, next: 0 });
+            }
+        }
+        else
+        {
+            postOrder.push(top.block);
+            stack.pop();
+        }
+    }
+
+    // Postorder number of each block, indexed by block id
+    var poNum = [];
+    for (var i = 0; i < postOrder.length; ++i)
+        poNum[postOrder[i].blockId] = i;
+
+    // Immediate dominators, indexed by block id
+    var idom = [];
+    idom[cfg.entry.blockId] = cfg.entry;
+
+    function intersect(b1, b2)
+    {
+        while (b1 !== b2)
+        {
+            while (poNum[b1.blockId] < poNum[b2.blockId])
+                b1 = idom[b1.blockId];
+            while (poNum[b2.blockId] < poNum[b1.blockId])
+                b2 = idom[b2.blockId];
+        }
+
+        return b1;
+    }
+
+    var changed = true;
+    while (changed === true)
+    {
+        changed = false;
+
+        // For each block in reverse postorder, except the entry
+        for (var i = postOrder.length - 2; i >= 0; --i)
+        {
+            var block = postOrder[i];
+
+            var newIdom = undefined;
+            for (var j = 0; j < block.preds.length; ++j)
+            {
+                var pred = block.preds[j];
+
+                if (idom[pred.blockId] === undefined)
+                    continue;
+
+                newIdom = (newIdom === undefined)? pred:intersect(pred, newIdom);
+            }
+
+            if (idom[block.blockId] !== newIdom)
+            {
+                idom[block.blockId] = newIdom;
+                changed = true;
+            }
+        }
+    }
+
+    return {
+        idom: idom,
+        rpo: postOrder.reverse()
+    };
+}
+
+/**
+Test if a block dominates another, given the immediate dominators
+*/
+function blockDominates(idom, b1, b2)
+{
+    for (;;)
+    {
+        if (b2 === b1)
+            return true;
+
+        var next = idom[b2.blockId];
+
+        if (next === undefined || next === b2)
+            return false;
+
+        b2 = next;
+    }
+}
+
+/**
+Find the natural loops of a CFG, grouping back edges by loop header.
+Each loop has a header block, the sources of its back edges, a body set
+indexed by block id and a size.
+*/
+function findNaturalLoops(doms)
+{
+    var idom = doms.idom;
+
+    var loops = [];
+    var loopOfHeader = [];
+    for (var i = 0; i < doms.rpo.length; ++i)
+    {
+        var block = doms.rpo[i];
+
+        for (var j = 0; j < block.succs.length; ++j)
+        {
+            var header = block.succs[j];
+
+            if (blockDominates(idom, header, block) === false)
+                continue;
+
+            var loop = loopOfHeader[header.blockId];
+            if (loop === undefined)
+            {
+                loop = { header: header, latches: [], body: [], size: 1 };
+                loop.body[header.blockId] = true;
+                loopOfHeader[header.blockId] = loop;
+                loops.push(loop);
+            }
+
+            loop.latches.push(block);
+
+            // Add the blocks which reach the back edge to the loop body
+            var work = [block];
+            while (work.length > 0)
+            {
+                var b = work.pop();
+
+                if (loop.body[b.blockId] === true ||
+                    idom[b.blockId] === undefined)
+                    continue;
+
+                loop.body[b.blockId] = true;
+                loop.size++;
+
+                for (var k = 0; k < b.preds.length; ++k)
+                    work.push(b.preds[k]);
+            }
+        }
+    }
+
+    return loops;
+}
+
+/**
+Test if an instruction computes a pure value which can be computed
+speculatively, that is, moved to a point where it would not otherwise
+have executed.
+*/
+function isSpeculable(instr)
+{
+    return (
+        ((instr instanceof ArithInstr &&
+          !(instr instanceof DivInstr || instr instanceof ModInstr)) ||
+         instr instanceof BitOpInstr ||
+         instr instanceof FArithInstr ||
+         instr instanceof ISqrtInstr ||
+         instr instanceof ICastInstr ||
+         instr instanceof IToFInstr ||
+         instr instanceof FToIInstr) &&
+        instr.isBranch() === false
+    );
+}
+
+/**
+Test if a store instruction may write to the memory read by a load
+instruction. Accesses at constant offsets whose byte ranges do not
+overlap are disjoint if they go through the same base pointer value,
+or through two references. References always point to the start of a
+heap object, so equal offsets from two references designate the same
+field, whether or not the objects are the same.
+*/
+function storeMayAlias(load, store, params)
+{
+    var loadBase = load.uses[0];
+    var storeBase = store.uses[0];
+    var loadOffset = load.uses[1];
+    var storeOffset = store.uses[1];
+
+    if (!(loadOffset instanceof IRConst && loadOffset.isNumber() &&
+          storeOffset instanceof IRConst && storeOffset.isNumber()))
+        return true;
+
+    if (loadBase !== storeBase &&
+        !(loadBase.type === IRType.ref && storeBase.type === IRType.ref))
+        return true;
+
+    var loadEnd = num_add(
+        loadOffset.value,
+        load.type.getSizeBytes(params)
+    );
+    var storeEnd = num_add(
+        storeOffset.value,
+        store.typeParams[0].getSizeBytes(params)
+    );
+
+    return (
+        num_lt(loadOffset.value, storeEnd) &&
+        num_lt(storeOffset.value, loadEnd)
+    );
+}
+
+/**
+Perform loop-invariant code motion on a CFG. Invariant instructions are
+moved to the loop preheader, which is created if needed. Pure
+arithmetic is always hoisted. Loads, divisions and context reads are
+only hoisted if they execute on every loop iteration. Loads are not
+hoisted from loops containing calls or other instructions which may
+write memory, apart from stores to fields the load cannot read. Calls
+to functions already known not to write memory do not prevent
+hoisting. Returns the number of instructions hoisted.
+*/
+function licm(cfg, params)
+{
+    var doms = computeDoms(cfg);
+    var idom = doms.idom;
+
+    // Find the natural loops of the CFG
+    var loops = findNaturalLoops(doms);
+
+    // Process inner loops before outer loops
+    loops.sort(function (l1, l2) { return l1.size - l2.size; });
+
+    // Properties of the loop being processed
+    var body;
+    var exitBlocks;
+    var writesMem;
+    var stores;
+    var setsCtx;
+
+    //
+    // Test if a block executes on every iteration of the loop
+    //
+    function alwaysExecs(block)
+    {
+        for (var i = 0; i < exitBlocks.length; ++i)
+            if (blockDominates(idom, block, exitBlocks[i]) === false)
+                return false;
+
+        return true;
+    }
+
+    //
+    // Test if an instruction may be hoisted out of the loop
+    //
+    function canHoist(instr)
+    {
+        if (instr instanceof PhiInstr || instr.isBranch() === true)
+            return false;
+
+        for (var i = 0; i < instr.uses.length; ++i)
+        {
+            var use = instr.uses[i];
+
+            if (use instanceof IRInstr &&
+                body[use.parentBlock.blockId] === true)
+                return false;
+        }
+
+        if (isSpeculable(instr) === true)
+            return true;
+
+        if (instr instanceof LoadInstr)
+        {
+            if (writesMem === true || alwaysExecs(instr.parentBlock) === false)
+                return false;
+
+            for (var i = 0; i < stores.length; ++i)
+                if (storeMayAlias(instr, stores[i], params) === true)
+                    return false;
+
+            return true;
+        }
+
+        if (instr instanceof GetCtxInstr)
+            return setsCtx === false;
+
+        if (instr instanceof DivInstr || instr instanceof ModInstr)
+            return alwaysExecs(instr.parentBlock);
+
+        return false;
+    }
+
+    var numHoisted = 0;
+
+    for (var i = 0; i < loops.length; ++i)
+    {
+        var loop = loops[i];
+        var header = loop.header;
+        body = loop.body;
+
+        // Find the predecessors of the header from outside the loop
+        var outPreds = [];
+        for (var j = 0; j < header.preds.length; ++j)
+            if (body[header.preds[j].blockId] !== true)
+                outPreds.push(header.preds[j]);
+
+        // Only loops with a single entry edge are handled
+        if (outPreds.length !== 1)
+            continue;
+
+        var pred = outPreds[0];
+
+        // Collect the loop blocks in reverse postorder, find the loop
+        // exits and find out what the loop may write to. Stores are
+        // kept apart since they only write to a known location.
+        var loopBlocks = [];
+        exitBlocks = [];
+        writesMem = false;
+        stores = [];
+        setsCtx = false;
+        for (var j = 0; j < doms.rpo.length; ++j)
+        {
+            var block = doms.rpo[j];
+
+            if (body[block.blockId] !== true)
+                continue;
+
+            loopBlocks.push(block);
+
+            for (var k = 0; k < block.succs.length; ++k)
+            {
+                if (body[block.succs[k].blockId] !== true)
+                {
+                    exitBlocks.push(block);
+                    break;
+                }
+            }
+
+            for (var k = 0; k < block.instrs.length; ++k)
+            {
+                var instr = block.instrs[k];
+
+                if (instr instanceof StoreInstr)
+                    stores.push(instr);
+                else if (instr.writesMem() === true)
+                    writesMem = true;
+                if (instr instanceof SetCtxInstr)
+                    setsCtx = true;
+            }
+        }
+
+        // Find the instructions to hoist. Since hoisted instructions
+        // are moved out of the loop body, instructions depending on them
+        // become hoistable as well.
+        var hoisted = [];
+        for (var j = 0; j < loopBlocks.length; ++j)
+        {
+            var block = loopBlocks[j];
+
+            for (var k = 0; k < block.instrs.length; ++k)
+            {
+                var instr = block.instrs[k];
+
+                if (canHoist(instr) === false)
+                    continue;
+
+                block.instrs.splice(k, 1);
+                --k;
+
+                // Mark the instruction as outside the loop until it is
+                // placed in the preheader
+                instr.parentBlock = pred;
+
+                hoisted.push(instr);
+            }
+        }
+
+        if (hoisted.length === 0)
+            continue;
+
+        // If the predecessor cannot serve as a preheader, create one
+        var preheader = pred;
+        if (pred.succs.length !== 1 || !(pred.getLastInstr() instanceof JumpInstr))
+        {
+            preheader = cfg.getNewBlock('loop_preheader');
+            cfg.insertBetween(pred, header, preheader);
+
+            // Update the dominator tree
+            idom[preheader.blockId] = pred;
+            idom[header.blockId] = preheader;
+
+            // The preheader is part of any loop containing its predecessor
+            for (var j = i + 1; j < loops.length; ++j)
+            {
+                if (loops[j].body[pred.blockId] === true)
+                {
+                    loops[j].body[preheader.blockId] = true;
+                    loops[j].size++;
+                }
+            }
+
+            doms.rpo.splice(doms.rpo.indexOf(header), 0, preheader);
+        }
+
+        // Place the hoisted instructions before the preheader's branch
+        for (var j = 0; j < hoisted.length; ++j)
+        {
+            var instr = hoisted[j];
+            preheader.instrs.splice(preheader.instrs.length - 1, 0, instr);
+            instr.parentBlock = preheader;
+        }
+
+        numHoisted += hoisted.length;
+    }
+
+    return numHoisted;
+}
+
+/**
+Perform dominator-based global value numbering on a CFG. Pure
+instructions computing the same value as an instruction in a
+dominating position are replaced by that instruction. Returns the
+number of instructions removed.
+*/
+function domGVN(cfg)
+{
+    // Test if an instruction is commutative
+    function isCommut(instr)
+    {
+        return (
+            instr instanceof AddInstr ||
+            instr instanceof MulInstr ||
+            instr instanceof AndInstr ||
+            instr instanceof OrInstr ||
+            instr instanceof XorInstr ||
+            instr instanceof FAddInstr ||
+            instr instanceof FMulInstr
+        );
+    }
+
+    // Hashing function for IR values
+    function hashFunc(val)
+    {
+        var hashVal = val.mnemonic.length;
+        hashVal = (hashVal << 1) + val.mnemonic.charCodeAt(0);
+
+        // Commutative operands are hashed in an order-independent way
+        var opndHash = 0;
+        for (var i = 0; i < val.uses.length; ++i)
+        {
+            var use = val.uses[i];
+
+            var no;
+            if (use instanceof IRInstr)
+                no = use.instrId;
+            else if (typeof use.value === 'number')
+                no = use.value;
+            else
+                no = 0;
+
+            if (isCommut(val) === true)
+                opndHash = (opndHash + no) & 536870911;
+            else
+                opndHash = (((opndHash << 1) + no) & 536870911) % 426870919;
+        }
+
+        return (hashVal + opndHash) & 536870911;
+    }
+
+    // Equality function for IR values
+    function equalFunc(val1, val2)
+    {
+        if (val1.mnemonic !== val2.mnemonic ||
+            val1.type !== val2.type ||
+            val1.uses.length !== val2.uses.length)
+            return false;
+
+        var same = true;
+        for (var i = 0; i < val1.uses.length; ++i)
+            if (val1.uses[i] !== val2.uses[i])
+                same = false;
+
+        if (same === true)
+            return true;
+
+        return (
+            isCommut(val1) === true &&
+            val1.uses.length === 2 &&
+            val1.uses[0] === val2.uses[1] &&
+            val1.uses[1] === val2.uses[0]
+        );
+    }
+
+    var doms = computeDoms(cfg);
+
+    // Compute the dominator tree children of each block
+    var children = [];
+    for (var i = 0; i < doms.rpo.length; ++i)
+    {
+        var block = doms.rpo[i];
+        var parent = doms.idom[block.blockId];
+
+        if (parent === block)
+            continue;
+
+        if (children[parent.blockId] === undefined)
+            children[parent.blockId] = [];
+        children[parent.blockId].push(block);
+    }
+
+    // Table of available values, scoped along the dominator tree
+    var valTable = new HashMap(hashFunc, equalFunc);
+
+    var numRemoved = 0;
+
+    // Walk the dominator tree in preorder
+    var stack = [{ block: cfg.entry, added: null }];
+    while (stack.length > 0)
+    {
+        var top = stack.pop();
+
+        // If we are leaving a block, remove the values it made available
+        if (top.added !== null)
+        {
+            for (var i = 0; i < top.added.length; ++i)
+                valTable.rem(top.added[i]);
+            continue;
+        }
+
+        var block = top.block;
+        var added = [];
+
+        for (var i = 0; i < block.instrs.length; ++i)
+        {
+            var instr = block.instrs[i];
+
+            if (isSpeculable(instr) === false)
+                continue;
+
+            var domInstr = valTable.get(instr);
+
+            if (domInstr !== HashMap.NOT_FOUND)
+            {
+                block.replInstrAtIndex(i, undefined, domInstr);
+                --i;
+                ++numRemoved;
+            }
+            else
+            {
+                valTable.set(instr, instr);
+                added.push(instr);
+            }
+        }
+
+        stack.push({ block: block, added: added });
+
+        var blockChildren = children[block.blockId];
+        if (blockChildren !== undefined)
+        {
+            for (var i = blockChildren.length - 1; i >= 0; --i)
+                stack.push({ block: blockChildren[i], added: null });
+        }
+    }
+
+    return numRemoved;
+}
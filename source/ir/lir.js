@@ -233,6 +233,12 @@ IRInstr.prototype.baseCopy = function (newInstr)
     // Copy the instruction id
     newInstr.instrId = this.instrId;
 
+    // Copy the static type analysis results, if any
+    if (this.taTypes !== undefined)
+        newInstr.taTypes = this.taTypes;
+    if (this.taCallee !== undefined)
+        newInstr.taCallee = this.taCallee;
+
     // The new instruction is orphaned
     newInstr.parentBlock = null;
 
@@ -945,6 +951,27 @@ var ModInstr = instrMaker(
     new ArithInstr()
 );
 
+/**
+@class Integer square root instruction. The input must be non-negative.
+The result is computed in double precision and truncated, and so may be
+off by one for inputs which are not exactly representable as doubles.
+@augments IRInstr
+*/
+var ISqrtInstr = instrMaker(
+    'isqrt',
+    function (typeParams, inputVals, branchTargets)
+    {
+        instrMaker.validNumInputs(inputVals, 1, 1);
+
+        assert (
+            inputVals[0].type === IRType.pint,
+            'invalid input type'
+        );
+
+        this.type = inputVals[0].type;
+    }
+);
+
 //=============================================================================
 //
 // Arithmetic operations with overflow handling
@@ -2019,6 +2046,29 @@ The stack pointer instruction reads memory
 */
 GetBasePtrInstr.prototype.readsMem = function () { return true; };
 
+/**
+@class Instruction to unwind the stack to a given stack pointer and jump to
+an exception landing pad
+@augments IRInstr
+*/
+var UnwindInstr = instrMaker(
+    'unwind',
+    function (typeParams, inputVals, branchTargets)
+    {
+        instrMaker.validNumInputs(inputVals, 2, 2);
+        instrMaker.validType(inputVals[0], IRType.rptr);
+        instrMaker.validType(inputVals[1], IRType.rptr);
+
+        this.type = IRType.none;
+    }
+);
+
+/**
+Unwinding discards stack frames, it reads and writes memory
+*/
+UnwindInstr.prototype.readsMem = function () { return true; };
+UnwindInstr.prototype.writesMem = function () { return true; };
+
 /**
 @class Instruction to generate a low-level trace print
 @augments IRInstr
@@ -77,7 +77,11 @@ function lowerIRFunc(irFunc, params)
         //print('calling lowerIRCFG for "' + func.funcName + '"');
 
         // Perform lowering on the function's CFG
-        func.lirCFG = lowerIRCFG(func.hirCFG, params);
+        func.lirCFG = traceFunc(
+            'lower',
+            func.funcName,
+            function () { return lowerIRCFG(func.hirCFG, params); }
+        );
 
         //print('back from lowerIRCFG for "' + func.funcName + '"');
     }
@@ -101,6 +105,33 @@ function lowerIRCFG(cfg, params)
     // Perform a copy of the CFG before transforming it
     cfg = cfg.copy();
 
+    // Instruction count of the CFG, recorded by the compilation trace
+    function countInstrs() { return cfg.getNumInstrs(); }
+
+    // Inline the calls to small user functions
+    if (cfg.ownerFunc.staticLink === false)
+    {
+        measurePerformance(
+            "call inlining",
+            function ()
+            {
+                inlineCalls(cfg, params);
+
+                // Validate the CFG
+                if (DEBUG)
+                    cfg.validate();
+            },
+            countInstrs
+        );
+    }
+
+    // If type feedback is enabled, prepare the feedback cells of the
+    // function. Static primitives are never instrumented.
+    var fbCells;
+    if (params.typeFeedback instanceof TypeFeedback &&
+        cfg.ownerFunc.staticLink === false)
+        fbCells = params.typeFeedback.beginFunc(cfg);
+
     measurePerformance(
         "inlining/transform",
         function ()
@@ -146,6 +177,41 @@ function lowerIRCFG(cfg, params)
                     // Call the lowering function to get the
                     // primitive to be called
                     var primFunc = instr.lower(params);
+                    var primArgs = instr.uses;
+
+                    // If the operand types are known statically, call
+                    // the specialized version of the primitive
+                    var specSite = undefined;
+                    if (params.typeSpec instanceof TypeSpec)
+                    {
+                        specSite = params.typeSpec.lowerSite(
+                            instr,
+                            params
+                        );
+
+                        if (specSite !== undefined)
+                        {
+                            primFunc = specSite.func;
+                            primArgs = specSite.args;
+                        }
+                    }
+
+                    // If this is a type feedback site, call the feedback
+                    // recording or speculative version of the primitive
+                    if (fbCells !== undefined && specSite === undefined)
+                    {
+                        var fbSite = params.typeFeedback.lowerSite(
+                            fbCells,
+                            instr,
+                            params
+                        );
+
+                        if (fbSite !== undefined)
+                        {
+                            primFunc = fbSite.func;
+                            primArgs = fbSite.args;
+                        }
+                    }
 
                     // Create the primitive call
                     var callInstr = new CallFuncInstr(
@@ -153,7 +219,7 @@ function lowerIRCFG(cfg, params)
                             primFunc,
                             IRConst.getConst(undefined),
                             IRConst.getConst(undefined),
-                        ].concat(instr.uses).concat(instr.targets)
+                        ].concat(primArgs).concat(instr.targets)
                     );
 
                     // Replace the HIR instruction by the primitive call
@@ -183,7 +249,8 @@ function lowerIRCFG(cfg, params)
                     }
                 }
             }
-        }
+        },
+        countInstrs
     );
 
     measurePerformance(
@@ -200,11 +267,27 @@ function lowerIRCFG(cfg, params)
             // Validate the CFG
             if (DEBUG)
                 cfg.validate();
-        }
+        },
+        countInstrs
     );
 
     //print(cfg.ownerFunc);
 
+    measurePerformance(
+        "scalar replacement",
+        function ()
+        {
+            // Replace the properties of objects which do not escape
+            // the function by SSA values
+            scalarRepl(cfg, params);
+
+            // Validate the CFG
+            if (DEBUG)
+                cfg.validate();
+        },
+        countInstrs
+    );
+
     measurePerformance(
         "const prop",
         function ()
@@ -219,7 +302,23 @@ function lowerIRCFG(cfg, params)
             // Validate the CFG
             if (DEBUG)
                 cfg.validate();
-        }
+        },
+        countInstrs
+    );
+
+    measurePerformance(
+        "range prop",
+        function ()
+        {
+            // Remove overflow checks and tests made redundant by the
+            // ranges of integer values
+            rangeProp(cfg, params);
+
+            // Validate the CFG
+            if (DEBUG)
+                cfg.validate();
+        },
+        countInstrs
     );
 
     measurePerformance(
@@ -232,7 +331,8 @@ function lowerIRCFG(cfg, params)
             // Validate the CFG
             if (DEBUG)
                 cfg.validate();
-        }
+        },
+        countInstrs
     );
 
     measurePerformance(
@@ -249,7 +349,25 @@ function lowerIRCFG(cfg, params)
             // Validate the CFG
             if (DEBUG)
                 cfg.validate();
-        }
+        },
+        countInstrs
+    );
+
+    measurePerformance(
+        "licm/gvn",
+        function ()
+        {
+            // Hoist loop-invariant code out of loops
+            licm(cfg, params);
+
+            // Eliminate the redundancies exposed by code motion
+            domGVN(cfg);
+
+            // Validate the CFG
+            if (DEBUG)
+                cfg.validate();
+        },
+        countInstrs
     );
 
     measurePerformance(
@@ -281,7 +399,8 @@ function lowerIRCFG(cfg, params)
 
             //if (!cfg.ownerFunc.writesMem)
             //    print('############ DOES NOT WRITE MEM: ' + cfg.ownerFunc.funcName);
-        }
+        },
+        countInstrs
     );
 
     //print('*** lowering done ***');
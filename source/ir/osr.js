@@ -0,0 +1,416 @@
+/* _________________________________________________________________________
+ *
+ *             Tachyon : A Self-Hosted JavaScript Virtual Machine
+ *
+ *
+ *  This file is part of the Tachyon JavaScript project. Tachyon is
+ *  distributed at:
+ *  http://github.com/Tachyon-Team/Tachyon
+ *
+ *
+ *  Copyright (c) 2011, Universite de Montreal
+ *  All rights reserved.
+ *
+ *  This software is licensed under the following license (Modified BSD
+ *  License):
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the Universite de Montreal nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL UNIVERSITE DE
+ *  MONTREAL BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * _________________________________________________________________________
+ */
+
+/**
+@fileOverview
+On-stack replacement of long-running loops by loop versioning.
+
+Outermost loops of functions compiled in the baseline type feedback tier
+are duplicated. The original loop records type feedback and counts its
+back edges. Once the count reaches the OSR threshold, the back edge
+transfers control into the copy, whose feedback sites are compiled with
+speculative fast paths. The header phi nodes of the copy take their
+values from the back edge of the original loop, so that the state of
+the running frame carries over into the optimized loop mid-execution.
+*/
+
+/**
+Create optimized versions of the outermost loops of a CFG, with OSR
+transfers from the original loops. The feedback sites must have been
+numbered before. Returns the number of loops versioned.
+*/
+function osrVersionLoops(cfg, threshold)
+{
+    var doms = computeDoms(cfg);
+    var loops = findNaturalLoops(doms);
+
+    // Keep only the outermost loops
+    var outerLoops = loops.filter(
+        function (loop)
+        {
+            for (var i = 0; i < loops.length; ++i)
+            {
+                if (loops[i] !== loop &&
+                    loops[i].body[loop.header.blockId] === true)
+                    return false;
+            }
+
+            return true;
+        }
+    );
+
+    // Version the loops in program order. The transfers added to a loop
+    // header are then never seen as exits of a loop yet to be versioned.
+    var rpoIdx = [];
+    for (var i = 0; i < doms.rpo.length; ++i)
+        rpoIdx[doms.rpo[i].blockId] = i;
+    outerLoops.sort(
+        function (l1, l2)
+        {
+            return rpoIdx[l1.header.blockId] - rpoIdx[l2.header.blockId];
+        }
+    );
+
+    var numVersioned = 0;
+
+    for (var i = 0; i < outerLoops.length; ++i)
+    {
+        if (osrVersionLoop(cfg, outerLoops[i], threshold) === true)
+            numVersioned++;
+    }
+
+    return numVersioned;
+}
+
+/**
+Create an optimized version of a loop, with OSR transfers on the back
+edges of the original loop. Loops which have feedback sites and exit
+through a single block reached only from the loop are versioned.
+Returns true if the loop was versioned.
+*/
+function osrVersionLoop(cfg, loop, threshold)
+{
+    var header = loop.header;
+
+    var loopBlocks = [];
+    var exitBlock = undefined;
+    var numSites = 0;
+
+    for (var i = 0; i < cfg.blocks.length; ++i)
+    {
+        var block = cfg.blocks[i];
+
+        if (loop.body[block.blockId] !== true)
+            continue;
+
+        loopBlocks.push(block);
+
+        for (var j = 0; j < block.succs.length; ++j)
+        {
+            var succ = block.succs[j];
+
+            if (loop.body[succ.blockId] === true)
+                continue;
+
+            if (exitBlock !== undefined && exitBlock !== succ)
+                return false;
+
+            exitBlock = succ;
+        }
+
+        for (var j = 0; j < block.instrs.length; ++j)
+            if (block.instrs[j].fbSite !== undefined)
+                numSites++;
+    }
+
+    if (numSites === 0 || exitBlock === undefined || header === cfg.entry)
+        return false;
+
+    // If the exit block is also reached from outside the loop, give the
+    // loop a dedicated exit block
+    var exitPreds = exitBlock.preds.filter(
+        function (pred) { return loop.body[pred.blockId] === true; }
+    );
+    if (exitPreds.length !== exitBlock.preds.length)
+    {
+        var newExit = cfg.getNewBlock('loop_exit');
+
+        // Merge the phi inputs coming from the loop in the new block
+        var newPhis = [];
+        for (var i = 0; i < exitBlock.instrs.length; ++i)
+        {
+            var phi = exitBlock.instrs[i];
+
+            if (!(phi instanceof PhiInstr))
+                break;
+
+            var newPhi = new PhiInstr([], []);
+            for (var j = 0; j < exitPreds.length; ++j)
+            {
+                newPhi.addIncoming(phi.getIncoming(exitPreds[j]), exitPreds[j]);
+                phi.remPred(exitPreds[j]);
+            }
+
+            newExit.addInstr(newPhi, phi.outName);
+            newPhis.push(newPhi);
+        }
+
+        // Redirect the loop exits to the new block
+        for (var i = 0; i < exitPreds.length; ++i)
+        {
+            var pred = exitPreds[i];
+            var branch = pred.getLastInstr();
+
+            for (var j = 0; j < branch.targets.length; ++j)
+                if (branch.targets[j] === exitBlock)
+                    branch.targets[j] = newExit;
+
+            pred.remSucc(exitBlock);
+            exitBlock.remPred(pred);
+            pred.addSucc(newExit);
+            newExit.addPred(pred);
+        }
+
+        newExit.addInstr(new JumpInstr(exitBlock));
+
+        for (var i = 0; i < newPhis.length; ++i)
+            exitBlock.instrs[i].addIncoming(newPhis[i], newExit);
+
+        exitBlock = newExit;
+    }
+
+    //
+    // Copy the loop blocks and instructions
+    //
+
+    var blockMap = [];
+    var isCopy = [];
+    var instrMap = [];
+    var inLoop = [];
+
+    for (var i = 0; i < loopBlocks.length; ++i)
+    {
+        var block = loopBlocks[i];
+
+        var newBlock = cfg.getNewBlock(block.label + '_osr');
+        blockMap[block.blockId] = newBlock;
+        isCopy[newBlock.blockId] = true;
+
+        for (var j = 0; j < block.instrs.length; ++j)
+        {
+            var instr = block.instrs[j];
+            var newInstr = instr.copy();
+
+            newInstr.dests = [];
+            newInstr.fbSite = instr.fbSite;
+            newInstr.fbOsr = (instr.fbSite !== undefined);
+
+            instrMap[instr.instrId] = newInstr;
+            inLoop[instr.instrId] = instr;
+        }
+    }
+
+    function mapVal(val)
+    {
+        if (val instanceof IRInstr && inLoop[val.instrId] === val)
+            return instrMap[val.instrId];
+
+        return val;
+    }
+
+    for (var i = 0; i < loopBlocks.length; ++i)
+    {
+        var block = loopBlocks[i];
+        var newBlock = blockMap[block.blockId];
+
+        for (var j = 0; j < block.instrs.length; ++j)
+        {
+            var instr = block.instrs[j];
+            var newInstr = instrMap[instr.instrId];
+
+            newInstr.uses = instr.uses.map(mapVal);
+
+            if (instr instanceof PhiInstr)
+            {
+                newInstr.preds = [];
+
+                // The copied header is only entered from the copied loop
+                // and from the OSR transfers
+                for (var k = 0; k < instr.preds.length; ++k)
+                {
+                    var pred = instr.preds[k];
+
+                    if (loop.body[pred.blockId] !== true)
+                    {
+                        newInstr.uses[k] = undefined;
+                        continue;
+                    }
+
+                    newInstr.preds.push(blockMap[pred.blockId]);
+                }
+
+                newInstr.uses = newInstr.uses.filter(
+                    function (use) { return use !== undefined; }
+                );
+            }
+            else if (instr.isBranch())
+            {
+                newInstr.targets = instr.targets.map(
+                    function (target)
+                    {
+                        var newTarget = blockMap[target.blockId];
+                        return (newTarget !== undefined)? newTarget:target;
+                    }
+                );
+            }
+
+            newBlock.addInstr(newInstr, instr.outName);
+        }
+    }
+
+    //
+    // Merge the values leaving the two versions of the loop
+    //
+
+    // Add the incoming values from the copy to the exit phi nodes
+    for (var i = 0; i < exitBlock.instrs.length; ++i)
+    {
+        var phi = exitBlock.instrs[i];
+
+        if (!(phi instanceof PhiInstr))
+            break;
+
+        var numPreds = phi.preds.length;
+        for (var j = 0; j < numPreds; ++j)
+        {
+            phi.addIncoming(
+                mapVal(phi.uses[j]),
+                blockMap[phi.preds[j].blockId]
+            );
+        }
+    }
+
+    // Values defined in the loop and used after it now have two
+    // definitions. The exit block dominates all uses after the loop,
+    // so a phi node merging both definitions is placed there.
+    var exitPhis = [];
+    for (var i = 0; i < cfg.blocks.length; ++i)
+    {
+        var block = cfg.blocks[i];
+
+        if (loop.body[block.blockId] === true || isCopy[block.blockId] === true)
+            continue;
+
+        for (var j = 0; j < block.instrs.length; ++j)
+        {
+            var instr = block.instrs[j];
+
+            if (instr instanceof PhiInstr && block === exitBlock)
+                continue;
+
+            for (var k = 0; k < instr.uses.length; ++k)
+            {
+                var use = instr.uses[k];
+
+                if (!(use instanceof IRInstr) || inLoop[use.instrId] !== use)
+                    continue;
+
+                var phi = exitPhis[use.instrId];
+                if (phi === undefined)
+                {
+                    phi = new PhiInstr([], []);
+                    for (var l = 0; l < exitBlock.preds.length; ++l)
+                    {
+                        var pred = exitBlock.preds[l];
+
+                        if (loop.body[pred.blockId] === true)
+                            phi.addIncoming(use, pred);
+                        else
+                            phi.addIncoming(mapVal(use), pred);
+                    }
+
+                    exitBlock.addInstr(phi, use.outName, 0);
+                    exitPhis[use.instrId] = phi;
+                }
+
+                instr.uses[k] = phi;
+                use.remDest(instr);
+                phi.addDest(instr);
+            }
+        }
+    }
+
+    //
+    // Add the back edge counters and OSR transfers
+    //
+
+    var newHeader = blockMap[header.blockId];
+
+    var counter = new PhiInstr([], []);
+    for (var i = 0; i < header.preds.length; ++i)
+    {
+        var pred = header.preds[i];
+
+        if (loop.body[pred.blockId] !== true)
+            counter.addIncoming(IRConst.getConst(0, IRType.pint), pred);
+    }
+
+    for (var i = 0; i < loop.latches.length; ++i)
+    {
+        var latch = loop.latches[i];
+
+        var osrBlock = cfg.getNewBlock('osr_check');
+        cfg.insertBetween(latch, header, osrBlock);
+
+        var count = osrBlock.addInstr(
+            new AddInstr(counter, IRConst.getConst(1, IRType.pint)),
+            'osr_count',
+            0
+        );
+
+        osrBlock.replBranch(
+            new IfInstr(
+                [count, IRConst.getConst(threshold, IRType.pint)],
+                'GE',
+                newHeader,
+                header
+            )
+        );
+
+        counter.addIncoming(count, osrBlock);
+
+        // Map the state of the running loop onto the copy
+        for (var j = 0; j < header.instrs.length; ++j)
+        {
+            var phi = header.instrs[j];
+
+            if (!(phi instanceof PhiInstr))
+                break;
+
+            instrMap[phi.instrId].addIncoming(phi.getIncoming(osrBlock), osrBlock);
+        }
+    }
+
+    header.addInstr(counter, 'osr_count', 0);
+
+    return true;
+}
@@ -0,0 +1,960 @@
+/* _________________________________________________________________________
+ *
+ *             Tachyon : A Self-Hosted JavaScript Virtual Machine
+ *
+ *
+ *  This file is part of the Tachyon JavaScript project. Tachyon is
+ *  distributed at:
+ *  http://github.com/Tachyon-Team/Tachyon
+ *
+ *
+ *  Copyright (c) 2011, Universite de Montreal
+ *  All rights reserved.
+ *
+ *  This software is licensed under the following license (Modified BSD
+ *  License):
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the Universite de Montreal nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL UNIVERSITE DE
+ *  MONTREAL BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * _________________________________________________________________________
+ */
+
+/**
+@fileOverview
+Integer range propagation. Computes a conservative interval for each
+integer and boxed integer value in a function and uses it to remove
+overflow checks, integer tag tests and comparisons whose outcome is known.
+*/
+
+//=============================================================================
+//
+// Implementation of conditional range propagation
+//
+// Ranges are tracked for values of integer types and for boxed values. The
+// range of a boxed value, when there is one, means that the value is a
+// boxed integer whose untagged value lies in the range. Ranges are refined
+// along the conditional branches which dominate a use, much like pi nodes
+// would, and only the reachable branch edges are followed, as in SCCP.
+//
+// Relational comparisons and arithmetic with overflow checks on boxed values
+// are only ever generated for boxed integers, so both of their operands are
+// known to be boxed integers.
+//
+//=============================================================================
+
+/**
+Perform range propagation on a CFG
+*/
+function rangeProp(cfg, params)
+{
+    assert (
+        params instanceof CompParams,
+        'expected compilation parameters'
+    );
+
+    // Maximum number of times a phi node range may grow before it is widened
+    const MAX_PHI_CHANGES = 2;
+
+    // Maximum number of passes over the CFG before giving up
+    const MAX_PASSES = 32;
+
+    // Range of values representable by each type, indexed by type name
+    var typeRanges = {};
+
+    // Get the range of values a type can represent
+    function typeRange(type)
+    {
+        var range = typeRanges[type.name];
+
+        if (range === undefined)
+        {
+            range = {
+                min: type.getMinVal(params),
+                max: type.getMaxVal(params)
+            };
+
+            typeRanges[type.name] = range;
+        }
+
+        return range;
+    }
+
+    // Test if ranges are tracked for values of a given type
+    function isTracked(type)
+    {
+        return type === IRType.box || type.isInt();
+    }
+
+    // Test if a lattice value is a range
+    function isRange(val)
+    {
+        return typeof val === 'object';
+    }
+
+    // Test if two lattice values are equal
+    function valsEqual(v1, v2)
+    {
+        if (v1 === v2)
+            return true;
+
+        if (!isRange(v1) || !isRange(v2))
+            return false;
+
+        return num_eq(v1.min, v2.min) && num_eq(v1.max, v2.max);
+    }
+
+    // Test if a range is contained in the range of a type
+    function inTypeRange(range, type)
+    {
+        var tr = typeRange(type);
+
+        return num_ge(range.min, tr.min) && num_le(range.max, tr.max);
+    }
+
+    // Intersect two ranges, keeping the first if they are disjoint
+    function intersect(r1, r2)
+    {
+        var min = num_gt(r1.min, r2.min)? r1.min:r2.min;
+        var max = num_lt(r1.max, r2.max)? r1.max:r2.max;
+
+        // Disjoint ranges can only occur in dead code
+        if (num_gt(min, max))
+            return r1;
+
+        return { min: min, max: max };
+    }
+
+    // Compute the union of two lattice values for a given type
+    function join(v1, v2)
+    {
+        if (v1 === TOP)
+            return v2;
+        if (v2 === TOP)
+            return v1;
+        if (v1 === BOT || v2 === BOT)
+            return BOT;
+
+        return {
+            min: num_lt(v1.min, v2.min)? v1.min:v2.min,
+            max: num_gt(v1.max, v2.max)? v1.max:v2.max
+        };
+    }
+
+    // Extend the bounds of a range which grew up to the limits of its type
+    function widen(oldRange, newRange, type)
+    {
+        var tr = typeRange(type);
+
+        return {
+            min: num_lt(newRange.min, oldRange.min)? tr.min:newRange.min,
+            max: num_gt(newRange.max, oldRange.max)? tr.max:newRange.max
+        };
+    }
+
+    // Get the negation of a comparison operator
+    function negateOp(op)
+    {
+        switch (op)
+        {
+            case 'LT': return 'GE';
+            case 'LE': return 'GT';
+            case 'GT': return 'LE';
+            case 'GE': return 'LT';
+            case 'EQ': return 'NE';
+            case 'NE': return 'EQ';
+        }
+    }
+
+    // Test if a comparison outcome implies another on the same operands
+    function opImplies(op1, op2)
+    {
+        if (op1 === op2)
+            return true;
+
+        switch (op1)
+        {
+            case 'LT': return op2 === 'LE' || op2 === 'NE';
+            case 'GT': return op2 === 'GE' || op2 === 'NE';
+            case 'EQ': return op2 === 'LE' || op2 === 'GE';
+        }
+
+        return false;
+    }
+
+    // Test if a value is a constant with a given integer value
+    function isConstInt(val, intVal)
+    {
+        return (
+            val instanceof IRConst &&
+            val.isInt() &&
+            num_eq(val.value, intVal)
+        );
+    }
+
+    // Get the comparison operator that holds along a CFG edge, if the
+    // edge is the only one taken when a comparison has a given outcome
+    function edgeOp(branch, succ)
+    {
+        if (!(branch instanceof IfInstr) || 
+            branch.targets[0] === branch.targets[1])
+            return undefined;
+
+        return (succ === branch.targets[0])? 
+               branch.testOp:negateOp(branch.testOp);
+    }
+
+    // Compute the range facts implied by taking a CFG edge
+    function edgeFacts(pred, succ)
+    {
+        var branch = pred.getLastInstr();
+        var op = edgeOp(branch, succ);
+
+        var facts = [];
+
+        if (op === undefined)
+            return facts;
+
+        var a = branch.uses[0];
+        var b = branch.uses[1];
+
+        if (!isTracked(a.type) || !isTracked(b.type))
+            return facts;
+
+        // If this is an integer tag test, the tested value is an integer
+        if (a instanceof AndInstr && 
+            a.uses[0].type === IRType.box &&
+            isConstInt(a.uses[1], TAG_INT_MASK) &&
+            isConstInt(b, TAG_INT) &&
+            op === 'EQ')
+        {
+            facts.push({ val: a.uses[0], range: typeRange(IRType.box) });
+        }
+
+        if (op === 'NE')
+            return facts;
+
+        var ra = getRange(a, pred);
+        var rb = getRange(b, pred);
+
+        if (ra === TOP || rb === TOP)
+            return facts;
+
+        // Relational comparisons of boxed values compare boxed integers
+        if (a.type === IRType.box && op !== 'EQ')
+        {
+            if (ra === BOT)
+                ra = typeRange(IRType.box);
+            if (rb === BOT)
+                rb = typeRange(IRType.box);
+        }
+
+        var na = ra;
+        var nb = rb;
+
+        if (ra === BOT || rb === BOT)
+        {
+            // Equality with a boxed integer implies being that integer
+            if (op === 'EQ')
+                na = nb = (ra === BOT)? rb:ra;
+            else
+                return facts;
+        }
+        else
+        {
+            switch (op)
+            {
+                case 'LT':
+                na = { min: ra.min, max: num_sub(rb.max, 1) };
+                nb = { min: num_add(ra.min, 1), max: rb.max };
+                break;
+
+                case 'LE':
+                na = { min: ra.min, max: rb.max };
+                nb = { min: ra.min, max: rb.max };
+                break;
+
+                case 'GT':
+                na = { min: num_add(rb.min, 1), max: ra.max };
+                nb = { min: rb.min, max: num_sub(ra.max, 1) };
+                break;
+
+                case 'GE':
+                na = { min: rb.min, max: ra.max };
+                nb = { min: rb.min, max: ra.max };
+                break;
+
+                case 'EQ':
+                na = nb = intersect(ra, rb);
+                break;
+            }
+        }
+
+        if (na !== BOT && a instanceof IRInstr)
+            facts.push({ val: a, range: na });
+        if (nb !== BOT && b instanceof IRInstr)
+            facts.push({ val: b, range: nb });
+
+        return facts;
+    }
+
+    // Get the only predecessor from which a block can be entered from
+    // outside of the blocks it dominates, if there is one. This is the
+    // case of single predecessor blocks and of loop headers.
+    function entryPred(block)
+    {
+        if (block === cfg.entry)
+            return null;
+
+        var outerPred = null;
+
+        for (var i = 0; i < block.preds.length; ++i)
+        {
+            var pred = block.preds[i];
+
+            if (blockDominates(idom, block, pred))
+                continue;
+
+            if (outerPred !== null)
+                return null;
+
+            outerPred = pred;
+        }
+
+        return outerPred;
+    }
+
+    // Test if a block is the target of a loop back edge
+    function isLoopHeader(block)
+    {
+        for (var i = 0; i < block.preds.length; ++i)
+            if (blockDominates(idom, block, block.preds[i]))
+                return true;
+
+        return false;
+    }
+
+    // Get the range facts holding on entry to a block, if it can only be
+    // entered through a conditional branch
+    function blockFacts(block)
+    {
+        var facts = factCache[block.blockId];
+
+        if (facts === undefined)
+        {
+            var pred = entryPred(block);
+
+            if (pred !== null)
+                facts = edgeFacts(pred, block);
+            else
+                facts = [];
+
+            factCache[block.blockId] = facts;
+        }
+
+        return facts;
+    }
+
+    // Refine a lattice value using a list of facts
+    function applyFacts(val, range, facts)
+    {
+        for (var i = 0; i < facts.length; ++i)
+        {
+            var fact = facts[i];
+
+            if (fact.val !== val)
+                continue;
+
+            if (range === BOT)
+                range = fact.range;
+            else
+                range = intersect(range, fact.range);
+        }
+
+        return range;
+    }
+
+    // Get the range of a value at the end of a given block
+    function getRange(val, block)
+    {
+        if (val instanceof IRConst)
+        {
+            if (val.type === IRType.box)
+                return val.isBoxInt(params)? { min: val.value, max: val.value }:BOT;
+
+            if (val.type.isInt() && val.isInt())
+                return { min: val.value, max: val.value };
+
+            return BOT;
+        }
+
+        if (!(val instanceof IRInstr) || !isTracked(val.type))
+            return BOT;
+
+        var range = instrVals[val.instrId];
+
+        if (range === TOP)
+            return TOP;
+
+        if (range === BOT && val.type !== IRType.box)
+            range = typeRange(val.type);
+
+        // Refine the range using the branches dominating the block
+        for (var b = block;; b = idom[b.blockId])
+        {
+            range = applyFacts(val, range, blockFacts(b));
+
+            if (b === val.parentBlock || b === cfg.entry || 
+                idom[b.blockId] === undefined)
+                break;
+        }
+
+        return range;
+    }
+
+    // Test if a CFG edge was found to be reachable
+    function edgeReachable(pred, succ)
+    {
+        return edgeVisited[pred.blockId][succ.blockId] === true;
+    }
+
+    // Mark a CFG edge as reachable
+    function markEdge(pred, succ)
+    {
+        if (edgeVisited[pred.blockId][succ.blockId] !== true)
+        {
+            edgeVisited[pred.blockId][succ.blockId] = true;
+            reachable[succ.blockId] = true;
+            changed = true;
+        }
+    }
+
+    // Get the outcome of a comparison already made by a dominating branch
+    function dominatingTest(instr)
+    {
+        // Floating-point comparisons may be false both ways
+        if (!isTracked(instr.uses[0].type))
+            return BOT;
+
+        for (var b = instr.parentBlock;; b = idom[b.blockId])
+        {
+            var pred = entryPred(b);
+
+            if (pred !== null)
+            {
+                var branch = pred.getLastInstr();
+                var op = edgeOp(branch, b);
+
+                if (op !== undefined &&
+                    branch !== instr &&
+                    branch.uses[0] === instr.uses[0] &&
+                    branch.uses[1] === instr.uses[1])
+                {
+                    if (opImplies(op, instr.testOp))
+                        return true;
+                    if (opImplies(op, negateOp(instr.testOp)))
+                        return false;
+                }
+            }
+
+            if (b === cfg.entry || idom[b.blockId] === undefined)
+                break;
+        }
+
+        return BOT;
+    }
+
+    // Evaluate a comparison from the operand ranges
+    function evalTest(instr, block)
+    {
+        var a = instr.uses[0];
+        var b = instr.uses[1];
+
+        var testVal = dominatingTest(instr);
+
+        if (testVal !== BOT)
+            return testVal;
+
+        if (!isTracked(a.type) || !isTracked(b.type))
+            return BOT;
+
+        var ra = getRange(a, block);
+        var rb = getRange(b, block);
+
+        if (ra === TOP || rb === TOP)
+            return TOP;
+
+        if (ra === BOT || rb === BOT)
+            return BOT;
+
+        switch (instr.testOp)
+        {
+            case 'LT':
+            if (num_lt(ra.max, rb.min)) return true;
+            if (num_ge(ra.min, rb.max)) return false;
+            break;
+
+            case 'LE':
+            if (num_le(ra.max, rb.min)) return true;
+            if (num_gt(ra.min, rb.max)) return false;
+            break;
+
+            case 'GT':
+            if (num_gt(ra.min, rb.max)) return true;
+            if (num_le(ra.max, rb.min)) return false;
+            break;
+
+            case 'GE':
+            if (num_ge(ra.min, rb.max)) return true;
+            if (num_lt(ra.max, rb.min)) return false;
+            break;
+
+            case 'EQ':
+            case 'NE':
+            var eq = BOT;
+            if (num_eq(ra.min, ra.max) && num_eq(rb.min, rb.max) &&
+                num_eq(ra.min, rb.min))
+                eq = true;
+            else if (num_lt(ra.max, rb.min) || num_gt(ra.min, rb.max))
+                eq = false;
+            if (eq !== BOT)
+                return (instr.testOp === 'EQ')? eq:!eq;
+            break;
+        }
+
+        return BOT;
+    }
+
+    // Compute the exact range of an arithmetic operation on two ranges
+    function arithRange(instr, ra, rb)
+    {
+        if (instr instanceof AddInstr || instr instanceof AddOvfInstr)
+        {
+            return {
+                min: num_add(ra.min, rb.min),
+                max: num_add(ra.max, rb.max)
+            };
+        }
+
+        if (instr instanceof SubInstr || instr instanceof SubOvfInstr)
+        {
+            return {
+                min: num_sub(ra.min, rb.max),
+                max: num_sub(ra.max, rb.min)
+            };
+        }
+
+        if (instr instanceof MulInstr || instr instanceof MulOvfInstr)
+        {
+            var p = [
+                num_mul(ra.min, rb.min),
+                num_mul(ra.min, rb.max),
+                num_mul(ra.max, rb.min),
+                num_mul(ra.max, rb.max)
+            ];
+
+            var range = { min: p[0], max: p[0] };
+            for (var i = 1; i < p.length; ++i)
+                range = join(range, { min: p[i], max: p[i] });
+
+            return range;
+        }
+
+        return BOT;
+    }
+
+    // Test if an integer value has the bit pattern of a boxed integer
+    function isTagged(val, block)
+    {
+        if (!(val instanceof IRInstr))
+            return false;
+
+        // Boxed integers cast to integers
+        if (val instanceof ICastInstr && val.uses[0].type === IRType.box)
+            return isRange(getRange(val.uses[0], block));
+
+        // Products of tagged integers with untagged ones
+        if (val instanceof MulInstr || val instanceof MulOvfInstr)
+        {
+            return (
+                isTagged(val.uses[0], block) && !isTagged(val.uses[1], block) ||
+                isTagged(val.uses[1], block) && !isTagged(val.uses[0], block)
+            );
+        }
+
+        return false;
+    }
+
+    // Evaluate the range of an instruction in a given block
+    function evalInstr(instr, block)
+    {
+        if (instr instanceof PhiInstr)
+        {
+            var val = TOP;
+
+            for (var i = 0; i < instr.preds.length; ++i)
+            {
+                var pred = instr.preds[i];
+
+                if (!edgeReachable(pred, block))
+                    continue;
+
+                var use = instr.uses[i];
+                var useVal = getRange(use, pred);
+
+                if (useVal !== TOP && use instanceof IRInstr)
+                    useVal = applyFacts(use, useVal, edgeFacts(pred, block));
+
+                val = join(val, useVal);
+            }
+
+            if (instr.type !== IRType.box && val === BOT)
+                val = typeRange(instr.type);
+
+            return val;
+        }
+
+        if (instr instanceof IfInstr)
+        {
+            var testVal = evalTest(instr, block);
+
+            if (testVal === true || testVal === BOT)
+                markEdge(block, instr.targets[0]);
+            if (testVal === false || testVal === BOT)
+                markEdge(block, instr.targets[1]);
+
+            return testVal;
+        }
+
+        if (instr instanceof ArithOvfInstr)
+        {
+            var ra = getRange(instr.uses[0], block);
+            var rb = getRange(instr.uses[1], block);
+
+            if (ra === TOP || rb === TOP)
+                return TOP;
+
+            // Operands of overflow checks on boxed values are integers
+            if (ra === BOT)
+                ra = typeRange(instr.type);
+            if (rb === BOT)
+                rb = typeRange(instr.type);
+
+            var range = arithRange(instr, ra, rb);
+
+            if (range !== BOT && inTypeRange(range, instr.type))
+            {
+                markEdge(block, instr.targets[0]);
+                return range;
+            }
+
+            markEdge(block, instr.targets[0]);
+            markEdge(block, instr.targets[1]);
+
+            return (range === BOT)? typeRange(instr.type):
+                   intersect(typeRange(instr.type), range);
+        }
+
+        // Any other branch may go to all of its targets
+        if (instr.isBranch())
+        {
+            for (var i = 0; i < instr.targets.length; ++i)
+                if (instr.targets[i])
+                    markEdge(block, instr.targets[i]);
+        }
+
+        if (!isTracked(instr.type))
+            return BOT;
+
+        // Casting a tagged integer value gives a boxed integer
+        if (instr instanceof ICastInstr && instr.type === IRType.box)
+        {
+            var use = instr.uses[0];
+
+            if (!use.type.isInt() || !isTagged(use, instr.parentBlock))
+                return BOT;
+
+            var ra = getRange(use, instr.parentBlock);
+
+            if (ra === TOP)
+                return TOP;
+
+            return {
+                min: num_shift(ra.min, -TAG_NUM_BITS_INT),
+                max: num_shift(ra.max, -TAG_NUM_BITS_INT)
+            };
+        }
+
+        if (instr.type === IRType.box)
+            return BOT;
+
+        var fullRange = typeRange(instr.type);
+
+        if (instr instanceof ArithInstr && instr.uses[0].type === instr.type)
+        {
+            var ra = getRange(instr.uses[0], instr.parentBlock);
+            var rb = getRange(instr.uses[1], instr.parentBlock);
+
+            if (ra === TOP || rb === TOP)
+                return TOP;
+
+            var range = arithRange(instr, ra, rb);
+
+            if (range !== BOT && inTypeRange(range, instr.type))
+                return range;
+
+            return fullRange;
+        }
+
+        if (instr instanceof AndInstr)
+        {
+            var ra = getRange(instr.uses[0], instr.parentBlock);
+            var rb = getRange(instr.uses[1], instr.parentBlock);
+
+            if (ra === TOP || rb === TOP)
+                return TOP;
+
+            // Masking the tag bits of a boxed integer gives the integer tag
+            if (instr.uses[0].type === IRType.box && 
+                isConstInt(instr.uses[1], TAG_INT_MASK))
+            {
+                if (ra !== BOT)
+                    return { min: TAG_INT, max: TAG_INT };
+                return { min: 0, max: TAG_INT_MASK };
+            }
+
+            // The bitwise and of non-negative values is bounded by both
+            if (instr.uses[0].type === IRType.box)
+                ra = BOT;
+            var range = fullRange;
+            if (ra !== BOT && num_nonneg(ra.min))
+                range = intersect(range, { min: 0, max: ra.max });
+            if (rb !== BOT && num_nonneg(rb.min))
+                range = intersect(range, { min: 0, max: rb.max });
+
+            return range;
+        }
+
+        if ((instr instanceof RsftInstr || instr instanceof LsftInstr ||
+             instr instanceof UrsftInstr) &&
+            instr.uses[1] instanceof IRConst &&
+            typeof instr.uses[1].value === 'number')
+        {
+            var ra = getRange(instr.uses[0], instr.parentBlock);
+            var shift = instr.uses[1].value;
+
+            if (ra === TOP)
+                return TOP;
+
+            if (shift < 0 || shift >= instr.type.getSizeBits(params))
+                return fullRange;
+
+            if (instr instanceof UrsftInstr && !num_nonneg(ra.min))
+                return fullRange;
+
+            if (instr instanceof LsftInstr)
+                shift = -shift;
+
+            var range = {
+                min: num_shift(ra.min, -shift),
+                max: num_shift(ra.max, -shift)
+            };
+
+            if (inTypeRange(range, instr.type))
+                return range;
+
+            return fullRange;
+        }
+
+        if (instr instanceof ICastInstr)
+        {
+            var use = instr.uses[0];
+
+            if (!isTracked(use.type))
+                return fullRange;
+
+            var ra = getRange(use, instr.parentBlock);
+
+            if (ra === TOP)
+                return TOP;
+
+            if (ra === BOT)
+                return fullRange;
+
+            // Casting a boxed integer exposes its tag bits
+            if (use.type === IRType.box)
+            {
+                ra = {
+                    min: num_shift(ra.min, TAG_NUM_BITS_INT),
+                    max: num_shift(ra.max, TAG_NUM_BITS_INT)
+                };
+            }
+
+            if (inTypeRange(ra, instr.type))
+                return ra;
+
+            return fullRange;
+        }
+
+        return fullRange;
+    }
+
+    var TAG_INT_MASK = params.staticEnv.getValue('TAG_INT_MASK');
+    var TAG_INT = params.staticEnv.getValue('TAG_INT');
+    var TAG_NUM_BITS_INT = params.staticEnv.getValue('TAG_NUM_BITS_INT');
+
+    var doms = computeDoms(cfg);
+    var idom = doms.idom;
+    var rpo = doms.rpo;
+
+    // Reachable blocks, indexed by block id
+    var reachable = [];
+
+    // Visited edges, indexed by predecessor id, successor id
+    var edgeVisited = [];
+
+    // Instruction values, indexed by instr id
+    var instrVals = [];
+
+    // Number of times each phi node range has grown, indexed by instr id
+    var phiChanges = [];
+
+    // Range facts holding on entry to blocks, indexed by block id
+    var factCache;
+
+    // Flag indicating that the analysis state changed
+    var changed;
+
+    for (var itr = cfg.getBlockItr(); itr.valid(); itr.next())
+        edgeVisited[itr.get().blockId] = [];
+
+    for (var itr = cfg.getInstrItr(); itr.valid(); itr.next())
+        instrVals[itr.get().instrId] = TOP;
+
+    reachable[cfg.entry.blockId] = true;
+
+    // Iterate over the reachable blocks until a fixed point is reached
+    for (var numPasses = 0;; ++numPasses)
+    {
+        // If the analysis does not converge, leave the CFG unchanged
+        if (numPasses >= MAX_PASSES)
+            return;
+
+        changed = false;
+        factCache = [];
+
+        for (var i = 0; i < rpo.length; ++i)
+        {
+            var block = rpo[i];
+
+            if (reachable[block.blockId] !== true)
+                continue;
+
+            for (var j = 0; j < block.instrs.length; ++j)
+            {
+                var instr = block.instrs[j];
+
+                var oldVal = instrVals[instr.instrId];
+                var newVal = evalInstr(instr, block);
+
+                if (instr instanceof PhiInstr)
+                {
+                    newVal = join(oldVal, newVal);
+
+                    // Widen the bounds of loop phi nodes which keep growing
+                    if (isRange(oldVal) && isRange(newVal) &&
+                        !valsEqual(oldVal, newVal) &&
+                        isLoopHeader(block))
+                    {
+                        var numChanges = (phiChanges[instr.instrId] || 0) + 1;
+                        phiChanges[instr.instrId] = numChanges;
+
+                        if (numChanges > MAX_PHI_CHANGES)
+                            newVal = widen(oldVal, newVal, instr.type);
+                    }
+                }
+
+                if (!valsEqual(oldVal, newVal))
+                {
+                    instrVals[instr.instrId] = newVal;
+                    changed = true;
+                }
+            }
+        }
+
+        if (changed === false)
+            break;
+    }
+
+    // For each reachable block
+    for (var i = 0; i < rpo.length; ++i)
+    {
+        var block = rpo[i];
+
+        if (reachable[block.blockId] !== true)
+            continue;
+
+        var j = block.instrs.length - 1;
+        var instr = block.instrs[j];
+
+        // If only one branch of a comparison is reachable, replace
+        // the comparison by a jump
+        if (instr instanceof IfInstr)
+        {
+            var val = instrVals[instr.instrId];
+
+            if (val === true || val === false)
+            {
+                var target = instr.targets[(val === true)? 0:1];
+                block.replInstrAtIndex(j, new JumpInstr(target));
+            }
+        }
+
+        // If an arithmetic operation cannot overflow, remove its
+        // overflow check
+        else if (instr instanceof ArithOvfInstr &&
+                 instr.targets[0] !== instr.targets[1] &&
+                 !edgeReachable(block, instr.targets[1]))
+        {
+            var arithInstr;
+            if (instr instanceof AddOvfInstr)
+                arithInstr = new AddInstr(instr.uses[0], instr.uses[1]);
+            else if (instr instanceof SubOvfInstr)
+                arithInstr = new SubInstr(instr.uses[0], instr.uses[1]);
+            else if (instr instanceof MulOvfInstr)
+                arithInstr = new MulInstr(instr.uses[0], instr.uses[1]);
+            else
+                continue;
+
+            block.addInstr(arithInstr, instr.outName, j);
+            block.replInstrAtIndex(
+                j + 1, 
+                new JumpInstr(instr.targets[0]), 
+                arithInstr
+            );
+        }
+    }
+
+    // Remove basic blocks which are now unreachable from the CFG
+    cfg.remDeadBlocks();
+}
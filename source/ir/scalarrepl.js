@@ -0,0 +1,544 @@
+/* _________________________________________________________________________
+ *
+ *             Tachyon : A Self-Hosted JavaScript Virtual Machine
+ *
+ *
+ *  This file is part of the Tachyon JavaScript project. Tachyon is
+ *  distributed at:
+ *  http://github.com/Tachyon-Team/Tachyon
+ *
+ *
+ *  Copyright (c) 2011, Universite de Montreal
+ *  All rights reserved.
+ *
+ *  This software is licensed under the following license (Modified BSD
+ *  License):
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the Universite de Montreal nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL UNIVERSITE DE
+ *  MONTREAL BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * _________________________________________________________________________
+ */
+
+/**
+@fileOverview
+Escape analysis and scalar replacement of objects. Objects allocated in a
+function which do not escape it have their properties replaced by SSA values.
+*/
+
+//=============================================================================
+//
+// Implementation of scalar replacement
+//
+// Object literal allocations are the candidates. A use of an object which
+// reads or writes a property with a constant string name, through the getProp
+// and putProp primitives, is an access. Any other use, such as passing the
+// object to a call, storing it or returning it, is an escape point. Since
+// this pass runs after inlining, objects only passed to inlined callees are
+// accessed directly.
+//
+// An object is replaced if no access or other escape point is reachable from
+// its escape points without going through its allocation again. The object is
+// then only allocated, and its properties written, right before the escape
+// points. This covers objects passed to the slow path of guarded inlined
+// calls. Objects merged by phi nodes are left alone.
+//
+// The property values are rebuilt in SSA form by walking the CFG backwards
+// from each read to the nearest write or to the allocation, placing phi nodes
+// at merge points. If a read may see a property which was never written, it
+// would have to be looked up on the prototype chain, and the object is left
+// alone.
+//
+//=============================================================================
+
+/**
+Perform scalar replacement of non-escaping objects on a CFG
+*/
+function scalarRepl(cfg, params)
+{
+    assert (
+        params instanceof CompParams,
+        'expected compilation parameters'
+    );
+
+    var allocFunc = params.staticEnv.getBinding('blankObject');
+    var getFunc = params.staticEnv.getBinding('getProp');
+    var putFunc = params.staticEnv.getBinding('putProp');
+
+    // Value read for a property which was not written
+    const ABSENT = {};
+
+    /**
+    Test if an instruction is a call to a given primitive
+    */
+    function isCallTo(instr, func)
+    {
+        return (
+            instr instanceof CallFuncInstr &&
+            instr.getCallee() === func
+        );
+    }
+
+    /**
+    Get the property name accessed by a use of an object, or undefined
+    if the use is an escape point
+    */
+    function getAccessName(obj, instr)
+    {
+        if (!isCallTo(instr, getFunc) && !isCallTo(instr, putFunc))
+            return undefined;
+
+        var propName = instr.getArg(1);
+
+        if (!(propName instanceof IRConst) ||
+            typeof propName.value !== 'string')
+            return undefined;
+
+        // The object must only be used as the object operand
+        for (var i = 0; i < instr.uses.length; ++i)
+            if (instr.uses[i] === obj && i !== 3)
+                return undefined;
+
+        return propName.value;
+    }
+
+    /**
+    Test if a use of an object is reachable from an escape point
+    without going through the object allocation
+    */
+    function useAfterEscape(obj, escInstr)
+    {
+        var block = escInstr.parentBlock;
+        var index = block.instrs.indexOf(escInstr);
+
+        var visited = [];
+        var workList = [];
+
+        /**
+        Scan a block from an index, queuing its successors
+        */
+        function scan(block, index)
+        {
+            for (var i = index; i < block.instrs.length; ++i)
+            {
+                var instr = block.instrs[i];
+
+                if (instr === obj)
+                    return false;
+
+                if (arraySetHas(instr.uses, obj))
+                    return true;
+            }
+
+            for (var i = 0; i < block.succs.length; ++i)
+            {
+                var succ = block.succs[i];
+
+                if (!arraySetHas(visited, succ))
+                {
+                    visited.push(succ);
+                    workList.push(succ);
+                }
+            }
+
+            return false;
+        }
+
+        if (scan(block, index + 1) === true)
+            return true;
+
+        while (workList.length > 0)
+            if (scan(workList.pop(), 0) === true)
+                return true;
+
+        return false;
+    }
+
+    /**
+    Try to replace the properties of an allocated object by SSA values
+    */
+    function replaceObj(obj)
+    {
+        // Property names used, reads and escape points of the object
+        var propNames = [];
+        var reads = [];
+        var escapes = [];
+
+        for (var i = 0; i < obj.dests.length; ++i)
+        {
+            var dest = obj.dests[i];
+
+            if (dest instanceof PhiInstr)
+                return false;
+
+            var propName = getAccessName(obj, dest);
+
+            if (propName === undefined)
+            {
+                escapes.push(dest);
+                continue;
+            }
+
+            arraySetAdd(propNames, propName);
+
+            if (isCallTo(dest, getFunc))
+                reads.push(dest);
+        }
+
+        // If the object is never read and only escapes in the block where
+        // it is allocated, there is nothing to gain
+        if (reads.length === 0 &&
+            escapes.every(function (e) { return e.parentBlock === obj.parentBlock; }))
+            return false;
+
+        // The object must not be used after it escapes
+        for (var i = 0; i < escapes.length; ++i)
+            if (useAfterEscape(obj, escapes[i]) === true)
+                return false;
+
+        // Phi nodes created, and the value of each property at block entries
+        var phis = [];
+        var entryVals = {};
+
+        /**
+        Get the value of a property before the instruction at some index
+        */
+        function readBefore(propName, block, index)
+        {
+            for (var i = index - 1; i >= 0; --i)
+            {
+                var instr = block.instrs[i];
+
+                if (instr === obj)
+                    return ABSENT;
+
+                if (isCallTo(instr, putFunc) &&
+                    instr.getArg(0) === obj &&
+                    instr.getArg(1).value === propName)
+                    return instr.getArg(2);
+            }
+
+            return readEntry(propName, block);
+        }
+
+        /**
+        Get the value of a property at the entry of a block
+        */
+        function readEntry(propName, block)
+        {
+            var key = propName + '@' + block.blockId;
+
+            if (entryVals[key] !== undefined)
+                return entryVals[key];
+
+            // The allocation dominates all uses, so the entry block
+            // is never reached
+            assert (
+                block.preds.length > 0,
+                'object allocation does not dominate use'
+            );
+
+            if (block.preds.length === 1)
+            {
+                var pred = block.preds[0];
+                var val = readBefore(propName, pred, pred.instrs.length);
+                entryVals[key] = val;
+                return val;
+            }
+
+            // Create a phi node, recorded before its inputs are read so
+            // that loops terminate
+            var phi = new PhiInstr([], []);
+            phi.outName = propName;
+            phi.block = block;
+            phis.push(phi);
+            entryVals[key] = phi;
+
+            for (var i = 0; i < block.preds.length; ++i)
+            {
+                var pred = block.preds[i];
+                phi.uses.push(readBefore(propName, pred, pred.instrs.length));
+                phi.preds.push(pred);
+            }
+
+            return phi;
+        }
+
+        /**
+        Get the value of a property before an instruction
+        */
+        function readAt(propName, instr)
+        {
+            var block = instr.parentBlock;
+            var index = block.instrs.indexOf(instr);
+
+            return readBefore(propName, block, index);
+        }
+
+        // Value of each read
+        var readVals = reads.map(
+            function (instr)
+            {
+                return readAt(instr.getArg(1).value, instr);
+            }
+        );
+
+        // Value of each property at each escape point
+        var escVals = escapes.map(
+            function (instr)
+            {
+                return propNames.map(
+                    function (propName)
+                    {
+                        return readAt(propName, instr);
+                    }
+                );
+            }
+        );
+
+        // Replacement values for the phi nodes found to be trivial
+        var phiRepl = [];
+
+        /**
+        Get the final value of a property read or phi node
+        */
+        function resolve(val)
+        {
+            for (;;)
+            {
+                if (val instanceof PhiInstr && 
+                    phiRepl[phis.indexOf(val)] !== undefined)
+                    val = phiRepl[phis.indexOf(val)];
+                else if (reads.indexOf(val) !== -1)
+                    val = readVals[reads.indexOf(val)];
+                else
+                    return val;
+            }
+        }
+
+        // Remove the phi nodes which merge a single value
+        for (var changed = true; changed === true;)
+        {
+            changed = false;
+
+            for (var i = 0; i < phis.length; ++i)
+            {
+                if (phiRepl[i] !== undefined)
+                    continue;
+
+                var phi = phis[i];
+                var single = undefined;
+
+                for (var j = 0; j < phi.uses.length; ++j)
+                {
+                    var val = resolve(phi.uses[j]);
+
+                    if (val === phi || val === single)
+                        continue;
+
+                    single = (single === undefined)? val:null;
+                }
+
+                if (single !== null && single !== undefined)
+                {
+                    phiRepl[i] = single;
+                    changed = true;
+                }
+            }
+        }
+
+        // Find the phi nodes which may merge an absent property
+        var mayBeAbsent = [];
+        for (var changed = true; changed === true;)
+        {
+            changed = false;
+
+            for (var i = 0; i < phis.length; ++i)
+            {
+                if (phiRepl[i] !== undefined || mayBeAbsent[i] === true)
+                    continue;
+
+                for (var j = 0; j < phis[i].uses.length; ++j)
+                {
+                    var val = resolve(phis[i].uses[j]);
+
+                    if (val === ABSENT || 
+                        (val instanceof PhiInstr && 
+                         mayBeAbsent[phis.indexOf(val)] === true))
+                    {
+                        mayBeAbsent[i] = true;
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        /**
+        Test if a value may be that of a property which was not written
+        */
+        function isAbsent(val)
+        {
+            val = resolve(val);
+
+            return (
+                val === ABSENT ||
+                (val instanceof PhiInstr && 
+                 mayBeAbsent[phis.indexOf(val)] === true)
+            );
+        }
+
+        // If a read may see an absent property, the object is not replaced
+        for (var i = 0; i < readVals.length; ++i)
+            if (isAbsent(readVals[i]))
+                return false;
+
+        // The properties must be known to be present or absent at the
+        // escape points, where the object is allocated
+        for (var i = 0; i < escVals.length; ++i)
+        {
+            for (var j = 0; j < propNames.length; ++j)
+            {
+                var val = resolve(escVals[i][j]);
+
+                if (val !== ABSENT && isAbsent(val))
+                    return false;
+            }
+        }
+
+        // Add the phi nodes which are still needed
+        for (var i = 0; i < phis.length; ++i)
+        {
+            if (phiRepl[i] !== undefined)
+                continue;
+
+            var phi = phis[i];
+
+            phi.uses = phi.uses.map(resolve);
+            phi.type = IRType.box;
+
+            phi.block.addInstr(phi, phi.outName, 0);
+            delete phi.block;
+        }
+
+        // Allocate the object and write its properties at the escape points
+        for (var i = 0; i < escapes.length; ++i)
+        {
+            var instr = escapes[i];
+            var block = instr.parentBlock;
+            var index = block.instrs.indexOf(instr);
+
+            var newObj = block.addInstr(
+                new CallFuncInstr(
+                    [
+                        allocFunc,
+                        IRConst.getConst(undefined),
+                        IRConst.getConst(undefined)
+                    ]
+                ),
+                obj.outName,
+                index++
+            );
+
+            for (var j = 0; j < propNames.length; ++j)
+            {
+                var val = resolve(escVals[i][j]);
+
+                if (val === ABSENT)
+                    continue;
+
+                block.addInstr(
+                    new CallFuncInstr(
+                        [
+                            putFunc,
+                            IRConst.getConst(undefined),
+                            IRConst.getConst(undefined),
+                            newObj,
+                            IRConst.getConst(propNames[j]),
+                            val
+                        ]
+                    ),
+                    undefined,
+                    index++
+                );
+            }
+
+            instr.replUse(obj, newObj);
+            newObj.addDest(instr);
+            obj.remDest(instr);
+        }
+
+        // Replace the reads and writes, then remove the allocation
+        var accesses = obj.dests.slice(0);
+        for (var i = 0; i < accesses.length; ++i)
+        {
+            var instr = accesses[i];
+
+            var replVal = isCallTo(instr, getFunc)?
+                resolve(instr):resolve(instr.getArg(2));
+
+            removeCall(instr, replVal);
+        }
+
+        removeCall(obj, IRConst.getConst(undefined));
+
+        return true;
+    }
+
+    /**
+    Remove a call instruction, replacing its value
+    */
+    function removeCall(instr, replVal)
+    {
+        var block = instr.parentBlock;
+        var index = block.instrs.indexOf(instr);
+
+        block.replInstrAtIndex(
+            index,
+            instr.isBranch()? new JumpInstr(instr.getContTarget()):undefined,
+            replVal
+        );
+    }
+
+    // Find the object allocations
+    var allocs = [];
+    for (var itr = cfg.getInstrItr(); itr.valid(); itr.next())
+    {
+        var instr = itr.get();
+
+        if (isCallTo(instr, allocFunc))
+            allocs.push(instr);
+    }
+
+    var numReplaced = 0;
+
+    // Try to replace each object
+    for (var i = 0; i < allocs.length; ++i)
+        if (replaceObj(allocs[i]) === true)
+            numReplaced++;
+
+    // Remove the exception handlers which are no longer reachable
+    if (numReplaced > 0)
+        cfg.remDeadBlocks();
+}
+
@@ -756,3 +756,200 @@ tests.ir.inliningThrow = function ()
     ir.validate();
 };
 
+
+/**
+Loop-invariant code motion
+*/
+tests.ir.licm = function ()
+{
+    var ir = tests.ir.helpers.testSource(
+        "                                               \
+            function foo(a, n)                          \
+            {                                           \
+                'tachyon:static';                       \
+                'tachyon:arg a pint';                   \
+                'tachyon:arg n pint';                   \
+                'tachyon:ret pint';                     \
+                                                        \
+                var sum = pint(0);                      \
+                for (var i = pint(0); i < n; i++)       \
+                    sum += (a*pint(3)) ^ (pint(3)*a);   \
+                                                        \
+                return sum;                             \
+            }                                           \
+        ",
+        false,
+        true
+    );
+
+    // Find the multiplications computing the invariant value
+    var mulInstrs = [];
+    tests.ir.helpers.forEachInstr(
+        ir,
+        function (instr)
+        {
+            if (instr instanceof MulInstr)
+                mulInstrs.push(instr);
+        }
+    );
+
+    assert (
+        mulInstrs.length === 1,
+        'commutative multiplications not value numbered'
+    );
+
+    // Test if the block of the multiplication is part of a cycle
+    var mulBlock = mulInstrs[0].parentBlock;
+    var visited = [];
+    var work = mulBlock.succs.slice(0);
+    while (work.length > 0)
+    {
+        var block = work.pop();
+
+        assert (
+            block !== mulBlock,
+            'loop-invariant multiplication not hoisted'
+        );
+
+        if (visited[block.blockId] === true)
+            continue;
+
+        visited[block.blockId] = true;
+        work = work.concat(block.succs);
+    }
+};
+
+/**
+Hoisting of loads out of loops containing stores and calls
+*/
+tests.ir.licmLoads = function ()
+{
+    var ir = tests.ir.helpers.testSource(
+        "                                                       \
+            function foo(o, n)                                  \
+            {                                                   \
+                'tachyon:static';                               \
+                'tachyon:noglobal';                             \
+                'tachyon:arg o ref';                            \
+                'tachyon:arg n pint';                           \
+                'tachyon:ret pint';                             \
+                                                                \
+                var sum = pint(0);                              \
+                var i = pint(0);                                \
+                do                                              \
+                {                                               \
+                    sum += iir.load(IRType.pint, o, pint(8));   \
+                    sum += iir.load(IRType.pint, o, pint(16));  \
+                    iir.store(IRType.pint, o, pint(16), sum);   \
+                    if (ptrInHeap(iir.icast(IRType.rptr, o)))   \
+                        sum += pint(1);                         \
+                } while (++i < n);                              \
+                                                                \
+                return sum;                                     \
+            }                                                   \
+        ",
+        false,
+        true
+    );
+
+    // Test if a block is part of a cycle
+    function inLoop(block)
+    {
+        var visited = [];
+        var work = block.succs.slice(0);
+        while (work.length > 0)
+        {
+            var succ = work.pop();
+
+            if (succ === block)
+                return true;
+
+            if (visited[succ.blockId] === true)
+                continue;
+
+            visited[succ.blockId] = true;
+            work = work.concat(succ.succs);
+        }
+
+        return false;
+    }
+
+    var numLoads = 0;
+    tests.ir.helpers.forEachInstr(
+        ir,
+        function (instr)
+        {
+            if (!(instr instanceof LoadInstr))
+                return;
+
+            ++numLoads;
+
+            var offset = instr.uses[1].value;
+
+            assert (
+                offset !== 8 || inLoop(instr.parentBlock) === false,
+                'load not aliased by the loop stores not hoisted'
+            );
+
+            assert (
+                offset !== 16 || inLoop(instr.parentBlock) === true,
+                'load aliased by a loop store was hoisted'
+            );
+        }
+    );
+
+    assert (
+        numLoads === 2,
+        'unexpected number of loads'
+    );
+};
+
+/**
+Test the scalar replacement of non-escaping object literals
+*/
+tests.ir.scalarRepl = function ()
+{
+    var ir = tests.ir.helpers.testSource(
+        "                                               \
+            function foo(a, b)                          \
+            {                                           \
+                var o = { x: a, y: b };                 \
+                return o.x + o.y;                       \
+            }                                           \
+            function bar(a)                             \
+            {                                           \
+                var o = { x: a };                       \
+                return o;                               \
+            }                                           \
+        "
+    );
+
+    // Count the object allocation calls in a given function
+    function countAllocs(func)
+    {
+        var count = 0;
+
+        for (var it = func.lirCFG.getInstrItr(); it.valid(); it.next())
+        {
+            var instr = it.get();
+
+            if (instr instanceof CallFuncInstr &&
+                instr.uses[0] instanceof IRFunction &&
+                (instr.uses[0].funcName === 'blankObject' ||
+                 instr.uses[0].funcName === 'newObject'))
+                ++count;
+        }
+
+        return count;
+    }
+
+    assert (
+        countAllocs(ir.getChild('foo')) === 0,
+        'non-escaping object literal not scalar replaced'
+    );
+
+    assert (
+        countAllocs(ir.getChild('bar')) > 0,
+        'escaping object literal was scalar replaced'
+    );
+};
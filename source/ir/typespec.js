@@ -0,0 +1,420 @@
+/* _________________________________________________________________________
+ *
+ *             Tachyon : A Self-Hosted JavaScript Virtual Machine
+ *
+ *
+ *  This file is part of the Tachyon JavaScript project. Tachyon is
+ *  distributed at:
+ *  http://github.com/Tachyon-Team/Tachyon
+ *
+ *
+ *  Copyright (c) 2011, Universite de Montreal
+ *  All rights reserved.
+ *
+ *  This software is licensed under the following license (Modified BSD
+ *  License):
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the Universite de Montreal nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL UNIVERSITE DE
+ *  MONTREAL BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * _________________________________________________________________________
+ */
+
+/**
+@fileOverview
+Static type specialization of HIR arithmetic, comparison, property access
+and call instructions, driven by the results of a whole-program type
+analysis run before lowering.
+
+The operand type sets the analysis infers for each site are attached to
+the HIR instructions. When lowering, sites whose operands are proven to
+have the types a fast path handles call an inlined specialized primitive
+instead of the generic one. Type tests are omitted for the operands the
+analysis proves, and integers whose range is bounded by the analysis are
+known to be immediate integers. Tests which cannot be proven are kept,
+and execution falls back to the generic primitive when they fail, as do
+integer overflows. Calls whose callee is proven to be a single top-level
+function are inlined by the guarded call inliner.
+*/
+
+/**
+@class Static type specialization driven by a type analysis
+*/
+function TypeSpec(analysis)
+{
+    assert (
+        analysis instanceof TypeAnalysis,
+        'expected type analysis'
+    );
+
+    /**
+    @field Type analysis providing the type sets
+    */
+    this.analysis = analysis;
+
+    /**
+    @field Number of specialized sites compiled with and without type tests
+    */
+    this.numGuarded = 0;
+    this.numProven = 0;
+
+    /**
+    @field Number of call sites with a known callee
+    */
+    this.numCallees = 0;
+}
+
+/**
+Specialization site kinds. Each kind names the HIR instruction class, the
+generic primitive, the type flags its fast path expects for each operand
+and the source of the fast path, with v1 and v2 as the operands.
+*/
+TypeSpec.siteKinds = [
+
+    {
+        instrClass: JSAddInstr,
+        prim: 'add',
+        flags: [TypeFlags.INT, TypeFlags.INT],
+        fastPath: '                                         \
+            var r;                                          \
+            if (r = iir.add_ovf(v1, v2))                    \
+                return r;'
+    },
+
+    {
+        instrClass: JSSubInstr,
+        prim: 'sub',
+        flags: [TypeFlags.INT, TypeFlags.INT],
+        fastPath: '                                         \
+            var r;                                          \
+            if (r = iir.sub_ovf(v1, v2))                    \
+                return r;'
+    },
+
+    {
+        instrClass: JSMulInstr,
+        prim: 'mul',
+        flags: [TypeFlags.INT, TypeFlags.INT],
+        fastPath: '                                         \
+            var i1 = iir.icast(IRType.pint, v1);            \
+            i1 = i1 >> TAG_NUM_BITS_INT;                    \
+            var i2 = iir.icast(IRType.pint, v2);            \
+            var r;                                          \
+            if (r = iir.mul_ovf(i1, i2))                    \
+                return iir.icast(IRType.box, r);'
+    },
+
+    {
+        instrClass: JSLtInstr,
+        prim: 'lt',
+        flags: [TypeFlags.INT, TypeFlags.INT],
+        fastPath: '                                         \
+            if (iir.if_lt(v1, v2))                          \
+                return true;                                \
+            else                                            \
+                return false;'
+    },
+
+    {
+        instrClass: JSLeInstr,
+        prim: 'le',
+        flags: [TypeFlags.INT, TypeFlags.INT],
+        fastPath: '                                         \
+            if (iir.if_le(v1, v2))                          \
+                return true;                                \
+            else                                            \
+                return false;'
+    },
+
+    {
+        instrClass: JSGtInstr,
+        prim: 'gt',
+        flags: [TypeFlags.INT, TypeFlags.INT],
+        fastPath: '                                         \
+            if (iir.if_gt(v1, v2))                          \
+                return true;                                \
+            else                                            \
+                return false;'
+    },
+
+    {
+        instrClass: JSGeInstr,
+        prim: 'ge',
+        flags: [TypeFlags.INT, TypeFlags.INT],
+        fastPath: '                                         \
+            if (iir.if_ge(v1, v2))                          \
+                return true;                                \
+            else                                            \
+                return false;'
+    },
+
+    {
+        instrClass: GetPropInstr,
+        prim: 'getProp',
+        flags: [TypeFlags.ARRAY, TypeFlags.INT],
+        fastPath: '                                         \
+            var elem = getElemArr(v1, v2);                  \
+            if (elem !== UNDEFINED)                         \
+                return elem;'
+    }
+];
+
+/**
+Get the specialization site kind of an instruction, if any
+*/
+TypeSpec.getSiteKind = function (instr)
+{
+    for (var i = 0; i < TypeSpec.siteKinds.length; ++i)
+    {
+        var kind = TypeSpec.siteKinds[i];
+
+        if (instr instanceof kind.instrClass)
+            return kind;
+    }
+
+    return undefined;
+}
+
+/**
+Generate the source of a specialized site, which runs the fast path
+if the type tests pass and falls back to the generic primitive
+*/
+TypeSpec.genSpec = function (primName, guard, fastPath)
+{
+    return '                                                \
+    function ' + primName + '_taspec(v1, v2)                \
+    {                                                       \
+        "tachyon:static";                                   \
+        "tachyon:noglobal";                                 \
+                                                            \
+        if (' + guard + ')                                  \
+        {                                                   \
+            ' + fastPath + '                                \
+        }                                                   \
+                                                            \
+        return ' + primName + '(v1, v2);                    \
+    }';
+}
+
+/**
+Parse, analyze and annotate a list of source files. Returns the IR
+of the units, to be compiled in order.
+*/
+TypeSpec.prototype.analyzeFiles = function (fileList, params)
+{
+    var analysis = this.analysis;
+
+    // Clear existing analysis results and re-initialize the analysis
+    analysis.init({});
+    analysis.libUnits = [];
+    analysis.allUnits = [];
+
+    analysis.addLibUnits(params);
+
+    var irList = [];
+
+    // For each file to be analyzed
+    for (var i = 0; i < fileList.length; ++i)
+    {
+        var ast = parse_src_file(fileList[i], params);
+        var ir = unitToIR(ast, params);
+
+        analysis.addUnit(ir);
+
+        analysis.allUnits.push(ir);
+        irList.push(ir);
+    }
+
+    measurePerformance(
+        "type analysis",
+        function ()
+        {
+            analysis.run();
+        }
+    );
+
+    // Attach the analysis results to the IR
+    for (var i = 0; i < irList.length; ++i)
+        this.annotate(irList[i]);
+
+    // Release the analysis state, only the annotations are kept
+    analysis.init({});
+    analysis.libUnits = [];
+    analysis.allUnits = [];
+
+    return irList;
+}
+
+/**
+Attach the analysis results to the HIR instructions of a unit and
+its sub-functions
+*/
+TypeSpec.prototype.annotate = function (irFunc)
+{
+    var analysis = this.analysis;
+
+    var funcList = irFunc.getChildrenList();
+    for (var i = 0; i < funcList.length; ++i)
+    {
+        var cfg = funcList[i].hirCFG;
+
+        for (var itr = cfg.getInstrItr(); itr.valid(); itr.next())
+        {
+            var instr = itr.get();
+
+            if (instr instanceof JSCallInstr)
+            {
+                var callee = this.getCallee(instr);
+
+                if (callee !== null)
+                {
+                    instr.taCallee = callee;
+                    this.numCallees++;
+                }
+
+                continue;
+            }
+
+            if (TypeSpec.getSiteKind(instr) === undefined)
+                continue;
+
+            var useTypes = [];
+            for (var j = 0; j < instr.uses.length; ++j)
+            {
+                var type = analysis.getTypeSet(instr, j);
+
+                // If the instruction was not analyzed, nothing is known
+                if (type === null)
+                    break;
+
+                useTypes.push(type);
+            }
+
+            if (useTypes.length === instr.uses.length)
+                instr.taTypes = useTypes;
+        }
+    }
+}
+
+/**
+Get the function a call instruction is proven to call, if it is a
+single top-level function of the code under analysis
+*/
+TypeSpec.prototype.getCallee = function (callInstr)
+{
+    var funcType = this.analysis.getTypeSet(callInstr, 0);
+
+    if (funcType === null ||
+        funcType.flags !== TypeFlags.FUNCTION ||
+        funcType.getNumObjs() !== 1)
+        return null;
+
+    var callee = funcType.getObjItr().get().func;
+
+    // Closures of nested functions have free variables and library
+    // functions are not the ones being compiled
+    if (!(callee instanceof IRFunction) ||
+        callee.parentFunc === null ||
+        callee.parentFunc.parentFunc !== null ||
+        this.analysis.fromLib(callee) === true)
+        return null;
+
+    return callee;
+}
+
+/**
+Test if the type tests on an operand can be omitted. Integers with a
+bounded range are immediate integers.
+*/
+TypeSpec.isProven = function (type, flags)
+{
+    if (flags === TypeFlags.INT)
+        return isFinite(type.rangeMin) && isFinite(type.rangeMax);
+
+    return true;
+}
+
+/**
+Lower a specialization site. Returns the primitive to call along with
+its arguments, or undefined if the site cannot be specialized.
+*/
+TypeSpec.prototype.lowerSite = function (instr, params)
+{
+    var kind = TypeSpec.getSiteKind(instr);
+
+    if (kind === undefined || instr.taTypes === undefined)
+        return undefined;
+
+    // Type tests which could not be proven statically
+    var tests = [];
+
+    for (var i = 0; i < kind.flags.length; ++i)
+    {
+        var type = instr.taTypes[i];
+        var flags = kind.flags[i];
+
+        // Each operand must only have the types the fast path handles
+        if (type.flags !== flags)
+            return undefined;
+
+        if (TypeSpec.isProven(type, flags) === false)
+            tests.push('boxIsInt(v' + (i + 1) + ')');
+    }
+
+    // Array indices must also be non-negative
+    if (instr instanceof GetPropInstr &&
+        !(instr.taTypes[1].rangeMin >= 0 && tests.length === 0))
+        tests.push('v2 >= 0');
+
+    var guard = (tests.length > 0)? tests.join(' && '):'true';
+
+    var primFunc = genSpecPrim(
+        instr.constructor,
+        TypeSpec.genSpec,
+        [kind.prim, guard, kind.fastPath],
+        params
+    );
+
+    // The fast path is inlined into the caller
+    primFunc.inline = true;
+
+    if (tests.length > 0)
+        this.numGuarded++;
+    else
+        this.numProven++;
+
+    return {
+        func: primFunc,
+        args: instr.uses
+    };
+}
+
+/**
+Print a summary of the specialized sites compiled
+*/
+TypeSpec.prototype.report = function ()
+{
+    print('type specialization: ' + this.numProven + ' proven sites, ' +
+          this.numGuarded + ' guarded sites, ' +
+          this.numCallees + ' known callees');
+}
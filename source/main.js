@@ -80,6 +80,10 @@ function main()
     // Initialize the Tachyon configuration
     initConfig(PLATFORM_64BIT, verbosity);
 
+    // If a compilation trace should be recorded
+    if (args.options['ctrace'])
+        startPerfTrace();
+
     // If the unit tests should be run
     if (args.options['test'])
     {
@@ -103,6 +107,23 @@ function main()
         // TODO
     }
 
+    // If the scanner throughput should be measured
+    else if (args.options['scanbench'])
+    {
+        scan_benchmark(args.files);
+    }
+
+    else if (args.options['asmbench'])
+    {
+        x86.asmBenchmark();
+    }
+
+    // If the benchmark suites should be run, each in its own process
+    else if (args.options['bench'])
+    {
+        bench.run(args.options);
+    }
+
     // If type analysis should be performed
     else if (args.options['ta'])
     {
@@ -162,10 +183,67 @@ function main()
     // If source files or inline source are provided    
     else if (args.files.length > 0 || args.options['e'])
     {
+        // If an edge profile should be recorded, instrument the code
+        if (args.options['edgeprof'])
+            config.hostParams.edgeProfile = new EdgeProfile();
+
+        // If an edge profile is provided, use it for the block layout
+        if (args.options['blockprof'])
+        {
+            config.hostParams.blockProfile =
+                EdgeProfile.readFile(args.options['blockprof']);
+        }
+
         // Perform a minimal Tachyon compilation
         initPrimitives(config.hostParams);
         initStdlib(config.hostParams);
 
+        // If type feedback is requested, compile the code in tiers,
+        // starting from the feedback of previous runs, if provided
+        if (args.options['usefeedback'])
+        {
+            config.hostParams.typeFeedback =
+                TypeFeedback.readFile(args.options['usefeedback']);
+        }
+        else if (args.options['typefeedback'])
+        {
+            config.hostParams.typeFeedback = new TypeFeedback();
+        }
+
+        // If static type analysis results should be used, analyze all
+        // the source files together before compiling them
+        if (args.options['useta'])
+        {
+            var taName = args.options['useta'];
+
+            var analysis;
+            switch (taName)
+            {
+                case true:
+                case 'SPSTF':
+                analysis = new SPSTF();
+                break;
+
+                case 'TypeProp':
+                analysis = new TypeProp();
+                break;
+
+                default:
+                error('invalid analysis name: "' + taName + '"');
+            }
+
+            config.hostParams.typeSpec = new TypeSpec(analysis);
+
+            var taUnits = config.hostParams.typeSpec.analyzeFiles(
+                args.files,
+                config.hostParams
+            );
+        }
+
+        // If an inlining report is requested, record the decisions
+        if (args.options['inlinereport'])
+            config.hostParams.inlineReport = [];
+
         config.hostParams.printAST = args.options["ast"];
         config.hostParams.printHIR = args.options["hir"];
         config.hostParams.printLIR = args.options["lir"];
@@ -184,38 +262,82 @@ function main()
             bridge(config.hostParams.ctxPtr);
         }
 
-        for (var i = 0; i < args.files.length; i++)
+        // If running as a benchmark process, time repeated executions
+        if (args.options['benchrun'])
         {
-            if (args.options["time"])
+            bench.runFiles(args.files, taUnits, args.options);
+        }
+
+        else
+        {
+            for (var i = 0; i < args.files.length; i++)
             {
-                print("Executing " + args.files[i]);
+                if (args.options["time"])
+                {
+                    print("Executing " + args.files[i]);
+                }
+
+                var startTimeMs = (new Date()).getTime();
+
+                if (taUnits !== undefined)
+                    var ir = compileUnit(taUnits[i], config.hostParams);
+                else
+                    var ir = compileSrcFile(args.files[i], config.hostParams);
+
+                var midTimeMs = (new Date()).getTime();
+
+                var bridge = makeBridge(
+                    ir,
+                    config.hostParams,
+                    [],
+                    new CIntAsBox()
+                );
+
+                bridge(config.hostParams.ctxPtr);
+
+                var endTimeMs = (new Date()).getTime();
+                var compTimeMs = midTimeMs - startTimeMs;
+                var execTimeMs = endTimeMs - midTimeMs;
+
+                if (args.options["time"])
+                {
+                    print("  compilation time: " + compTimeMs + " ms");
+                    print("  execution time:   " + execTimeMs + " ms");
+                }
             }
+        }
 
-            var startTimeMs = (new Date()).getTime();
-
-            var ir = compileSrcFile(args.files[i], config.hostParams);
-
-            var midTimeMs = (new Date()).getTime();
+        // Report the peephole rule hit counts if requested
+        if (args.options['peepstats'])
+            x86.reportPeephole();
 
-            var bridge = makeBridge(
-                ir,
-                config.hostParams,
-                [],
-                new CIntAsBox()
-            );
+        // Report the inlining decisions if requested
+        if (args.options['inlinereport'])
+        {
+            var report = config.hostParams.inlineReport;
+            for (var i = 0; i < report.length; ++i)
+                print(report[i]);
+        }
 
-            bridge(config.hostParams.ctxPtr);
+        // Report the statically specialized sites if requested
+        if (args.options['tareport'] && config.hostParams.typeSpec)
+            config.hostParams.typeSpec.report();
 
-            var endTimeMs = (new Date()).getTime();
-            var compTimeMs = midTimeMs - startTimeMs;
-            var execTimeMs = endTimeMs - midTimeMs;
+        // Report the type feedback sites if requested
+        if (args.options['fbreport'] && config.hostParams.typeFeedback)
+            config.hostParams.typeFeedback.report();
 
-            if (args.options["time"])
-            {
-                print("  compilation time: " + compTimeMs + " ms");
-                print("  execution time:   " + execTimeMs + " ms");
-            }
+        // Write the updated type feedback, if requested
+        if (args.options['typefeedback'])
+        {
+            config.hostParams.typeFeedback.writeFile(
+                args.options['typefeedback']
+            );
         }
+
+        // Write the recorded edge profile, if any
+        if (args.options['edgeprof'])
+            config.hostParams.edgeProfile.writeFile(args.options['edgeprof']);
     }
 
     // If there are no filenames on the command line, start shell mode
@@ -228,6 +350,15 @@ function main()
         // Call the Tachyon read-eval-print loop
         tachyonRepl();
     }
+
+    // Report the compilation trace, and write it to a file if one is given
+    if (args.options['ctrace'])
+    {
+        reportPerfTrace();
+
+        if (typeof args.options['ctrace'] === 'string')
+            writePerfTrace(args.options['ctrace']);
+    }
 }
 
 try
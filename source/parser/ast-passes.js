@@ -72,68 +72,61 @@ function ast_walk_statement(ast, ctx)
         // no transformation
         return ast;
     }
-    else if (ast instanceof Program)
+
+    switch (ast.kind)
     {
+        case AST_PROGRAM:
         ast.block = ctx.walk_statement(ast.block);
         return ast;
-    }
-    else if (ast instanceof FunctionDeclaration)
-    {
+
+        case AST_FUNCTION_DECLARATION:
         ast.funct = ctx.walk_expr(ast.funct);
         return ast;
-    }
-    else if (ast instanceof BlockStatement)
-    {
+
+        case AST_BLOCK_STATEMENT:
         ast.statements = ast_walk_statements(ast.statements, ctx);
         return ast;
-    }
-    else if (ast instanceof VariableStatement)
-    {
-        ast.decls.forEach(function (decl, i, self)
-                          {
-                              decl.initializer = ctx.walk_expr(decl.initializer);
-                          });
+
+        case AST_VARIABLE_STATEMENT:
+        for (var i=0; i<ast.decls.length; i++)
+        {
+            var decl = ast.decls[i];
+            decl.initializer = ctx.walk_expr(decl.initializer);
+        }
         return ast;
-    }
-    else if (ast instanceof ConstStatement)
-    {
+
+        case AST_CONST_STATEMENT:
         // TODO
         error("ConstStatement not implemented");
         return ast;
-    }
-    else if (ast instanceof ExprStatement)
-    {
+
+        case AST_EXPR_STATEMENT:
         ast.expr = ctx.walk_expr(ast.expr);
         return ast;
-    }
-    else if (ast instanceof IfStatement)
-    {
+
+        case AST_IF_STATEMENT:
         ast.expr = ctx.walk_expr(ast.expr);
         ast.statements = ast_walk_statements(ast.statements, ctx);
         return ast;
-    }
-    else if (ast instanceof DoWhileStatement)
-    {
+
+        case AST_DO_WHILE_STATEMENT:
         ast.statement = ctx.walk_statement(ast.statement);
         ast.expr = ctx.walk_expr(ast.expr);
         return ast;
-    }
-    else if (ast instanceof WhileStatement)
-    {
+
+        case AST_WHILE_STATEMENT:
         ast.expr = ctx.walk_expr(ast.expr);
         ast.statement = ctx.walk_statement(ast.statement);
         return ast;
-    }
-    else if (ast instanceof ForStatement)
-    {
+
+        case AST_FOR_STATEMENT:
         ast.expr1 = ctx.walk_expr(ast.expr1);
         ast.expr2 = ctx.walk_expr(ast.expr2);
         ast.expr3 = ctx.walk_expr(ast.expr3);
         ast.statement = ctx.walk_statement(ast.statement);
         return ast;
-    }
-    else if (ast instanceof ForVarStatement)
-    {
+
+        case AST_FOR_VAR_STATEMENT:
         for (var i=ast.decls.length-1; i>=0; i--)
         {
             var decl = ast.decls[i];
@@ -143,99 +136,82 @@ function ast_walk_statement(ast, ctx)
         ast.expr3 = ctx.walk_expr(ast.expr3);
         ast.statement = ctx.walk_statement(ast.statement);
         return ast;
-    }
-    else if (ast instanceof ForInStatement)
-    {
+
+        case AST_FOR_IN_STATEMENT:
         ast.lhs_expr = ctx.walk_expr(ast.lhs_expr);
         ast.set_expr = ctx.walk_expr(ast.set_expr);
         ast.statement = ctx.walk_statement(ast.statement);
         return ast;
-    }
-    else if (ast instanceof ForVarInStatement)
-    {
+
+        case AST_FOR_VAR_IN_STATEMENT:
         ast.initializer = ctx.walk_expr(ast.initializer);
         ast.set_expr = ctx.walk_expr(ast.set_expr);
         ast.statement = ctx.walk_statement(ast.statement);
         return ast;
-    }
-    else if (ast instanceof ContinueStatement)
-    {
+
+        case AST_CONTINUE_STATEMENT:
         return ast;
-    }
-    else if (ast instanceof BreakStatement)
-    {
+
+        case AST_BREAK_STATEMENT:
         return ast;
-    }
-    else if (ast instanceof ReturnStatement)
-    {
+
+        case AST_RETURN_STATEMENT:
         ast.expr = ctx.walk_expr(ast.expr);
         return ast;
-    }
-    else if (ast instanceof WithStatement)
-    {
+
+        case AST_WITH_STATEMENT:
         ast.expr = ctx.walk_expr(ast.expr);
         ast.statement = ctx.walk_statement(ast.statement);
         return ast;
-    }
-    else if (ast instanceof SwitchStatement)
-    {
+
+        case AST_SWITCH_STATEMENT:
         ast.expr = ctx.walk_expr(ast.expr);
-        ast.clauses.forEach(function (c, i, asts)
-                            {
-                                c.expr = ctx.walk_expr(c.expr);
-                                c.statements = ast_walk_statements(c.statements, ctx);
-                            });
+        for (var i=0; i<ast.clauses.length; i++)
+        {
+            var c = ast.clauses[i];
+            c.expr = ctx.walk_expr(c.expr);
+            c.statements = ast_walk_statements(c.statements, ctx);
+        }
         return ast;
-    }
-    else if (ast instanceof LabelledStatement)
-    {
+
+        case AST_LABELLED_STATEMENT:
         ast.statement = ctx.walk_statement(ast.statement);
         return ast;
-    }
-    else if (ast instanceof ThrowStatement)
-    {
+
+        case AST_THROW_STATEMENT:
         ast.expr = ctx.walk_expr(ast.expr);
         return ast;
-    }
-    else if (ast instanceof TryStatement)
-    {
+
+        case AST_TRY_STATEMENT:
         ast.statement = ctx.walk_statement(ast.statement);
         ast.catch_part = ctx.walk_statement(ast.catch_part);
         ast.finally_part = ctx.walk_statement(ast.finally_part);
         return ast;
-    }
-    else if (ast instanceof CatchPart)
-    {
+
+        case AST_CATCH_PART:
         ast.statement = ctx.walk_statement(ast.statement);
         return ast;
-    }
-    else if (ast instanceof DebuggerStatement)
-    {
+
+        case AST_DEBUGGER_STATEMENT:
         return ast;
-    }
-    else if (ast instanceof AtomicStatement) /********* extensions *********/
-    {
+
+        case AST_ATOMIC_STATEMENT: /********* extensions *********/
         ast.statement = ctx.walk_statement(ast.statement);
         return ast;
-    }
-    else if (ast instanceof FutureStatement) /********* extensions *********/
-    {
+
+        case AST_FUTURE_STATEMENT: /********* extensions *********/
         ast.expr = ctx.walk_expr(ast.expr);
         return ast;
     }
-   else
-    {
-        //pp(ast);
-        error("unknown ast in walk_statement");
-    }
+
+    //pp(ast);
+    error("unknown ast in walk_statement");
 }
 
 function ast_walk_statements(asts, ctx)
 {
-    asts.forEach(function (ast, i, asts)
-                 {
-                     asts[i] = ctx.walk_statement(ast);
-                 });
+    for (var i=0; i<asts.length; i++)
+        asts[i] = ctx.walk_statement(asts[i]);
     return asts;
 }
 
@@ -246,72 +222,62 @@ function ast_walk_expr(ast, ctx)
         // no transformation
         return ast;
     }
-    else if (ast instanceof OpExpr)
+
+    switch (ast.kind)
     {
+        case AST_OP_EXPR:
         ast.exprs = ast_walk_exprs(ast.exprs, ctx);
         return ast;
-    }
-    else if (ast instanceof NewExpr)
-    {
+
+        case AST_NEW_EXPR:
         ast.expr = ctx.walk_expr(ast.expr);
         ast.args = ast_walk_exprs(ast.args, ctx);
         return ast;
-    }
-    else if (ast instanceof CallExpr)
-    {
+
+        case AST_CALL_EXPR:
         ast.fn = ctx.walk_expr(ast.fn);
         ast.args = ast_walk_exprs(ast.args, ctx);
         return ast;
-    }
-    else if (ast instanceof FunctionExpr)
-    {
+
+        case AST_FUNCTION_EXPR:
         ast.body = ast_walk_statements(ast.body, ctx);
         return ast;
-    }
-    else if (ast instanceof Literal)
-    {
+
+        case AST_LITERAL:
         return ast;
-    }
-    else if (ast instanceof ArrayLiteral)
-    {
+
+        case AST_ARRAY_LITERAL:
         ast.exprs = ast_walk_exprs(ast.exprs, ctx);
         return ast;
-    }
-    else if (ast instanceof RegExpLiteral)
-    {
+
+        case AST_REGEXP_LITERAL:
         return ast;
-    }
-    else if (ast instanceof ObjectLiteral)
-    {
-        ast.properties.forEach(function (prop, i, self)
-                               {
-                                   // name shouldn't be treated as an expression
-                                   //prop.name = ctx.walk_expr(prop.name);
-                                   prop.value = ctx.walk_expr(prop.value);
-                               });
+
+        case AST_OBJECT_LITERAL:
+        for (var i=0; i<ast.properties.length; i++)
+        {
+            var prop = ast.properties[i];
+            // name shouldn't be treated as an expression
+            //prop.name = ctx.walk_expr(prop.name);
+            prop.value = ctx.walk_expr(prop.value);
+        }
         return ast;
-    }
-    else if (ast instanceof Ref)
-    {
+
+        case AST_REF:
         return ast;
-    }
-    else if (ast instanceof This)
-    {
+
+        case AST_THIS:
         return ast;
     }
-    else
-    {
-        //pp(ast);
-        error("unknown ast in walk_expr");
-    }
+
+    //pp(ast);
+    error("unknown ast in walk_expr");
 }
 
 function ast_walk_exprs(asts, ctx)
 {
-    asts.forEach(function (ast, i, asts)
-                 {
-                     asts[i] = ctx.walk_expr(ast);
-                 });
+    for (var i=0; i<asts.length; i++)
+        asts[i] = ctx.walk_expr(asts[i]);
     return asts;
 }
 
@@ -1261,82 +1227,6 @@ function profile$end_of_program()                                 \
 
 //-----------------------------------------------------------------------------
 
-// Pass 2.
-//
-// Identifies functions that use the "eval" and "arguments" symbols.
-//
-// NOTE: this is not done through free variables for two reasons:
-// 1. Free variables can come from nested sub-functions.
-// 2. Free variable resolution and must be done after pass 2
-
-function ast_pass2_ctx(ast)
-{
-    this.ast = ast;
-}
-
-ast_pass2_ctx.prototype.walk_statement = function (ast)
-{
-    if (ast === null)
-    {
-        // no transformation
-        return ast;
-    }
-    else
-    {
-        return ast_walk_statement(ast, this);
-    }
-};
-
-ast_pass2_ctx.prototype.walk_expr = function (ast)
-{
-    if (ast === null)
-    {
-        // no transformation
-        return ast;
-    }
-
-    // Function expression
-    else if (ast instanceof FunctionExpr)
-    {
-        // Create a new context to traverse the function body
-        var new_ctx = new ast_pass2_ctx(ast);
-
-        // Traverse the function body
-        ast_walk_statements(ast.body, new_ctx);
-
-        // Return the updated function
-        return ast;
-    }
-
-    // Variable reference
-    else if (ast instanceof Ref)
-    {
-        // TODO: eliminate when ids are fixed
-        var symName = ast.id.toString();
-
-        if (symName === "arguments")
-            this.ast.usesArguments = true;
-
-        else if (symName === "eval")
-            this.ast.usesEval = true;
-
-        return ast;
-    }
-
-    else
-    {
-        return ast_walk_expr(ast, this);
-    }
-};
-
-function ast_pass2(ast)
-{
-    var ctx = new ast_pass2_ctx(ast);
-    ctx.walk_statement(ast);
-}
-
-//-----------------------------------------------------------------------------
-
 // Pass 3.
 //
 // Transforms an AST into which, when the arguments name occurs free, references
@@ -1372,6 +1262,13 @@ ast_pass3_ctx.prototype.walk_expr = function (ast)
     // Function expression
     else if (ast instanceof FunctionExpr)
     {
+        // If no parameter is aliased here and no nested function uses the
+        // arguments object, there is nothing to rewrite in this function
+        if (this.varMap.length === 0 &&
+            !ast.usesArguments &&
+            !ast.nestedUsesArguments)
+            return ast;
+
         // Create a copy of the
         var newVarMap = this.varMap.copy();
 
@@ -1459,6 +1356,10 @@ ast_pass3_ctx.prototype.walk_expr = function (ast)
 
 function ast_pass3(ast)
 {
+    // Only functions using the arguments object need rewriting
+    if (!ast.nestedUsesArguments)
+        return;
+
     var ctx = new ast_pass3_ctx(new HashMap());
     ctx.walk_statement(ast);
 }
@@ -1760,12 +1661,13 @@ ast_pass5_ctx.prototype.resolve_variable = function (id)
             // TODO: the computation of clos_vars should be done elsewhere as it is not related to the semantics
             if (!(v.scope instanceof Program))
                 scope.clos_vars[id_str] = v;
-        }
 
-        // If the variable's scope is a function and does not match the current scope, mark
-        // the variable as escaping in its scope of origin
-        if (v.scope instanceof FunctionExpr && v.scope !== scope)
-            v.scope.esc_vars[id_str] = v;
+            // If the variable's scope is a function or catch clause and does not match the
+            // current scope, mark the variable as escaping in its scope of origin
+            if ((v.scope instanceof FunctionExpr || v.scope instanceof CatchPart) &&
+                v.scope !== scope)
+                v.scope.esc_vars[id_str] = v;
+        }
 
         return v;
     }
@@ -1802,10 +1704,9 @@ ast_pass5_ctx.prototype.walk_statement = function (ast)
     else if (ast instanceof CatchPart)
     {
         ast.free_vars = {};
+        ast.esc_vars = {};
 
-        // TODO
-        //var new_ctx = this.catch_ctx(ast);
-        var new_ctx = this;
+        var new_ctx = this.catch_ctx(ast);
 
         ast.statement = new_ctx.walk_statement(ast.statement);
         return ast;
@@ -1830,13 +1731,18 @@ ast_pass5_ctx.prototype.walk_expr = function (ast)
         ast.esc_vars = {};
         ast.funcs = [];
 
+        // Find the function or program this function is nested in, skipping
+        // catch clause scopes
+        var func_scope = this.scope;
+        while (func_scope instanceof CatchPart)
+            func_scope = func_scope.parent;
+
         // Add this function to the scope's nested function list
         // If this function is part of a function declaration, add the declaration instead
-        // TODO: fix this code which does not work when the scope is for a CatchPart
         if (this.func_decl !== undefined && this.func_decl.funct === ast)
-            this.scope.funcs.push(this.func_decl);
+            func_scope.funcs.push(this.func_decl);
         else
-            this.scope.funcs.push(ast);
+            func_scope.funcs.push(ast);
 
         var new_ctx = this.function_ctx(ast);
 
@@ -1868,10 +1774,10 @@ function ast_pass5(ast)
 
 function ast_normalize(ast, debug)
 {
+    // The uses of "eval" and "arguments" are recorded by the parser as it
+    // reduces each function, there is no separate pass for them
     if (debug)
         ast_pass1(ast);
-    else
-        ast_pass2(ast);
     ast_pass3(ast);
     ast_pass4(ast);
     ast_pass5(ast);
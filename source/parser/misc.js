@@ -172,4 +172,69 @@ function parse_src_port(port, params)
     return normalized_ast;
 }
 
+//-----------------------------------------------------------------------------
+
+// Measure the scanner throughput in tokens per second on the given files.
+// Each file is read once and then scanned to the end repeatedly.  Without
+// a parser to drive it, a '/' or '/=' is taken to start a regular
+// expression literal unless it follows a token that ends an operand.
+
+function scan_benchmark(filenames, num_iters)
+{
+    if (num_iters === undefined)
+        num_iters = 10;
+
+    for (var i = 0; i < filenames.length; i++)
+    {
+        var filename = filenames[i];
+        var content = read_file(filename);
+        var num_tokens = 0;
+
+        var start_time = currentTimeMillis();
+
+        for (var iter = 0; iter < num_iters; iter++)
+        {
+            var scanner = new Scanner(new String_input_port(content, filename));
+
+            var prev_cat = EOI_CAT;
+
+            for (;;)
+            {
+                var cat = scanner.get_token().cat;
+
+                if (cat === EOI_CAT)
+                    break;
+
+                if ((cat === DIV_CAT || cat === DIVEQUAL_CAT) &&
+                    !scan_benchmark_ends_operand(prev_cat))
+                {
+                    scanner.parse_regexp(cat === DIV_CAT ? [] : [61]);
+
+                    // A regular expression literal is an operand
+                    cat = STRING_CAT;
+                }
+
+                prev_cat = cat;
+                num_tokens++;
+            }
+        }
+
+        var time = Math.max(currentTimeMillis() - start_time, 1);
+
+        print(
+            filename + ": " + (num_tokens / num_iters) + " tokens, " +
+            (time / num_iters).toFixed(1) + " ms/scan, " +
+            Math.round(num_tokens * 1000 / time) + " tokens/s"
+        );
+    }
+}
+
+function scan_benchmark_ends_operand(cat)
+{
+    return cat === IDENT_CAT || cat === NUMBER_CAT || cat === STRING_CAT ||
+           cat === RPAREN_CAT || cat === RBRACK_CAT ||
+           cat === THIS_CAT || cat === NULL_CAT || cat === TRUE_CAT ||
+           cat === FALSE_CAT;
+}
+
 //=============================================================================
@@ -70,9 +70,22 @@ function Parser(scanner, warnings, params)
     this.input = null;
     this.previous_input = null; // for automatic semicolon insertion
 
+    // Stack of the enclosing function scopes, the bottom one being the
+    // program.  A scope is pushed when a "function" keyword is shifted and
+    // popped when the function is reduced, so the uses of "arguments" and
+    // "eval" are known without a separate pass over the AST.
+    this.scopes = [new ParserScope()];
+
     this.params  = params;
 }
 
+function ParserScope()
+{
+    this.usesArguments = false;
+    this.usesEval = false;
+    this.nestedUsesArguments = false;
+}
+
 
 // constants
 
@@ -202,18 +215,117 @@ Parser.prototype.arg = function (i)
 };
 
 
+// The action and goto tables list the entries of a state in no
+// particular order.  They are indexed by category the first time a state
+// is visited so that each parsing step is a single array access.
+
+var PARSER_NUM_CATS = 256;
+
+var parser_action_index = [];
+var parser_goto_index   = [];
+
+
+// method action_index(state)
+
+Parser.prototype.action_index = function (state)
+{
+    var index = parser_action_index[state];
+
+    if (index === undefined)
+    {
+        // Index 0 is the default action of the state
+        var t = this.atable[state];
+        index = new Array(PARSER_NUM_CATS);
+        for (var c=0; c<PARSER_NUM_CATS; c++)
+            index[c] = 0;
+        for (var i=t.length-1; i>0; i--)
+        {
+            var c = this.action_cat(t[i]);
+            if (index[c] === 0)
+                index[c] = i;
+        }
+        parser_action_index[state] = index;
+    }
+
+    return index;
+};
+
+
 // method index_gtable(state, new_category)
 
 Parser.prototype.index_gtable = function (state, new_category)
 {
-    var t = this.gtable[state];
-    for (var i=0; i<t.length; i++)
+    var index = parser_goto_index[state];
+
+    if (index === undefined)
     {
-        var g = t[i];
-        if (this.goto_cat(g) === new_category)
-            return this.goto_new_state(g);
+        var t = this.gtable[state];
+        index = new Array(PARSER_NUM_CATS);
+        for (var c=0; c<PARSER_NUM_CATS; c++)
+            index[c] = 0; // never reached
+        for (var i=0; i<t.length; i++)
+        {
+            var g = t[i];
+            var c = this.goto_cat(g);
+            if (index[c] === 0)
+                index[c] = this.goto_new_state(g);
+        }
+        parser_goto_index[state] = index;
     }
-    return 0; // never reached
+
+    return index[new_category];
+};
+
+
+// method enter_function()
+
+Parser.prototype.enter_function = function ()
+{
+    this.scopes.push(new ParserScope());
+};
+
+
+// method leave_function(funct)
+
+Parser.prototype.leave_function = function (funct)
+{
+    var scope = this.scopes.pop();
+
+    funct.usesArguments = scope.usesArguments;
+    funct.usesEval = scope.usesEval;
+    funct.nestedUsesArguments = scope.nestedUsesArguments;
+
+    if (scope.usesArguments || scope.nestedUsesArguments)
+        this.scopes[this.scopes.length-1].nestedUsesArguments = true;
+
+    return funct;
+};
+
+
+// method leave_program(prog)
+
+Parser.prototype.leave_program = function (prog)
+{
+    var scope = this.scopes[0];
+
+    prog.usesArguments = scope.usesArguments;
+    prog.usesEval = scope.usesEval;
+    prog.nestedUsesArguments = scope.nestedUsesArguments;
+
+    return prog;
+};
+
+
+// method note_ref(id)
+
+Parser.prototype.note_ref = function (id)
+{
+    var name = id.value;
+
+    if (name === "arguments")
+        this.scopes[this.scopes.length-1].usesArguments = true;
+    else if (name === "eval")
+        this.scopes[this.scopes.length-1].usesEval = true;
 };
 
 
@@ -339,53 +451,22 @@ Parser.prototype.parse = function ()
         {
             var autosemicolon_inserted = false;
             var cat = this.token_cat(this.input);
-            var i = t.length-1;
-            var a = t[i];
+            var index = this.action_index(state);
+            var a;
 
             if (this.autosemicolon_enabled &&
                 (this.scanner.crossed_eol ||
-                 this.token_cat(this.input) === RBRACE_CAT))
+                 cat === RBRACE_CAT) &&
+                index[AUTOSEMICOLON_CAT] !== 0)
             {
-                // automatic semicolon insertion should be considered
-
-                var normal_index = 0;
-                var autosemicolon_index = 0;
-
-                while (i > 0)
-                {
-                    var a_cat = this.action_cat(a);
-
-                    if (a_cat === cat)
-                        normal_index = i;
-                    else if (a_cat === AUTOSEMICOLON_CAT)
-                        autosemicolon_index = i;
+                // automatic semicolon insertion applies
 
-                    i--;
-                    a = t[i];
-                }
-
-                if (autosemicolon_index !== 0)
-                {
-                    autosemicolon_inserted = true;
-                    a = t[autosemicolon_index];
-                }
-                else
-                    a = t[normal_index];
+                autosemicolon_inserted = true;
+                a = t[index[AUTOSEMICOLON_CAT]];
             }
             else
             {
-                // automatic semicolon insertion should not be considered
-
-                while (i > 0)
-                {
-                    var a_cat = this.action_cat(a);
-
-                    if (a_cat === cat)
-                        break;
-
-                    i--;
-                    a = t[i];
-                }
+                a = t[index[cat]];
             }
 
             var op = this.action_op(a);
@@ -414,6 +495,8 @@ Parser.prototype.parse = function ()
                 {
                     this.shift(op, this.token_attr(this.input));
                     this.input_valid = false;
+                    if (cat === FUNCTION_CAT)
+                        this.enter_function();
                 }
             }
             else
@@ -443,6 +526,46 @@ function list_loc(list)
 
 // AST construction.
 
+// Node kinds.  Every node records its kind on its prototype so that the
+// AST walkers dispatch with a single switch instead of a chain of
+// instanceof tests.
+
+var AST_PROGRAM              = 1;
+var AST_FUNCTION_DECLARATION = 2;
+var AST_BLOCK_STATEMENT      = 3;
+var AST_VARIABLE_STATEMENT   = 4;
+var AST_CONST_STATEMENT      = 5;
+var AST_EXPR_STATEMENT       = 6;
+var AST_IF_STATEMENT         = 7;
+var AST_DO_WHILE_STATEMENT   = 8;
+var AST_WHILE_STATEMENT      = 9;
+var AST_FOR_STATEMENT        = 10;
+var AST_FOR_VAR_STATEMENT    = 11;
+var AST_FOR_IN_STATEMENT     = 12;
+var AST_FOR_VAR_IN_STATEMENT = 13;
+var AST_CONTINUE_STATEMENT   = 14;
+var AST_BREAK_STATEMENT      = 15;
+var AST_RETURN_STATEMENT     = 16;
+var AST_WITH_STATEMENT       = 17;
+var AST_SWITCH_STATEMENT     = 18;
+var AST_LABELLED_STATEMENT   = 19;
+var AST_THROW_STATEMENT      = 20;
+var AST_TRY_STATEMENT        = 21;
+var AST_CATCH_PART           = 22;
+var AST_DEBUGGER_STATEMENT   = 23;
+var AST_ATOMIC_STATEMENT     = 24;
+var AST_FUTURE_STATEMENT     = 25;
+var AST_OP_EXPR              = 26;
+var AST_NEW_EXPR             = 27;
+var AST_CALL_EXPR            = 28;
+var AST_FUNCTION_EXPR        = 29;
+var AST_LITERAL              = 30;
+var AST_ARRAY_LITERAL        = 31;
+var AST_REGEXP_LITERAL       = 32;
+var AST_OBJECT_LITERAL       = 33;
+var AST_REF                  = 34;
+var AST_THIS                 = 35;
+
 // Constructors.
 
 function Program(loc, block)
@@ -454,6 +577,7 @@ function Program(loc, block)
     this.block = block;
     this.usesArguments = false;
     this.usesEval = false;
+    this.nestedUsesArguments = false;
 }
 
 function FunctionDeclaration(loc, id, funct)
@@ -741,6 +865,7 @@ function FunctionExpr(loc, id, params, body)
     this.annotations = extract_annotations(body);
     this.usesArguments = false;
     this.usesEval = false;
+    this.nestedUsesArguments = false;
 }
 
 function extract_annotations(body)
@@ -820,6 +945,40 @@ function This(loc)
     this.loc = loc;
 }
 
+Program.prototype.kind             = AST_PROGRAM;
+FunctionDeclaration.prototype.kind = AST_FUNCTION_DECLARATION;
+BlockStatement.prototype.kind      = AST_BLOCK_STATEMENT;
+VariableStatement.prototype.kind   = AST_VARIABLE_STATEMENT;
+ConstStatement.prototype.kind      = AST_CONST_STATEMENT;
+ExprStatement.prototype.kind       = AST_EXPR_STATEMENT;
+IfStatement.prototype.kind         = AST_IF_STATEMENT;
+DoWhileStatement.prototype.kind    = AST_DO_WHILE_STATEMENT;
+WhileStatement.prototype.kind      = AST_WHILE_STATEMENT;
+ForStatement.prototype.kind        = AST_FOR_STATEMENT;
+ForVarStatement.prototype.kind     = AST_FOR_VAR_STATEMENT;
+ForInStatement.prototype.kind      = AST_FOR_IN_STATEMENT;
+ForVarInStatement.prototype.kind   = AST_FOR_VAR_IN_STATEMENT;
+ContinueStatement.prototype.kind   = AST_CONTINUE_STATEMENT;
+BreakStatement.prototype.kind      = AST_BREAK_STATEMENT;
+ReturnStatement.prototype.kind     = AST_RETURN_STATEMENT;
+WithStatement.prototype.kind       = AST_WITH_STATEMENT;
+SwitchStatement.prototype.kind     = AST_SWITCH_STATEMENT;
+LabelledStatement.prototype.kind   = AST_LABELLED_STATEMENT;
+ThrowStatement.prototype.kind      = AST_THROW_STATEMENT;
+TryStatement.prototype.kind        = AST_TRY_STATEMENT;
+CatchPart.prototype.kind           = AST_CATCH_PART;
+DebuggerStatement.prototype.kind   = AST_DEBUGGER_STATEMENT;
+OpExpr.prototype.kind              = AST_OP_EXPR;
+NewExpr.prototype.kind             = AST_NEW_EXPR;
+CallExpr.prototype.kind            = AST_CALL_EXPR;
+FunctionExpr.prototype.kind        = AST_FUNCTION_EXPR;
+Literal.prototype.kind             = AST_LITERAL;
+ArrayLiteral.prototype.kind        = AST_ARRAY_LITERAL;
+RegExpLiteral.prototype.kind       = AST_REGEXP_LITERAL;
+ObjectLiteral.prototype.kind       = AST_OBJECT_LITERAL;
+Ref.prototype.kind                 = AST_REF;
+This.prototype.kind                = AST_THIS;
+
 // Grammar rule actions.
 
 function Top(p, arg1, arg2)
@@ -833,17 +992,17 @@ function Top(p, arg1, arg2)
 function Program_1(p)
 {
     var loc = p.current_loc();
-    return new Program(loc,
-                       new BlockStatement(loc,
-                                          []));
+    return p.leave_program(new Program(loc,
+                                       new BlockStatement(loc,
+                                                          [])));
 }
 
 function Program_2(p, SourceElements)
 {
     var loc = list_loc(SourceElements);
-    return new Program(loc,
-                       new BlockStatement(loc,
-                                          SourceElements));
+    return p.leave_program(new Program(loc,
+                                       new BlockStatement(loc,
+                                                          SourceElements)));
 }
 
 function Literal_1(p, NULL)
@@ -981,6 +1140,7 @@ function PrimaryExprNoBrace_3(p, ArrayLiteral)
 
 function PrimaryExprNoBrace_4(p, IDENT)
 {
+    p.note_ref(IDENT);
     return new Ref(IDENT.loc,
                    IDENT);
 }
@@ -1990,6 +2150,8 @@ function AtomicStatement(loc, statement)
     this.statement = statement;
 }
 
+AtomicStatement.prototype.kind = AST_ATOMIC_STATEMENT;
+
 function Statement_18(p, ATOMIC, Block) /********* extensions *********/
 {
     return new AtomicStatement(ATOMIC.loc.join(Block.loc),
@@ -2002,6 +2164,8 @@ function FutureStatement(loc, expr)
     this.expr = expr;
 }
 
+FutureStatement.prototype.kind = AST_FUTURE_STATEMENT;
+
 function Statement_19(p, FUTURE, Expr, SEMICOLON) /********* extensions *********/
 {
     return new FutureStatement(FUTURE.loc.join(SEMICOLON.loc),
@@ -2455,52 +2619,54 @@ function FunctionDeclaration_1(p, FUNCTION, IDENT, LPAREN, RPAREN, LBRACE, Funct
 {
     return new FunctionDeclaration(FUNCTION.loc.join(RBRACE.loc),
                                    IDENT,
-                                   new FunctionExpr(FUNCTION.loc.join(RBRACE.loc),
-                                                    null,
-                                                    [],
-                                                    FunctionBody));
+                                   p.leave_function(
+                                       new FunctionExpr(FUNCTION.loc.join(RBRACE.loc),
+                                                        null,
+                                                        [],
+                                                        FunctionBody)));
 }
 
 function FunctionDeclaration_2(p, FUNCTION, IDENT, LPAREN, FormalParameterList, RPAREN, LBRACE, FunctionBody, RBRACE)
 {
     return new FunctionDeclaration(FUNCTION.loc.join(RBRACE.loc),
                                    IDENT,
-                                   new FunctionExpr(FUNCTION.loc.join(RBRACE.loc),
-                                                    null,
-                                                    FormalParameterList,
-                                                    FunctionBody));
+                                   p.leave_function(
+                                       new FunctionExpr(FUNCTION.loc.join(RBRACE.loc),
+                                                        null,
+                                                        FormalParameterList,
+                                                        FunctionBody)));
 }
 
 function FunctionExpr_1(p, FUNCTION, LPAREN, RPAREN, LBRACE, FunctionBody, RBRACE)
 {
-    return new FunctionExpr(FUNCTION.loc.join(RBRACE.loc),
-                            null,
-                            [],
-                            FunctionBody);
+    return p.leave_function(new FunctionExpr(FUNCTION.loc.join(RBRACE.loc),
+                                             null,
+                                             [],
+                                             FunctionBody));
 }
 
 function FunctionExpr_2(p, FUNCTION, LPAREN, FormalParameterList, RPAREN, LBRACE, FunctionBody, RBRACE)
 {
-    return new FunctionExpr(FUNCTION.loc.join(RBRACE.loc),
-                            null,
-                            FormalParameterList,
-                            FunctionBody);
+    return p.leave_function(new FunctionExpr(FUNCTION.loc.join(RBRACE.loc),
+                                             null,
+                                             FormalParameterList,
+                                             FunctionBody));
 }
 
 function FunctionExpr_3(p, FUNCTION, IDENT, LPAREN, RPAREN, LBRACE, FunctionBody, RBRACE)
 {
-    return new FunctionExpr(FUNCTION.loc.join(RBRACE.loc),
-                            IDENT,
-                            [],
-                            FunctionBody);
+    return p.leave_function(new FunctionExpr(FUNCTION.loc.join(RBRACE.loc),
+                                             IDENT,
+                                             [],
+                                             FunctionBody));
 }
 
 function FunctionExpr_4(p, FUNCTION, IDENT, LPAREN, FormalParameterList, RPAREN, LBRACE, FunctionBody, RBRACE)
 {
-    return new FunctionExpr(FUNCTION.loc.join(RBRACE.loc),
-                            IDENT,
-                            FormalParameterList,
-                            FunctionBody);
+    return p.leave_function(new FunctionExpr(FUNCTION.loc.join(RBRACE.loc),
+                                             IDENT,
+                                             FormalParameterList,
+                                             FunctionBody));
 }
 
 function FormalParameterList_1(p, IDENT)
@@ -61,415 +61,254 @@
 //-----------------------------------------------------------------------------
 
 
+// The scanner works over the whole source text.  Characters are
+// classified with a table and operators are recognized by a DFA whose
+// transitions are stored in a table, so that scanning a token does not
+// require a function call per character.  Tokens are scanned in batches
+// and handed to the parser one at a time.
+
+
 function Scanner(port)
 {
-    this.port             = port;
-    this.current_char_pos = 0;
-    this.current_line_pos = 0;
-    this.current_line     = 0;
-    this.peeked_char      = null;
-    this.peeked_char_pos  = null;
-    this.pos_window       = [null, null, null, null, null];
-    this.char_window      = [null, null, null, null, null];
-    this.window_size      = 0;
-    this.crossed_eol      = false;
+    this.port        = port;
+    this.content     = scanner_port_content(port);
+    this.index       = 0;
+    this.line        = 0;
+    this.line_start  = 0;
+    this.crossed_eol = false;
+
+    // Batch of scanned tokens, with the crossed_eol flag of each token
+    this.tokens      = new Array(SCANNER_BATCH_SIZE);
+    this.token_eols  = new Array(SCANNER_BATCH_SIZE);
+    this.num_tokens  = 0;
+    this.next_token  = 0;
 }
 
 
-// method read_char()
+// Maximum number of tokens scanned in one batch.
 
-Scanner.prototype.read_char = function ()
-{
-    var c = this.port.read_char();
-    if (c !== EOF)
-        this.current_char_pos++;
-    return c;
-};
+var SCANNER_BATCH_SIZE = 64;
 
 
-// method get_char()
+// Get the whole content of an input port as a string.
 
-Scanner.prototype.get_char = function ()
+function scanner_port_content(port)
 {
-    var c = this.peeked_char;
+    if (typeof port.content === "string")
+        return port.content.substring(port.pos);
 
-    if (c !== null)
-        this.peeked_char = null;
-    else
-        c = this.read_char();
+    var chars = [];
+    for (var c = port.read_char(); c !== EOF; c = port.read_char())
+        chars.push(c);
 
-    if (c === LF_CH)
-    {
-        this.current_line++;
-        this.current_line_pos = this.current_char_pos;
-        return EOL_CH;
-    }
-    else if (c === CR_CH)
-    {
-        this.current_line++;
-        this.current_line_pos = this.current_char_pos;
-        this.peeked_char_pos = this.current_char_pos;
-        var next = this.read_char();
-        if (next === LF_CH)
-            this.current_line_pos = this.current_char_pos;
-        else
-            this.peeked_char = next; // remember for next time
-        return EOL_CH;
-    }
-    else
-        return c;
-};
+    return String.fromCharCode.apply(null, chars);
+}
 
 
-// method advance(i)
+// method get_token()
 
-Scanner.prototype.advance = function (i)
+Scanner.prototype.get_token = function ()
 {
-    var j = 0;
-    this.fill_window(i);
-    while (i < this.window_size)
-    {
-        var p = this.pos_window[i];
-        var c = this.char_window[i];
-        //delete this.pos_window[i];
-        //delete this.char_window[i];
-        this.pos_window[j] = p;
-        this.char_window[j] = c;
-        i++;
-        j++;
-    }
-    this.window_size = j;
+    if (this.next_token >= this.num_tokens)
+        this.scan_batch();
+
+    var i = this.next_token++;
+    this.crossed_eol = this.token_eols[i];
+    return this.tokens[i];
 };
 
 
-// method lookahead_pos(i)
+// method scan_batch()
 
-Scanner.prototype.lookahead_pos = function (i)
+Scanner.prototype.scan_batch = function ()
 {
-    this.fill_window(i+1);
-    return this.pos_window[i];
+    // The batch ends after a division operator, since the parser may
+    // scan a regular expression literal from that point.
+
+    var n = 0;
+
+    for (;;)
+    {
+        var tok = this.scan_token();
+        this.tokens[n] = tok;
+        this.token_eols[n] = this.crossed_eol;
+        n++;
+
+        var cat = tok.cat;
+        if (n === SCANNER_BATCH_SIZE || cat === EOI_CAT ||
+            cat === DIV_CAT || cat === DIVEQUAL_CAT)
+            break;
+    }
+
+    this.num_tokens = n;
+    this.next_token = 0;
 };
 
 
-// method lookahead_char(i)
+// method position(index)
 
-Scanner.prototype.lookahead_char = function (i)
+Scanner.prototype.position = function (index)
 {
-    this.fill_window(i+1);
-    return this.char_window[i];
+    return line_and_column_to_position(this.line, index - this.line_start);
 };
 
 
-// method fill_window(n)
+// method new_line(index)
+//
+// Start a new line after the end of line character at the given index,
+// returns the index after the end of line sequence.
 
-Scanner.prototype.fill_window = function (n)
+Scanner.prototype.new_line = function (index)
 {
-    // fill first n entries of the lookahead window
-    var s = this.window_size;
-    if (s < n)
-    {
-        var i = s;
-        while (i < n)
-        {
-            var cp = (this.peeked_char === null)
-                     ? this.current_char_pos
-                     : this.peeked_char_pos;
-            this.pos_window[i] =
-                line_and_column_to_position(this.current_line,
-                                            cp - this.current_line_pos);
-            this.char_window[i] = this.get_char();
-            i++;
-        }
-        this.window_size = i;
-    }
+    var content = this.content;
+
+    if (content.charCodeAt(index) === CR_CH &&
+        index + 1 < content.length &&
+        content.charCodeAt(index + 1) === LF_CH)
+        index++;
+
+    this.line++;
+    this.line_start = index + 1;
+    return index + 1;
 };
 
 
-// method get_token()
+// method scan_token()
 
-Scanner.prototype.get_token = function ()
+Scanner.prototype.scan_token = function ()
 {
-    var c = this.lookahead_char(0);
+    var content = this.content;
+    var length = content.length;
+    var i = this.index;
 
     this.crossed_eol = false;
 
     for (;;)
     {
-        if (c === EOF)
-            return this.simple_token(EOI_CAT, 0);
-        else if (c === SPACE_CH || c === EOL_CH || c === TAB_CH)
+        if (i >= length)
         {
-            if (c === EOL_CH)
-                this.crossed_eol = true;
-            this.advance(1);
-            c = this.lookahead_char(0);
+            this.index = i;
+            return this.simple_token(EOI_CAT, 0);
         }
-        else if (this.identifier_class(c))
-            return this.parse_identifier();
-        else if (this.decimal_class(c))
-            return this.parse_number();
-        else if (c === PERIOD_CH)
+
+        var c = content.charCodeAt(i);
+        var cc = (c < 128) ? scanner_char_class[c] : CC_OTHER;
+
+        if (cc === CC_SPACE)
+            i++;
+        else if (cc === CC_EOL)
         {
-            if (this.decimal_class(this.lookahead_char(1)))
-                return this.parse_number();
-            else
-                return this.simple_token(PERIOD_CAT, 1);
+            this.crossed_eol = true;
+            i = this.new_line(i);
         }
-        else if (c === EXCL_CH)
+        else if (cc === CC_SLASH && i + 1 < length &&
+                 content.charCodeAt(i + 1) === SLASH_CH)
         {
-            if (this.lookahead_char(1) === EQUAL_CH)
+            // Line comment
+            i += 2;
+            while (i < length)
             {
-                if (this.lookahead_char(2) === EQUAL_CH)
-                    return this.simple_token(STRNEQ_CAT, 3);
-                else
-                    return this.simple_token(NE_CAT, 2);
+                c = content.charCodeAt(i);
+                if (c === LF_CH || c === CR_CH)
+                    break;
+                i++;
             }
-            else
-                return this.simple_token(EXCL_CAT, 1);
-        }
-        else if (c === PERCENT_CH)
-        {
-            if (this.lookahead_char(1) === EQUAL_CH)
-                return this.simple_token(MODEQUAL_CAT, 2);
-            else
-                return this.simple_token(MOD_CAT, 1);
-        }
-        else if (c === AMPERSAND_CH)
-        {
-            var x = this.lookahead_char(1);
-            if (x === AMPERSAND_CH)
-                return this.simple_token(AND_CAT, 2);
-            else if (x === EQUAL_CH)
-                return this.simple_token(BITANDEQUAL_CAT, 2);
-            else
-                return this.simple_token(BITAND_CAT, 1);
+            this.crossed_eol = true;
         }
-        else if (c === STAR_CH)
+        else if (cc === CC_SLASH && i + 1 < length &&
+                 content.charCodeAt(i + 1) === STAR_CH)
         {
-            if (this.lookahead_char(1) === EQUAL_CH)
-                return this.simple_token(MULTEQUAL_CAT, 2);
-            else
-                return this.simple_token(MULT_CAT, 1);
-        }
-        else if (c === PLUS_CH)
-        {
-            var x = this.lookahead_char(1);
-            if (x === PLUS_CH)
-                return this.simple_token(PLUSPLUS_CAT, 2);
-            else if (x === EQUAL_CH)
-                return this.simple_token(PLUSEQUAL_CAT, 2);
-            else
-                return this.simple_token(PLUS_CAT, 1);
-        }
-        else if (c === MINUS_CH)
-        {
-            var x = this.lookahead_char(1);
-            if (x === MINUS_CH)
-                return this.simple_token(MINUSMINUS_CAT, 2);
-            else if (x === EQUAL_CH)
-                return this.simple_token(MINUSEQUAL_CAT, 2);
-            else
-                return this.simple_token(MINUS_CAT, 1);
-        }
-        else if (c === SLASH_CH)
-        {
-            var x = this.lookahead_char(1);
-            if (x === SLASH_CH)
-            {
-                this.advance(2);
-                for (;;)
-                {
-                    c = this.lookahead_char(0);
-                    if (c === EOL_CH || c === EOF)
-                    {
-                        this.crossed_eol = true;
-                        break;
-                    }
-                    this.advance(1);
-                }
-            }
-            else if (x === STAR_CH)
+            // Block comment
+            i += 2;
+            for (;;)
             {
-                this.advance(2);
-                for (;;)
+                if (i >= length)
                 {
-                    c = this.lookahead_char(0);
-                    if (c === EOF)
-                        error("unterminated comment");
-                    if (c === STAR_CH && this.lookahead_char(1) === SLASH_CH)
-                        break;
-                    if (c === EOL_CH)
-                        this.crossed_eol = true;
-                    this.advance(1);
+                    this.index = i;
+                    error("unterminated comment");
                 }
-                this.advance(2);
-                c = this.lookahead_char(0);
-            }
-            else if (x === EQUAL_CH)
-                return this.simple_token(DIVEQUAL_CAT, 2);
-            else
-                return this.simple_token(DIV_CAT, 1);
-        }
-        else if (c === COLON_CH)
-            return this.simple_token(COLON_CAT, 1);
-        else if (c === EQUAL_CH)
-        {
-            if (this.lookahead_char(1) === EQUAL_CH)
-            {
-                if (this.lookahead_char(2) === EQUAL_CH)
-                    return this.simple_token(STREQ_CAT, 3);
-                else
-                    return this.simple_token(EQEQ_CAT, 2);
-            }
-            else
-                return this.simple_token(EQUAL_CAT, 1);
-        }
-        else if (c === LT_CH)
-        {
-            var x = this.lookahead_char(1);
-            if (x === LT_CH)
-            {
-                if (this.lookahead_char(2) === EQUAL_CH)
-                    return this.simple_token(LSHIFTEQUAL_CAT, 3);
-                else
-                    return this.simple_token(LSHIFT_CAT, 2);
-            }
-            else if (x === EQUAL_CH)
-                return this.simple_token(LE_CAT, 2);
-            else
-                return this.simple_token(LT_CAT, 1);
-        }
-        else if (c === GT_CH)
-        {
-            var x = this.lookahead_char(1);
-            if (x === GT_CH)
-            {
-                var y = this.lookahead_char(2);
-                if (y === GT_CH)
+
+                c = content.charCodeAt(i);
+
+                if (c === STAR_CH && i + 1 < length &&
+                    content.charCodeAt(i + 1) === SLASH_CH)
+                    break;
+
+                if (c === LF_CH || c === CR_CH)
                 {
-                    if (this.lookahead_char(3) === EQUAL_CH)
-                        return this.simple_token(URSHIFTEQUAL_CAT, 4);
-                    else
-                        return this.simple_token(URSHIFT_CAT, 3);
+                    this.crossed_eol = true;
+                    i = this.new_line(i);
                 }
-                else if (y === EQUAL_CH)
-                    return this.simple_token(RSHIFTEQUAL_CAT, 3);
                 else
-                    return this.simple_token(RSHIFT_CAT, 2);
+                    i++;
             }
-            else if (x === EQUAL_CH)
-                return this.simple_token(GE_CAT, 2);
-            else
-                return this.simple_token(GT_CAT, 1);
+            i += 2;
         }
-        else if (c === QUESTION_CH)
-            return this.simple_token(QUESTION_CAT, 1);
-        else if (c === CARET_CH)
-        {
-            if (this.lookahead_char(1) === EQUAL_CH)
-                return this.simple_token(BITXOREQUAL_CAT, 2);
-            else
-                return this.simple_token(BITXOR_CAT, 1);
-        }
-        else if (c === LPAREN_CH)
-            return this.simple_token(LPAREN_CAT, 1);
-        else if (c === RPAREN_CH)
-            return this.simple_token(RPAREN_CAT, 1);
-        else if (c === COMMA_CH)
-            return this.simple_token(COMMA_CAT, 1);
-        else if (c === SEMICOLON_CH)
-            return this.simple_token(SEMICOLON_CAT, 1);
-        else if (c === LBRACK_CH)
-            return this.simple_token(LBRACK_CAT, 1);
-        else if (c === VBAR_CH)
-        {
-            var x = this.lookahead_char(1);
-            if (x === VBAR_CH)
-                return this.simple_token(OR_CAT, 2);
-            else if (x === EQUAL_CH)
-                return this.simple_token(BITOREQUAL_CAT, 2);
-            else
-                return this.simple_token(BITOR_CAT, 1);
-        }
-        else if (c === RBRACK_CH)
-            return this.simple_token(RBRACK_CAT, 1);
-        else if (c === LBRACE_CH)
-            return this.simple_token(LBRACE_CAT, 1);
-        else if (c === RBRACE_CH)
-            return this.simple_token(RBRACE_CAT, 1);
-        else if (c === TILDE_CH)
-            return this.simple_token(BITNOT_CAT, 1);
-        else if (c === DOUBLEQUOTE_CH || c === QUOTE_CH)
-            return this.parse_string();
         else
-        {
-            error("unknown token: " + c);
-        }
+            break;
     }
-};
-
 
-// method identifier_class()
+    this.index = i;
+
+    if (cc === CC_IDENT)
+        return this.parse_identifier();
+    else if (cc === CC_DIGIT)
+        return this.parse_number();
+    else if (cc === CC_PERIOD && i + 1 < length &&
+             scanner_char_class[content.charCodeAt(i + 1)] === CC_DIGIT)
+        return this.parse_number();
+    else if (cc === CC_QUOTE)
+        return this.parse_string();
+
+    // Longest operator accepted by the operator DFA
+    var state = 0;
+    var j = i;
+    while (j < length)
+    {
+        c = content.charCodeAt(j);
+        if (c >= 128)
+            break;
 
-Scanner.prototype.identifier_class = function (c)
-{
-    return (c >= LOWER_A_CH && c <= LOWER_Z_CH) ||
-        (c >= UPPER_A_CH && c <= UPPER_Z_CH) ||
-        c === UNDERSCORE_CH ||
-        c === DOLLAR_CH;
-};
+        var next = scanner_op_trans[state * 128 + c];
+        if (next === 0)
+            break;
 
+        state = next;
+        j++;
+    }
 
-// method decimal_class()
+    if (state === 0)
+        error("unknown token: " + content.charCodeAt(i));
 
-Scanner.prototype.decimal_class = function (c)
-{
-    return c >= ZERO_CH && c <= NINE_CH;
+    return this.simple_token(scanner_op_cat[state], j - i);
 };
 
-// method hexadecimal_class()
-
-Scanner.prototype.hexadecimal_class = function (c)
-{
-    return Scanner.prototype.decimal_class(c) ||
-           (c >= LOWER_A_CH && c <= LOWER_F_CH) ||
-           (c >= UPPER_A_CH && c <= UPPER_F_CH);
-};
 
 // method parse_identifier()
 
-Scanner.prototype.parse_identifier_old = function ()
+Scanner.prototype.parse_identifier = function ()
 {
-    // This iterative algorithm extends the Array of characters using the
-    // "push" method.  The growth of the array generates garbage.
-
-    var start_pos = this.lookahead_pos(0);
-    var chars = [];
+    var content = this.content;
+    var length = content.length;
+    var start = this.index;
+    var i = start;
     var h = 0;
-    for (;;)
+
+    // Compute the keyword hash while scanning
+    while (i < length)
     {
-        var c = this.lookahead_char(0);
-        if (!(this.identifier_class(c) || this.decimal_class(c)))
+        var c = content.charCodeAt(i);
+        if (c >= 128 || scanner_char_class[c] < CC_IDENT ||
+            scanner_char_class[c] > CC_DIGIT)
             break;
-        this.advance(1);
-        chars.push(c);
         h = (h * HASH_MULT + c) % HASH_MOD;
+        i++;
     }
-    var id = String.fromCharCode.apply(null,chars);
-    var x = keyword_hashtable[h];
-    if (x !== null && x.id === id)
-        return this.valued_token(x.cat, id, start_pos);
-    else
-        return this.valued_token(IDENT_CAT, id, start_pos);
-};
 
-Scanner.prototype.parse_identifier = function ()
-{
-    var start_pos = this.lookahead_pos(0);
-    var id = this.parse_identifier_string();
-    var h = 0;
-    for (var i=0; i<id.length; i++)
-        h = (h * HASH_MULT + id.charCodeAt(i)) % HASH_MOD;
+    var start_pos = this.position(start);
+    var id = content.substring(start, i);
+    this.index = i;
+
     var x = keyword_hashtable[h];
     if (x !== null && x.id === id)
         return this.valued_token(x.cat, id, start_pos);
@@ -477,207 +316,183 @@ Scanner.prototype.parse_identifier = function ()
         return this.valued_token(IDENT_CAT, id, start_pos);
 };
 
-Scanner.prototype.parse_identifier_string = function ()
-{
-    return String.fromCharCode.apply(null,
-                                     this.parse_identifier_string_loop(0));
-}
 
-Scanner.prototype.parse_identifier_string_loop = function (n)
-{
-    // This recursive algorithm saves the characters on the stack
-    // and allocates an array of the correct size to hold them.
-    // It does not generate garbage.
+// method digits_value(base, is_digit)
+//
+// Computes the value of a serie of digit characters as if they are on
+// the "left-hand side" of the decimal point.
 
-    var chars;
-    var c = this.lookahead_char(0);
+Scanner.prototype.digits_value = function (base)
+{
+    var content = this.content;
+    var length = this.content.length;
+    var n = 0;
 
-    if (this.identifier_class(c) || this.decimal_class(c))
+    while (this.index < length)
     {
-        this.advance(1);
-        chars = this.parse_identifier_string_loop(n+1);
-        chars[n] = c;
+        var d = scanner_digit_value(content.charCodeAt(this.index), base);
+        if (d < 0)
+            break;
+        this.index++;
+        n = num_add(num_mul(n, base), d);
     }
-    else
+
+    return n;
+};
+
+
+// Get the value of a digit in a given base, or -1 if the character is
+// not a digit in that base.
+
+function scanner_digit_value(c, base)
+{
+    if (c >= ZERO_CH && c <= NINE_CH)
+        return c - ZERO_CH;
+
+    if (base === 16)
     {
-        chars = new Array(n);
+        if (c >= LOWER_A_CH && c <= LOWER_F_CH)
+            return (c - LOWER_A_CH) + 10;
+        if (c >= UPPER_A_CH && c <= UPPER_F_CH)
+            return (c - UPPER_A_CH) + 10;
     }
 
-    return chars;
+    return -1;
 }
 
 
 // method parse_number()
-// WARNING: The following implementation will not work
-//          in a multi-threaded environment because
-//          there could be a race condition on that
-// TODO: Refactor not to use a closure and assume 
-//       private functions will be lambda lifted
-//       by the compiler
+//
+// 3 types of numbers can be parsed:
+//     decimal     := digits
+//     hexadecimal := 0(x|X)[0-9a-fA-F]+
+//     float       := [digits][.digits][(e|E)[(+|-)]digits]
+
 Scanner.prototype.parse_number = function ()
 {
-    // Assuming:
-    //     digits      := [0-9]+
-    //
-    // 3 types of numbers can be parsed:
-    //     decimal     := digits
-    //     hexadecimal := 0(x|X)[0-9a-fA-F]+
-    //     float       := [digits][.digits][(e|E)[(+|-)]digits]
-
-    // Workaround to allow private helper functions
-    // to access the "this" object
-    var that;
-
-    // Computes the value of a serie of digit characters
-    // as if they are on the "left-hand side" of the decimal point
-    var lhs_value = function (accepted_char, base, char_value) 
-    {
-        var n = 0;
-        for (;;)
-        {
-            var c = that.lookahead_char(0);
-            if (!accepted_char(c))
-                break;
-            that.advance(1);
-            n = num_add(num_mul(n, base), char_value(c));
-        }
-        return n;
-    };
-    
-    // Computes the value of a serie of digit characters
-    // as if they are on the "right-hand side" of the decimal point
-    var rhs_value = function (accepted_char, base, char_value)
-    {
-        var n = 0;
-        var pos = 1;
-        for (;;)
-        {
-            var c = that.lookahead_char(0);
-            if (!accepted_char(c))
-                break;
-            that.advance(1);
-            pos = pos * base;
-            n = n * base + char_value(c);
-        }
-        return n/pos; // FIXME: remove reliance on floating point division
-    };
+    var content = this.content;
+    var length = content.length;
+    var start_pos = this.position(this.index);
+    var n;
+    var snd_char = content.charCodeAt(this.index + 1);
 
-    // Decimal helper functions
-    function decimal (c)
+    if (snd_char === LOWER_X_CH || snd_char === UPPER_X_CH)
     {
-        return that.decimal_class(c);
+        // We got an hex number!
+        this.index += 2;
+        n = this.digits_value(16);
     }
-    
-    function decimal_value (c)
+    else
     {
-        return c - ZERO_CH;
-    }   
+        // TODO: Use Clinger's algorithm:
+        // http://portal.acm.org/citation.cfm?id=93542.93557
 
-    // Hex helper functions
-    function hexadecimal (c)
-    {
-        return that.hexadecimal_class(c);
-    }
+        // We got a decimal number! This should be
+        // zero if the first character is a decimal point.
+        n = this.digits_value(10);
 
-    function hexadecimal_value (c) 
-    {
-        if (c >= LOWER_A_CH) 
+        // We might have numbers after the decimal points
+        if (this.index < length &&
+            content.charCodeAt(this.index) === PERIOD_CH)
         {
-            return (c - LOWER_A_CH) + 10;
-        } else if (c >= UPPER_A_CH)
-        {
-            return (c - UPPER_A_CH) + 10; 
-        } else
-        {
-            return decimal_value(c);
-        }
-    }
-
-    // parsing function
-    return function ()
-    {
-        // Workaround for passing "this"
-        that = this;
+            this.index++;
 
-        var start_pos = that.lookahead_pos(0);
-        var n;
-        var fst_char = that.lookahead_char(0);
-        var snd_char = that.lookahead_char(1);
-        var exp_sign = 1;
+            var f = 0;
+            var pos = 1;
+            while (this.index < length)
+            {
+                var d = scanner_digit_value(content.charCodeAt(this.index), 10);
+                if (d < 0)
+                    break;
+                this.index++;
+                pos = pos * 10;
+                f = f * 10 + d;
+            }
 
-        if (snd_char === LOWER_X_CH || snd_char === UPPER_X_CH)
-        {
-            // We got an hex number!
-            that.advance(2);
-            n = lhs_value(hexadecimal, 16, hexadecimal_value);
+            n = n + f/pos; // FIXME: remove reliance on floating point division
         }
-        else 
-        {
-            // TODO: Use Clinger's algorithm:
-            // http://portal.acm.org/citation.cfm?id=93542.93557
 
-            // We got a decimal number! This should be
-            // zero if the first character is a decimal point.
-            n = lhs_value(decimal, 10, decimal_value);
-
-            // We might have numbers after the decimal points
-            if (that.lookahead_char(0) === PERIOD_CH)
+        // Let's check for an exponent
+        var c = content.charCodeAt(this.index);
+        if (this.index < length && (c === LOWER_E_CH || c === UPPER_E_CH))
+        {
+            this.index++;
+
+            // The exponent might have a sign
+            var exp_sign = 1;
+            c = content.charCodeAt(this.index);
+            if (this.index < length && c === PLUS_CH)
+                this.index++;
+            else if (this.index < length && c === MINUS_CH)
             {
-                that.advance(1);
-                n = n + rhs_value(decimal, 10, decimal_value);
+                exp_sign = -1;
+                this.index++;
             }
 
-            // Let's check for an exponent
-            fst_char = that.lookahead_char(0);
-            if (fst_char === LOWER_E_CH || fst_char === UPPER_E_CH)
-            {
-                that.advance(1);
-
-                // The exponent might have a sign  
-                fst_char = that.lookahead_char(0);
-                if (fst_char === PLUS_CH)
-                {
-                    exp_sign = 1;
-                    that.advance(1);
-                } else if (fst_char === MINUS_CH)
-                {  
-                    exp_sign = -1;
-                    that.advance(1);
-                } 
-
-                n = n * Math.pow(10, exp_sign * 
-                                     lhs_value(decimal, 10, decimal_value));
-            }
+            n = n * Math.pow(10, exp_sign * this.digits_value(10));
         }
+    }
 
-
-        return that.valued_token(NUMBER_CAT, n, start_pos);
-    };
-}();
+    return this.valued_token(NUMBER_CAT, n, start_pos);
+};
 
 
 // method parse_string()
 
 Scanner.prototype.parse_string = function ()
 {
-    var start_pos = this.lookahead_pos(0);
+    var content = this.content;
+    var length = content.length;
+    var start_pos = this.position(this.index);
+    var close = content.charCodeAt(this.index);
+    var start = ++this.index;
+    var i = start;
+
+    // Strings without escapes or line breaks are taken from the source
+    for (;;)
+    {
+        if (i >= length)
+            error("unterminated string");
+        var c = content.charCodeAt(i);
+        if (c === close)
+        {
+            this.index = i + 1;
+            return this.valued_token(STRING_CAT,
+                                     content.substring(start, i),
+                                     start_pos);
+        }
+        if (c === BACKSLASH_CH || c === LF_CH || c === CR_CH)
+            break;
+        i++;
+    }
+
     var chars = [];
-    var close = this.lookahead_char(0);
-    this.advance(1);
+    for (var j = start; j < i; j++)
+        chars.push(content.charCodeAt(j));
+
     for (;;)
     {
-        var c = this.lookahead_char(0);
-        if (c === EOF)
+        if (i >= length)
             error("unterminated string");
-        this.advance(1);
+        var c = content.charCodeAt(i++);
         if (c === close)
             break;
+        else if (c === LF_CH || c === CR_CH)
+        {
+            i = this.new_line(i - 1);
+            chars.push(EOL_CH);
+        }
         else if (c === BACKSLASH_CH)
         {
-            c = this.lookahead_char(0);
-            if (c === EOF)
+            if (i >= length)
                 error("unterminated string");
-            this.advance(1);            if (c !== LF_CH)
+            c = content.charCodeAt(i++);
+            if (c === LF_CH || c === CR_CH)
+            {
+                // Line continuation
+                i = this.new_line(i - 1);
+            }
+            else
             {
                 if (c === LOWER_N_CH)
                     c = LF_CH;
@@ -693,61 +508,23 @@ Scanner.prototype.parse_string = function ()
                     c = FF_CH;
                 else if (c === LOWER_R_CH)
                     c = CR_CH;
-                else if (c === LOWER_X_CH)
+                else if (c === LOWER_X_CH || c === LOWER_U_CH)
                 {
-                    // Parse \xXX string syntax
-                    var value = 0, i = 0;
+                    // Parse \xXX and \uXXXX string syntax
+                    var num_digits = (c === LOWER_X_CH) ? 2 : 4;
+                    var value = 0, k = 0;
 
-                    for (; i < 2; ++i)
+                    for (; k < num_digits && i + k < length; ++k)
                     {
-                        var hc = this.lookahead_char(i);
-
-                        if (hc >= LOWER_A_CH && hc <= LOWER_F_CH)
-                            value = (value * 16) + (hc - 87);
-                        else if (hc >= UPPER_A_CH && hc <= UPPER_F_CH)
-                            value = (value * 16) + (hc - 55);
-                        else if (hc >= ZERO_CH && hc <= NINE_CH)
-                            value = (value * 16) + (hc - 48);
-                        else
-                            break;   
+                        var d = scanner_digit_value(content.charCodeAt(i + k), 16);
+                        if (d < 0)
+                            break;
+                        value = (value * 16) + d;
                     }
 
-                    if (i !== 2)
-                    {
-                        c = LOWER_X_CH;
-                    }
-                    else
+                    if (k === num_digits)
                     {
-                        this.advance(2);
-                        c = value;
-                    }
-                }
-                else if (c === LOWER_U_CH)
-                {
-                    // Parse \uXXXX string syntax
-                    var value = 0, i = 0;
-
-                    for (; i < 4; ++i)
-                    {
-                        var hc = this.lookahead_char(i);
-
-                        if (hc >= LOWER_A_CH && hc <= LOWER_F_CH)
-                            value = (value * 16) + (hc - 87);
-                        else if (hc >= UPPER_A_CH && hc <= UPPER_F_CH)
-                            value = (value * 16) + (hc - 55);
-                        else if (hc >= ZERO_CH && hc <= NINE_CH)
-                            value = (value * 16) + (hc - 48);
-                        else
-                            break;   
-                    }
-
-                    if (i !== 4)
-                    {
-                        c = LOWER_U_CH;
-                    }
-                    else
-                    {
-                        this.advance(4);
+                        i += num_digits;
                         c = value;
                     }
                 }
@@ -757,44 +534,72 @@ Scanner.prototype.parse_string = function ()
         else
             chars.push(c);
     }
+
+    this.index = i;
     var str = String.fromCharCode.apply(null,chars);
     return this.valued_token(STRING_CAT, str, start_pos);
 };
 
+
+// method parse_regexp(pattern)
+//
+// Called by the parser after a division operator token, to scan the
+// rest of a regular expression literal.
+
 Scanner.prototype.parse_regexp = function (pattern)
 {
+    var content = this.content;
+    var length = content.length;
     var flags = [];
+    var i = this.index;
 
-    for (var c = this.lookahead_char(0);
-         c !== SLASH_CH;
-         this.advance(1), c = this.lookahead_char(0))
+    for (;;)
     {
-        if (this.lookahead_char(0) === BACKSLASH_CH &&
-            this.lookahead_char(1) === SLASH_CH)
+        if (i >= length)
+            error("unterminated regular expression");
+        var c = content.charCodeAt(i);
+        if (c === SLASH_CH)
+            break;
+        if (c === LF_CH || c === CR_CH)
         {
-            this.advance(1);
+            pattern.push(LF_CH);
+            i = this.new_line(i);
+            continue;
         }
-        pattern.push(this.lookahead_char(0));
+        if (c === BACKSLASH_CH && i + 1 < length &&
+            content.charCodeAt(i + 1) === SLASH_CH)
+        {
+            i++;
+            c = SLASH_CH;
+        }
+        pattern.push(c);
+        i++;
     }
-    this.advance(1);
+    i++;
 
-    for (var c = this.lookahead_char(0);
-         this.identifier_class(c) || this.decimal_class(c);
-         this.advance(1), c = this.lookahead_char(0))
+    while (i < length)
     {
+        var c = content.charCodeAt(i);
+        if (c >= 128 || scanner_char_class[c] < CC_IDENT ||
+            scanner_char_class[c] > CC_DIGIT)
+            break;
         flags.push(c);
+        i++;
     }
+
+    this.index = i;
     return [String.fromCharCode.apply(null, pattern), String.fromCharCode.apply(null, flags)];
-}
+};
 
 // method simple_token(cat, n)
 
 Scanner.prototype.simple_token = function (cat, n)
 {
+    var start_pos = this.position(this.index);
+    this.index += n;
     var loc = new Location(this.port.filename,
-                           this.lookahead_pos(0),
-                           this.lookahead_pos(n));
-    this.advance(n);
+                           start_pos,
+                           this.position(this.index));
     return new Token(cat, cat, loc);
 };
 
@@ -805,7 +610,7 @@ Scanner.prototype.valued_token = function (cat, value, start_pos)
 {
     var loc = new Location(this.port.filename,
                            start_pos,
-                           this.lookahead_pos(0));
+                           this.position(this.index));
     return new Token(cat, value, loc);
 };
 
@@ -849,31 +654,31 @@ function Location(filename, start_pos, end_pos)
     this.filename  = filename;
     this.start_pos = start_pos;
     this.end_pos   = end_pos;
+}
 
-    // method join(loc1, loc2)
+// method join(loc)
 
-    this.join = function (loc)
-    {
-        return new Location(this.filename, this.start_pos, loc.end_pos);
-    };
+Location.prototype.join = function (loc)
+{
+    return new Location(this.filename, this.start_pos, loc.end_pos);
+};
 
-    // method to_string()
+// method to_string()
 
-    this.to_string = function()
-    {
-        return "\"" + this.filename + "\"@" +
-               position_to_line(this.start_pos) + "." +
-               position_to_column(this.start_pos) +
-               "-" +
-               position_to_line(this.end_pos) + "." +
-               position_to_column(this.end_pos);
-    };
-}
+Location.prototype.to_string = function ()
+{
+    return "\"" + this.filename + "\"@" +
+           position_to_line(this.start_pos) + "." +
+           position_to_column(this.start_pos) +
+           "-" +
+           position_to_line(this.end_pos) + "." +
+           position_to_column(this.end_pos);
+};
 
 Location.prototype.toString = function ()
 {
     return this.to_string();
-}
+};
 
 var NUL_CH         =   0;
 var BS_CH          =   8;
@@ -1205,4 +1010,113 @@ var keyword_hashtable =
 ];
 //END-OF-SCANNER-TABLES
 
+//-----------------------------------------------------------------------------
+
+// Scanner character class table and operator DFA, built from the
+// character codes and token categories above.
+
+// Character classes.
+
+var CC_OTHER  = 0;
+var CC_SPACE  = 1;
+var CC_EOL    = 2;
+var CC_IDENT  = 3;
+var CC_DIGIT  = 4;
+var CC_PUNCT  = 5;
+var CC_QUOTE  = 6;
+var CC_SLASH  = 7;
+var CC_PERIOD = 8;
+
+var scanner_char_class = (function ()
+{
+    var table = new Array(128);
+
+    for (var c = 0; c < 128; c++)
+    {
+        if ((c >= LOWER_A_CH && c <= LOWER_Z_CH) ||
+            (c >= UPPER_A_CH && c <= UPPER_Z_CH) ||
+            c === UNDERSCORE_CH || c === DOLLAR_CH)
+            table[c] = CC_IDENT;
+        else if (c >= ZERO_CH && c <= NINE_CH)
+            table[c] = CC_DIGIT;
+        else if (c === SPACE_CH || c === TAB_CH)
+            table[c] = CC_SPACE;
+        else if (c === LF_CH || c === CR_CH)
+            table[c] = CC_EOL;
+        else if (c === DOUBLEQUOTE_CH || c === QUOTE_CH)
+            table[c] = CC_QUOTE;
+        else if (c === SLASH_CH)
+            table[c] = CC_SLASH;
+        else if (c === PERIOD_CH)
+            table[c] = CC_PERIOD;
+        else
+            table[c] = CC_OTHER;
+    }
+
+    return table;
+})();
+
+
+// Operator DFA.  State 0 is the start state, a transition to state 0
+// means that there is no transition.
+
+var scanner_operators =
+[
+    ["!", EXCL_CAT], ["!=", NE_CAT], ["!==", STRNEQ_CAT],
+    ["%", MOD_CAT], ["%=", MODEQUAL_CAT],
+    ["&", BITAND_CAT], ["&&", AND_CAT], ["&=", BITANDEQUAL_CAT],
+    ["*", MULT_CAT], ["*=", MULTEQUAL_CAT],
+    ["+", PLUS_CAT], ["++", PLUSPLUS_CAT], ["+=", PLUSEQUAL_CAT],
+    ["-", MINUS_CAT], ["--", MINUSMINUS_CAT], ["-=", MINUSEQUAL_CAT],
+    [".", PERIOD_CAT],
+    ["/", DIV_CAT], ["/=", DIVEQUAL_CAT],
+    [":", COLON_CAT],
+    ["=", EQUAL_CAT], ["==", EQEQ_CAT], ["===", STREQ_CAT],
+    ["<", LT_CAT], ["<<", LSHIFT_CAT], ["<<=", LSHIFTEQUAL_CAT],
+    ["<=", LE_CAT],
+    [">", GT_CAT], [">>", RSHIFT_CAT], [">>>", URSHIFT_CAT],
+    [">>>=", URSHIFTEQUAL_CAT], [">>=", RSHIFTEQUAL_CAT],
+    [">=", GE_CAT],
+    ["?", QUESTION_CAT],
+    ["^", BITXOR_CAT], ["^=", BITXOREQUAL_CAT],
+    ["(", LPAREN_CAT], [")", RPAREN_CAT], [",", COMMA_CAT],
+    [";", SEMICOLON_CAT], ["[", LBRACK_CAT], ["]", RBRACK_CAT],
+    ["{", LBRACE_CAT], ["}", RBRACE_CAT], ["~", BITNOT_CAT],
+    ["|", BITOR_CAT], ["||", OR_CAT], ["|=", BITOREQUAL_CAT]
+];
+
+var scanner_op_trans = [];
+var scanner_op_cat = [];
+
+(function ()
+{
+    function new_state()
+    {
+        var state = scanner_op_cat.length;
+        scanner_op_cat.push(-1);
+        for (var c = 0; c < 128; c++)
+            scanner_op_trans.push(0);
+        return state;
+    }
+
+    new_state();
+
+    for (var i = 0; i < scanner_operators.length; i++)
+    {
+        var str = scanner_operators[i][0];
+        var state = 0;
+
+        for (var j = 0; j < str.length; j++)
+        {
+            var k = state * 128 + str.charCodeAt(j);
+            if (scanner_op_trans[k] === 0)
+                scanner_op_trans[k] = new_state();
+            state = scanner_op_trans[k];
+        }
+
+        scanner_op_cat[state] = scanner_operators[i][1];
+    }
+})();
+
+
 //=============================================================================
@@ -245,10 +245,8 @@ else
     */
     var writeToMemoryBlock = function (blockObj, index, byteVal)
     {
-        assert (
-            byteVal >= 0 && byteVal <= 255,
-            "byte value '" + byteVal + "' out of range"
-        );
+        if (!(byteVal >= 0 && byteVal <= 255))
+            error("byte value '" + byteVal + "' out of range");
 
         blockObj[index] = byteVal;
     };
@@ -270,3 +268,28 @@ else
     };
 }
 
+/**
+Allocate a non-executable memory block filled with zeros
+*/
+function allocZeroedBlock(size)
+{
+    var blockObj = allocMemoryBlock(size, false);
+
+    for (var i = 0; i < size; ++i)
+        writeToMemoryBlock(blockObj, i, 0);
+
+    return blockObj;
+}
+
+/**
+Convert an address, given as a little-endian byte array, to a number
+*/
+function addrToNum(addr)
+{
+    var val = 0;
+
+    for (var i = addr.length - 1; i >= 0; --i)
+        val = num_add(num_shift(val, 8), addr[i]);
+
+    return val;
+}
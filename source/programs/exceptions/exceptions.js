@@ -1,30 +1,276 @@
+function thrower(v)
+{
+    throw v;
+}
 
+function passThrough(v)
+{
+    var r = thrower(v);
+    return r + 1;
+}
 
+function catchIn(v)
+{
+    try
+    {
+        thrower(v);
+    }
+    catch (e)
+    {
+        return e + 1;
+    }
 
+    return 0;
+}
 
+function rethrow(v)
+{
+    try
+    {
+        thrower(v);
+    }
+    catch (e)
+    {
+        throw e + 1;
+    }
+}
 
+function noThrow(v)
+{
+    return v;
+}
 
+// Local (intraprocedural) exception
+function test_local()
+{
+    var a = 1;
 
+    try
+    {
+        a = 2;
+        throw 3;
+        a = 4;
+    }
+    catch (e)
+    {
+        if (e !== 3)
+            return 1;
+        if (a !== 2)
+            return 2;
 
-// TODO: local (intraprocedural) exception tests
+        a = 5;
+    }
 
+    if (a !== 5)
+        return 3;
 
-// TODO: test catch scope properties
+    // Try block without any exception-producing instruction
+    try
+    {
+        a = 6;
+    }
+    catch (e)
+    {
+        a = 7;
+    }
 
+    if (a !== 6)
+        return 4;
 
-// TODO: can't escape finally block with return
-// What about throw?
+    return 0;
+}
 
+// Exception thrown across multiple stack frames
+function test_interproc()
+{
+    var x = 7;
 
-// TODO: test exceptions with break, switch, etc.
+    try
+    {
+        var y = passThrough(x);
+        return 1;
+    }
+    catch (e)
+    {
+        if (e !== 7)
+            return 2;
+        if (x !== 7)
+            return 3;
+    }
 
+    if (catchIn(3) !== 4)
+        return 4;
 
-function test()
+    return 0;
+}
+
+// Nested try blocks and rethrowing
+function test_nested()
+{
+    var r = 0;
+
+    try
+    {
+        try
+        {
+            rethrow(1);
+        }
+        catch (e)
+        {
+            if (e !== 2)
+                return 1;
+
+            r += e;
+
+            throw e + 1;
+        }
+    }
+    catch (e)
+    {
+        if (e !== 3)
+            return 2;
+
+        r += e;
+    }
+
+    if (r !== 5)
+        return 3;
+
+    return 0;
+}
+
+// Catch scope properties
+function test_scope()
 {
+    var e = 'outer';
 
+    try
+    {
+        thrower('inner');
+    }
+    catch (e)
+    {
+        if (e !== 'inner')
+            return 1;
 
+        e = 'modified';
+    }
 
+    if (e !== 'outer')
+        return 2;
+
+    // Catch variable captured by a closure
+    var f;
+    try
+    {
+        thrower(11);
+    }
+    catch (v)
+    {
+        f = function () { return v; };
+    }
+
+    if (f() !== 11)
+        return 3;
 
     return 0;
 }
 
+// Finally clauses
+function test_finally()
+{
+    var r = 0;
+
+    try
+    {
+        r = noThrow(1);
+    }
+    catch (e)
+    {
+        return 1;
+    }
+    finally
+    {
+        r += 10;
+    }
+
+    if (r !== 11)
+        return 2;
+
+    try
+    {
+        try
+        {
+            thrower(5);
+        }
+        finally
+        {
+            r += 100;
+        }
+    }
+    catch (e)
+    {
+        if (e !== 5)
+            return 3;
+    }
+
+    if (r !== 111)
+        return 4;
+
+    return 0;
+}
+
+// Exceptions inside loops
+function test_loop()
+{
+    var sum = 0;
+
+    for (var i = 0; i < 10; ++i)
+    {
+        try
+        {
+            if (i % 2 === 0)
+                thrower(i);
+
+            sum += 1;
+        }
+        catch (e)
+        {
+            sum += e;
+        }
+    }
+
+    if (sum !== 25)
+        return 1;
+
+    return 0;
+}
+
+function test()
+{
+    var r = test_local();
+    if (r !== 0)
+        return 100 + r;
+
+    var r = test_interproc();
+    if (r !== 0)
+        return 200 + r;
+
+    var r = test_nested();
+    if (r !== 0)
+        return 300 + r;
+
+    var r = test_scope();
+    if (r !== 0)
+        return 400 + r;
+
+    var r = test_finally();
+    if (r !== 0)
+        return 500 + r;
+
+    var r = test_loop();
+    if (r !== 0)
+        return 600 + r;
+
+    return 0;
+}
@@ -152,7 +152,9 @@ function walk_it(verb)
 
 function f_caller(verb)
 {
-    return walk_it(verb);
+    // Not a tail call, so that this frame remains on the stack
+    var n = walk_it(verb);
+    return n + 0;
 }
 
 function f_many_args(verb, a1, a2, a3, a4, a5)
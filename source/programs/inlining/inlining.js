@@ -0,0 +1,132 @@
+/* _________________________________________________________________________
+ *
+ *             Tachyon : A Self-Hosted JavaScript Virtual Machine
+ *
+ *
+ *  This file is part of the Tachyon JavaScript project. Tachyon is
+ *  distributed at:
+ *  http://github.com/Tachyon-Team/Tachyon
+ *
+ *
+ *  Copyright (c) 2011, Universite de Montreal
+ *  All rights reserved.
+ *
+ *  This software is licensed under the following license (Modified BSD
+ *  License):
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the Universite de Montreal nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL UNIVERSITE DE
+ *  MONTREAL BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * _________________________________________________________________________
+ */
+
+function sq(x)
+{
+    return x * x;
+}
+
+function sumSq(n)
+{
+    var s = 0;
+
+    for (var i = 0; i < n; ++i)
+        s += sq(i);
+
+    return s;
+}
+
+function fact(n)
+{
+    if (n <= 1)
+        return 1;
+
+    return n * fact(n - 1);
+}
+
+function twice(x)
+{
+    return sq(sq(x));
+}
+
+// Too large to be inlined, called directly
+function bigSum(a, b, c)
+{
+    if (c === undefined)
+        c = 0;
+
+    var s = 0;
+
+    for (var i = 0; i < 4; ++i)
+    {
+        if (i % 2 === 0)
+            s += a * i;
+        else
+            s += b * i;
+
+        if (s > 1000)
+            s -= 1000;
+        if (s < -1000)
+            s += 1000;
+    }
+
+    return s + c;
+}
+
+function test()
+{
+    if (sumSq(10) !== 285)
+        return 1;
+
+    if (fact(6) !== 720)
+        return 2;
+
+    if (twice(3) !== 81)
+        return 3;
+
+    // Redefining the callee makes the inlined call guards fail
+    var oldSq = sq;
+    sq = function (x) { return x + 1; };
+    var r = sumSq(3);
+    sq = oldSq;
+
+    if (r !== 6)
+        return 4;
+
+    // Direct calls with missing and extra arguments
+    if (bigSum(1, 2) !== 10)
+        return 5;
+
+    if (bigSum(1, 2, 3, 4) !== 13)
+        return 6;
+
+    // Redefining the callee makes the direct call guards fail
+    var oldBigSum = bigSum;
+    bigSum = function (a, b) { return a - b; };
+    r = bigSum(1, 2);
+    bigSum = oldBigSum;
+
+    if (r !== -1)
+        return 7;
+
+    return 0;
+}
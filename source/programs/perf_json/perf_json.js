@@ -0,0 +1,97 @@
+/**
+JSON parsing and serialization performance test, on documents shaped
+like the responses of a web service: arrays of records with nested
+objects, arrays, strings with escapes, numbers and booleans.
+*/
+
+var NAMES = ["alice", "bob", "carol", "dave", "eve", "mallory", "trent"];
+var TAGS = ["red", "green", "blue", "urgent", "archived", "draft"];
+
+function makeRecord(i)
+{
+    var tags = [];
+    for (var j = 0; j < i % 4; ++j)
+        tags.push(TAGS[(i + j) % TAGS.length]);
+
+    return {
+        id: i,
+        name: NAMES[i % NAMES.length] + i,
+        email: NAMES[i % NAMES.length] + "@example.com",
+        active: (i % 3) !== 0,
+        score: (i * 7919) % 1000,
+        note: "line \"" + i + "\"\n\ttabbed\\path",
+        tags: tags,
+        address: {
+            street: i + " Main Street",
+            city: NAMES[(i + 3) % NAMES.length] + "ville",
+            zip: 10000 + i,
+            geo: { lat: i % 90, lng: -(i % 180) }
+        },
+        parent: (i > 0)? i - 1:null
+    };
+}
+
+function makeDocument(numRecords)
+{
+    var records = [];
+    for (var i = 0; i < numRecords; ++i)
+        records.push(makeRecord(i));
+
+    return {
+        version: 3,
+        count: numRecords,
+        records: records
+    };
+}
+
+function bench(numRecords, numIters)
+{
+    var text = JSON.stringify(JSON.parse(JSON.stringify(
+        makeDocument(numRecords)
+    )));
+
+    var t0 = currentTimeMillis();
+    for (var i = 0; i < numIters; ++i)
+        var doc = JSON.parse(text);
+    var t1 = currentTimeMillis();
+    for (var i = 0; i < numIters; ++i)
+        var out = JSON.stringify(doc);
+    var t2 = currentTimeMillis();
+
+    print(
+        "json: " + text.length + " chars, parse " + (t1 - t0) +
+        " ms, stringify " + (t2 - t1) + " ms"
+    );
+
+    return (out === text)? 0:1;
+}
+
+function test()
+{
+    var text = JSON.stringify(makeDocument(50));
+    var doc = JSON.parse(text);
+
+    if (doc.count !== 50 || doc.records.length !== 50)
+        return 1;
+
+    var r = doc.records[41];
+
+    if (r.id !== 41 || r.name !== "trent41" || r.active !== true)
+        return 2;
+    if (r.note !== "line \"41\"\n\ttabbed\\path")
+        return 3;
+    if (r.tags.length !== 1 || r.tags[0] !== "draft")
+        return 4;
+    if (r.address.geo.lng !== -41 || r.address.zip !== 10041)
+        return 5;
+    if (doc.records[0].parent !== null)
+        return 6;
+
+    // Property order follows the hash tables, so compare the text of
+    // parsed documents only
+    var text2 = JSON.stringify(doc);
+    if (JSON.stringify(JSON.parse(text2)) !== text2)
+        return 7;
+
+    return 0;
+}
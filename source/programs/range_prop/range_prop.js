@@ -0,0 +1,203 @@
+/* _________________________________________________________________________
+ *
+ *             Tachyon : A Self-Hosted JavaScript Virtual Machine
+ *
+ *
+ *  This file is part of the Tachyon JavaScript project. Tachyon is
+ *  distributed at:
+ *  http://github.com/Tachyon-Team/Tachyon
+ *
+ *
+ *  Copyright (c) 2011, Universite de Montreal
+ *  All rights reserved.
+ *
+ *  This software is licensed under the following license (Modified BSD
+ *  License):
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the Universite de Montreal nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL UNIVERSITE DE
+ *  MONTREAL BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * _________________________________________________________________________
+ */
+
+/**
+Count up to a bound. The increment of the counter cannot overflow
+since the counter is below the bound.
+*/
+function count_up(start, end)
+{
+    var i = start;
+
+    for (;;)
+    {
+        if (iir.if_lt(i, end))
+        {
+            var r;
+            if (r = iir.add_ovf(i, 1))
+                i = r;
+            else
+                return -1;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/**
+Count up to a bound by steps of two. The increment of the counter may
+overflow when the bound is near the maximum integer value.
+*/
+function count_up2(start, end)
+{
+    var i = start;
+
+    for (;;)
+    {
+        if (iir.if_lt(i, end))
+        {
+            var r;
+            if (r = iir.add_ovf(i, 2))
+                i = r;
+            else
+                return -1;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/**
+Count down to a bound. The decrement of the counter cannot overflow
+since the counter is above the bound.
+*/
+function count_down(start, end)
+{
+    var i = start;
+
+    for (;;)
+    {
+        if (iir.if_gt(i, end))
+        {
+            var r;
+            if (r = iir.sub_ovf(i, 1))
+                i = r;
+            else
+                return 1;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/**
+Repeated integer tag test and comparison on the same values
+*/
+function repeat_tests(v, n)
+{
+    if (boxIsInt(v) && boxIsInt(n))
+    {
+        if (iir.if_lt(v, n))
+        {
+            if (boxIsInt(v) === false)
+                return 1;
+
+            if (iir.if_ge(v, n))
+                return 2;
+
+            return 3;
+        }
+
+        return 4;
+    }
+
+    return 5;
+}
+
+/**
+Find the largest boxed integer value
+*/
+function max_int()
+{
+    var m = 1;
+
+    for (;;)
+    {
+        var r;
+        if (r = iir.add_ovf(m, m))
+            m = r;
+        else
+            break;
+    }
+
+    return (m - 1) + m;
+}
+
+function test()
+{
+    const MAX_INT = max_int();
+    const MIN_INT = -MAX_INT - 1;
+
+    if (count_up(0, 10) !== 10)
+        return 1;
+
+    if (count_up(MAX_INT - 3, MAX_INT) !== MAX_INT)
+        return 2;
+
+    // The counter steps over the bound, this must overflow
+    if (count_up2(MAX_INT - 3, MAX_INT) !== -1)
+        return 3;
+
+    if (count_down(10, 0) !== 0)
+        return 4;
+
+    if (count_down(MIN_INT + 3, MIN_INT) !== MIN_INT)
+        return 5;
+
+    if (repeat_tests(1, 2) !== 3)
+        return 6;
+
+    if (repeat_tests(2, 1) !== 4)
+        return 7;
+
+    if (repeat_tests('a', 1) !== 5)
+        return 8;
+
+    return 0;
+}
+
+function proxy()
+{
+    return test();
+}
@@ -0,0 +1,193 @@
+/* _________________________________________________________________________
+ *
+ *             Tachyon : A Self-Hosted JavaScript Virtual Machine
+ *
+ *
+ *  This file is part of the Tachyon JavaScript project. Tachyon is
+ *  distributed at:
+ *  http://github.com/Tachyon-Team/Tachyon
+ *
+ *
+ *  Copyright (c) 2011, Universite de Montreal
+ *  All rights reserved.
+ *
+ *  This software is licensed under the following license (Modified BSD
+ *  License):
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the Universite de Montreal nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL UNIVERSITE DE
+ *  MONTREAL BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * _________________________________________________________________________
+ */
+/**
+Object literal whose properties are only read and written locally.
+*/
+function local_obj(a, b)
+{
+    var v = { x: a, y: b };
+
+    v.x = v.x + v.y;
+
+    return v.x * v.y;
+}
+
+/**
+Object properties written in different branches and in a loop.
+*/
+function branch_loop(n, c)
+{
+    var v = { sum: 0, last: 0 };
+
+    if (c)
+        v.last = 1;
+    else
+        v.last = 2;
+
+    for (var i = 0; i < n; ++i)
+    {
+        v.sum = v.sum + v.last;
+        v.last = i;
+    }
+
+    return v.sum + v.last;
+}
+
+function vec_add(a, b)
+{
+    return { x: a.x + b.x, y: a.y + b.y };
+}
+
+function vec_dot(a, b)
+{
+    return a.x * b.x + a.y * b.y;
+}
+
+/**
+Short-lived vector objects allocated in a loop.
+*/
+function vec_loop(n)
+{
+    var s = 0;
+
+    for (var i = 0; i < n; ++i)
+    {
+        var u = { x: i, y: 1 };
+        var w = { x: 2, y: i };
+        s += vec_dot(u, w);
+    }
+
+    return s;
+}
+
+/**
+A property which may not have been written is read from the prototype.
+*/
+function maybe_absent(c)
+{
+    var v = {};
+
+    if (c)
+        v.foo = 3;
+
+    return v.foo;
+}
+
+var glob = null;
+
+/**
+An object stored in a global escapes.
+*/
+function escapes(a)
+{
+    var v = { x: a };
+
+    glob = v;
+
+    v.x = a + 1;
+
+    return glob.x;
+}
+
+/**
+Object accesses inside a try block.
+*/
+function in_try(a)
+{
+    var v = { x: a };
+
+    try
+    {
+        v.x = v.x + 1;
+        thrower(v.x);
+        v.x = 0;
+    }
+    catch (e)
+    {
+        return v.x + e;
+    }
+
+    return -1;
+}
+
+function thrower(v)
+{
+    throw v;
+}
+
+function test()
+{
+    if (local_obj(2, 3) !== 15)
+        return 1;
+
+    if (branch_loop(0, true) !== 1)
+        return 2;
+
+    if (branch_loop(4, false) !== 8)
+        return 3;
+
+    if (vec_loop(5) !== 30)
+        return 4;
+
+    if (maybe_absent(true) !== 3)
+        return 5;
+
+    if (maybe_absent(false) !== undefined)
+        return 6;
+
+    if (escapes(4) !== 5 || glob.x !== 5)
+        return 7;
+
+    if (in_try(3) !== 8)
+        return 8;
+
+    if (vec_dot(vec_add({ x: 1, y: 2 }, { x: 3, y: 4 }), { x: 1, y: 1 }) !== 10)
+        return 9;
+
+    // Objects are allocated on the slow path of the inlined call
+    vec_dot = function (a, b) { return a.x + b.y; };
+    if (vec_loop(3) !== 6)
+        return 10;
+
+    return 0;
+}
+
@@ -133,6 +133,14 @@ function test_parse ()
         return 22;
     if (!equal({"a": {"b": 1, "c": 2}, "d": {"e" : {"f": 3}}}, JSON.parse('{"a": {"b": 1, "c": 2}, "d": {"e" : {"f": 3}}}')))
         return 23;
+    if (!equal("A\u00e9/", JSON.parse('"\\u0041\\u00e9\\/"')))
+        return 24;
+    if (!equal({"a b": [[], {}, [{}]], "c": -12}, JSON.parse(' { "a b" : [ [ ] , { } , [ { } ] ] , "c" : -12 } ')))
+        return 25;
+    if (JSON.parse('[1, 2') !== undefined)
+        return 26;
+    if (JSON.parse('{"a" 1}') !== undefined)
+        return 27;
     return 0;
 }
 
@@ -177,6 +185,14 @@ function test_stringify ()
     if ('["a","ab","abc"]' !== JSON.stringify(["a","ab","abc"]))
         return 19;
 
+    var o = {x: 1};
+    if ('{"a":{"x":1},"b":{"x":1}}' !== JSON.stringify({a: o, b: o}))
+        return 20;
+    if ('{"a":1,"c":[null]}' !== JSON.stringify({a: 1, b: undefined, c: [undefined]}))
+        return 21;
+    if ("{\n \"a\": {\n  \"b\": []\n }\n}" !== JSON.stringify({a: {b: []}}, null, 1))
+        return 22;
+
     return 0;
 }
 
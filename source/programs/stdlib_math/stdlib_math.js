@@ -129,6 +129,28 @@ function test_pow()
     return 0;
 }
 
+function test_sqrt()
+{
+    if (Math.sqrt(0) !== 0)
+        return 1;
+    if (Math.sqrt(1) !== 1)
+        return 2;
+    if (Math.sqrt(4) !== 2)
+        return 3;
+    if (Math.sqrt(144) !== 12)
+        return 4;
+    if (Math.sqrt(268435456) !== 16384)
+        return 5;
+
+    var sum = 0;
+    for (var i = 0; i < 100; ++i)
+        sum += Math.sqrt(i * i);
+    if (sum !== 4950)
+        return 6;
+
+    return 0;
+}
+
 function test()
 {
     var r = test_abs();
@@ -155,6 +177,10 @@ function test()
     if (r !== 0)
         return 600 + r;
 
+    var r = test_sqrt();
+    if (r !== 0)
+        return 700 + r;
+
     return 0;
 }
 
@@ -212,6 +212,45 @@ function test_backreference ()
 
 }
 
+function test_compiled ()
+{
+    if (new RegExp("b+c").test("aaabbbc") !== true)
+        return 1;
+    if (new RegExp("b+c").test("aaabbb") !== null)
+        return 2;
+    if (new RegExp("[bef]+z", "i").test("xxBEEFz") !== true)
+        return 3;
+    if (!check_equal_matches(new RegExp("foo(b)ar").exec("fofoo foobar"), ["foobar", "b"]))
+        return 4;
+    if (!check_equal_matches(new RegExp("^foo").exec("xfoo"), null))
+        return 5;
+    if (!check_equal_matches(new RegExp("x*").exec(""), [""]))
+        return 6;
+
+    // Cached patterns are shared by every RegExp with the same source
+    var a = new RegExp("(a+)(b+)");
+    var b = new RegExp("(a+)(b+)");
+    if (!check_equal_matches(a.exec("xaab"), ["aab", "aa", "b"]))
+        return 7;
+    if (!check_equal_matches(b.exec("abbb"), ["abbb", "a", "bbb"]))
+        return 8;
+
+    // Too many DFA states, falls back to backtracking
+    var r = new RegExp("(a|b)*a(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)");
+    if (r.test("bbbbabbbbbbbbbb") !== true)
+        return 9;
+    if (r.test("bbbbbbbbbbabbbb") !== null)
+        return 10;
+
+    // Global patterns update lastIndex
+    var g = new RegExp("o+", "g");
+    if (!check_equal_matches(g.exec("foo boo"), ["oo"]) || g.lastIndex !== 3)
+        return 11;
+    if (g.test("foo boo") !== true || g.lastIndex !== 7)
+        return 12;
+    return 0;
+}
+
 function test ()
 {
     var r;
@@ -244,5 +283,9 @@ function test ()
     if (r !== 0)
         return 700 + r;
 
+    r = test_compiled();
+    if (r !== 0)
+        return 800 + r;
+
     return 0;
 }
@@ -160,6 +160,37 @@ function test_indexOf()
         return 3;
     if ('foo'.indexOf('a') != -1)
         return 4;
+    if ('foo'.indexOf('o', 2) != 2)
+        return 5;
+    if ('foo'.indexOf('', 5) != 3)
+        return 6;
+
+    // Long strings, scanned a word at a time and searched with skips
+    var s = 'abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz';
+    if (s.indexOf('z') != 25)
+        return 7;
+    if (s.indexOf('z', 26) != 61)
+        return 8;
+    if (s.indexOf('9') != 35)
+        return 9;
+    if (s.indexOf('xyz0') != 23)
+        return 10;
+    if (s.indexOf('xyz', 24) != 59)
+        return 11;
+    if (s.indexOf('xyza') != -1)
+        return 12;
+    if ('aaaaaaaaaaaaaaab'.indexOf('aab') != 13)
+        return 13;
+    if ('ab\u0142cd\u0142ef'.indexOf('\u0142e') != 5)
+        return 14;
+    if ('ab\u0142cd\u0142ef'.indexOf('\u0143') != -1)
+        return 15;
+    if ('foo'.indexOf('f', null) != 0)
+        return 16;
+    if ('foo'.indexOf('o', '2') != 2)
+        return 17;
+    if ('foo'.indexOf('f', 'bar') != 0)
+        return 18;
 
     return 0;
 }
@@ -174,6 +205,28 @@ function test_lastIndexOf()
         return 3;
     if ('foo'.lastIndexOf('a') != -1)
         return 4;
+    if ('foo'.lastIndexOf('o', 1) != 1)
+        return 5;
+    if ('foo'.lastIndexOf('', 1) != 1)
+        return 6;
+
+    var s = 'abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz';
+    if (s.lastIndexOf('abc') != 36)
+        return 7;
+    if (s.lastIndexOf('abc', 35) != 0)
+        return 8;
+    if (s.lastIndexOf('z0') != 25)
+        return 9;
+    if (s.lastIndexOf('zz') != -1)
+        return 10;
+    if ('baaaaaaaaaaaaaaa'.lastIndexOf('baa') != 0)
+        return 11;
+    if ('foo'.lastIndexOf('o', null) != -1)
+        return 12;
+    if ('foo'.lastIndexOf('o', '1') != 1)
+        return 13;
+    if ('foo'.lastIndexOf('o', 'bar') != 2)
+        return 14;
 
     return 0;
 }
@@ -278,6 +331,15 @@ function test_replace()
     
     if ('foobar foobar'.replace(/\bf/g, "$'") !== 'oobar foobaroobar oobaroobar')
         return 1;
+
+    if ('foobar'.replace('baz', 'bif') !== 'foobar')
+        return 2;
+
+    if ('foobarbar'.replace('bar', '') !== 'foobar')
+        return 3;
+
+    if ('foobar'.replace('o', function (s, i) { return s + i; }) !== 'fo1obar')
+        return 4;
                             
     return 0;
 }
@@ -314,6 +376,24 @@ function test_split()
     if (!array_eq('foo,bar,bif'.split(), ['foo,bar,bif']))
         return 6;
 
+    if (!array_eq('foo, bar, bif'.split(', '), ['foo','bar','bif']))
+        return 7;
+
+    if (!array_eq(',foo,,bar,'.split(','), ['','foo','','bar','']))
+        return 8;
+
+    if (!array_eq('foo'.split(''), ['f','o','o']))
+        return 9;
+
+    if (!array_eq('foo'.split('', 2), ['f','o']))
+        return 10;
+
+    if (!array_eq(''.split(','), ['']))
+        return 11;
+
+    if (!array_eq('foo'.split('bar'), ['foo']))
+        return 12;
+
     return 0;
 }
 
@@ -345,6 +425,110 @@ function test_fromCharCode()
     return 0;
 }
 
+function test_compare()
+{
+    if (!('abc' < 'abd'))
+        return 1;
+
+    if (!('ab' < 'abc'))
+        return 2;
+
+    if (!('abc' > 'ab'))
+        return 3;
+
+    if ('abcdefghij' >= 'abcdefghik')
+        return 4;
+
+    if (!('abcdefghij' <= 'abcdefghij'))
+        return 5;
+
+    if ('abcdefghij' + 'k' !== 'abcdefghijk')
+        return 6;
+
+    if ('abcdefgh' + 'ij' === 'abcdefgh' + 'ik')
+        return 7;
+
+    return 0;
+}
+
+// Text of a given number of words, used by the search benchmarks
+function bench_text(numWords)
+{
+    var words = ['lorem', 'ipsum', 'dolor', 'sit', 'amet'];
+
+    var parts = new Array(numWords);
+    for (var i = 0; i < numWords; ++i)
+        parts[i] = words[i % words.length];
+
+    return parts.join(' ');
+}
+
+function bench_indexOf(numWords)
+{
+    var text = bench_text(numWords) + ' needle';
+
+    var r = 0;
+    for (var i = 0; i < 20; ++i)
+    {
+        r += text.indexOf('needle');
+        r += text.indexOf('!');
+    }
+
+    return r;
+}
+
+function bench_lastIndexOf(numWords)
+{
+    var text = 'needle ' + bench_text(numWords);
+
+    var r = 0;
+    for (var i = 0; i < 20; ++i)
+    {
+        r += text.lastIndexOf('needle');
+        r += text.lastIndexOf('!');
+    }
+
+    return r;
+}
+
+function bench_split(numWords)
+{
+    var text = bench_text(numWords);
+
+    var r = 0;
+    for (var i = 0; i < 5; ++i)
+        r += text.split(' ').length;
+
+    return r;
+}
+
+function bench_replace(numWords)
+{
+    var text = bench_text(numWords) + ' needle';
+
+    var r = 0;
+    for (var i = 0; i < 5; ++i)
+        r += text.replace('needle', 'thread').length;
+
+    return r;
+}
+
+function bench_intern(numStrs)
+{
+    var obj = {};
+
+    // Create and intern many distinct strings
+    for (var i = 0; i < numStrs; ++i)
+        obj['some_property_key_' + i] = i;
+
+    // Intern the same strings again and use them as keys
+    var r = 0;
+    for (var i = 0; i < numStrs; ++i)
+        r += obj['some_property_key_' + i];
+
+    return r;
+}
+
 function test()
 {
     var r = test_lit();
@@ -423,6 +607,10 @@ function test()
     if (r != 0)
         return 1900 + r;
 
+    var r = test_compare();
+    if (r != 0)
+        return 2000 + r;
+
     return 0;
 }
 
@@ -0,0 +1,114 @@
+/* _________________________________________________________________________
+ *
+ *             Tachyon : A Self-Hosted JavaScript Virtual Machine
+ *
+ *
+ *  This file is part of the Tachyon JavaScript project. Tachyon is
+ *  distributed at:
+ *  http://github.com/Tachyon-Team/Tachyon
+ *
+ *
+ *  Copyright (c) 2011, Universite de Montreal
+ *  All rights reserved.
+ *
+ *  This software is licensed under the following license (Modified BSD
+ *  License):
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the Universite de Montreal nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL UNIVERSITE DE
+ *  MONTREAL BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * _________________________________________________________________________
+ */
+
+// Self tail call, compiled to a loop
+function sum_to(n, acc)
+{
+    if (n === 0)
+        return acc;
+
+    return sum_to(n - 1, acc + n);
+}
+
+// Mutually recursive tail calls
+function is_even(n)
+{
+    if (n === 0)
+        return true;
+
+    return is_odd(n - 1);
+}
+
+function is_odd(n)
+{
+    if (n === 0)
+        return false;
+
+    return is_even(n - 1);
+}
+
+// Self tail call passing the arguments in a different order
+function rotate(n, a, b, c, d, e, f, g)
+{
+    if (n === 0)
+        return a + 2*b + 3*c + 4*d + 5*e + 6*f + 7*g;
+
+    return rotate(n - 1, g, a, b, c, d, e, f);
+}
+
+// Self tail call with missing arguments
+function count_down(n, acc)
+{
+    if (acc === undefined)
+        acc = 0;
+
+    if (n === 0)
+        return acc;
+
+    if (n % 2 === 0)
+        return count_down(n - 1);
+
+    return count_down(n - 1, acc + 1);
+}
+
+function test()
+{
+    if (sum_to(1000000, 0) !== 500000500000)
+        return 1;
+
+    if (is_even(1000000) !== true)
+        return 2;
+
+    if (is_odd(1000001) !== true)
+        return 3;
+
+    if (rotate(1000000, 1, 2, 3, 4, 5, 6, 7) !== 119)
+        return 4;
+
+    if (rotate(1000001, 1, 2, 3, 4, 5, 6, 7) !== 105)
+        return 5;
+
+    if (count_down(10, 0) !== 1)
+        return 6;
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+/* _________________________________________________________________________
+ *
+ *             Tachyon : A Self-Hosted JavaScript Virtual Machine
+ *
+ *
+ *  This file is part of the Tachyon JavaScript project. Tachyon is
+ *  distributed at:
+ *  http://github.com/Tachyon-Team/Tachyon
+ *
+ *
+ *  Copyright (c) 2011, Universite de Montreal
+ *  All rights reserved.
+ *
+ *  This software is licensed under the following license (Modified BSD
+ *  License):
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the Universite de Montreal nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL UNIVERSITE DE
+ *  MONTREAL BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * _________________________________________________________________________
+ */
+
+// Mutually recursive functions calling each other directly through their
+// function pointers, with stack arguments passed in a different order
+function ping(n, a, b, c, d, e, f, g)
+{
+    if (n === 0)
+        return a + 2*b + 3*c + 4*d + 5*e + 6*f + 7*g;
+
+    var funcPtr = get_clos_funcptr(pong);
+
+    return iir.call(funcPtr, pong, UNDEFINED, n - 1, g, a, b, c, d, e, f);
+}
+
+function pong(n, a, b, c, d, e, f, g)
+{
+    if (n === 0)
+        return a + 2*b + 3*c + 4*d + 5*e + 6*f + 7*g;
+
+    var funcPtr = get_clos_funcptr(ping);
+
+    return iir.call(funcPtr, ping, UNDEFINED, n - 1, b, c, d, e, f, g, a);
+}
+
+function test()
+{
+    if (ping(11, 1, 2, 3, 4, 5, 6, 7) !== 119)
+        return 1;
+
+    if (ping(1000001, 1, 2, 3, 4, 5, 6, 7) !== 119)
+        return 2;
+
+    return 0;
+}
@@ -90,13 +90,23 @@ function compileAndRunSrcs(srcFiles, funcName, inputArgs, compParams)
         'invalid compilation parameters'
     );
 
+    // If the code is specialized using a type analysis, analyze all
+    // the source files before compiling them
+    var taUnits;
+    if (params.typeSpec instanceof TypeSpec)
+        taUnits = params.typeSpec.analyzeFiles(srcFiles, params);
+
     // For each source file
     for (var i = 0; i < srcFiles.length; ++i)
     {
         var srcFile = srcFiles[i];
 
         // Compile the unit
-        var ir = compileSrcFile(srcFile, params);
+        var ir;
+        if (taUnits !== undefined)
+            ir = compileUnit(taUnits[i], params);
+        else
+            ir = compileSrcFile(srcFile, params);
 
         // Create a bridge to execute this unit
         var unitBridge = makeBridge(
@@ -289,6 +299,189 @@ tests.programs.basic_opts = genProgTest(
     'hostParams'
 );
 
+/**
+Test of the removal of overflow checks and tests using value ranges.
+*/
+tests.programs.range_prop = genProgTest(
+    'programs/range_prop/range_prop.js',
+    'proxy',
+    [],
+    0,
+    'hostParams'
+);
+
+/**
+Test of the scalar replacement of objects which do not escape.
+*/
+tests.programs.scalar_repl = genProgTest(
+    'programs/scalar_repl/scalar_repl.js',
+    'test',
+    [],
+    0
+);
+
+/**
+Test of the inlining of calls to known functions.
+*/
+tests.programs.inlining = function ()
+{
+    config.hostParams.inlineReport = [];
+
+    try
+    {
+        var result = compileAndRunSrcs(
+            ['programs/inlining/inlining.js'],
+            'test',
+            [],
+            'hostParams'
+        );
+
+        assert (
+            result === 0,
+            'Invalid return value "' + result + '", expected "0"'
+        );
+
+        var report = config.hostParams.inlineReport.join('\n');
+
+        assert (
+            report.indexOf('sumSq -> sq (loop depth 1): inlined') !== -1 &&
+            report.indexOf('fact -> fact (loop depth 0): inlined') !== -1 &&
+            report.indexOf('recursion limit, direct call') !== -1 &&
+            report.indexOf('test -> bigSum (loop depth 0): not inlined, ' +
+                           'callee too large') !== -1,
+            'unexpected inlining decisions:\n' + report
+        );
+    }
+
+    finally
+    {
+        config.hostParams.inlineReport = null;
+    }
+};
+
+/**
+Test of type feedback collection, speculation, OSR and deoptimization.
+*/
+tests.programs.type_feedback = function ()
+{
+    var feedback = new TypeFeedback();
+    feedback.hotThreshold = 10;
+    feedback.deoptThreshold = 0;
+    feedback.osrThreshold = 50;
+
+    // Get the feedback of the site in the plus function
+    function getPlusSite()
+    {
+        for (var funcKey in feedback.funcs)
+            if (funcKey.indexOf('plus@') === 0)
+                return feedback.funcs[funcKey][0];
+
+        return undefined;
+    }
+
+    // Compile and run the program in the next tier
+    function runTier(useStrings)
+    {
+        var result = compileAndRunSrcs(
+            ['programs/type_feedback/type_feedback.js'],
+            'test',
+            [useStrings],
+            'hostParams'
+        );
+
+        assert (
+            result === 0,
+            'Invalid return value "' + result + '", expected "0"'
+        );
+
+        feedback.collect();
+    }
+
+    config.hostParams.typeFeedback = feedback;
+
+    // Keep the plus function from being inlined into its callers
+    var maxInlineDepth = inlineCalls.MAX_INLINE_DEPTH;
+    inlineCalls.MAX_INLINE_DEPTH = 0;
+
+    try
+    {
+        // Baseline tier, only integers are seen
+        runTier(0);
+
+        var site = getPlusSite();
+        assert (
+            site !== undefined && site.hits === 20 && site.fails === 0,
+            'invalid baseline feedback'
+        );
+
+        // The loops running past the OSR threshold were versioned
+        assert (
+            feedback.numOsrLoops > 0,
+            'no loops versioned for OSR'
+        );
+
+        // Speculative tier, the string addition fails the guard
+        var numSpec = feedback.numSpec;
+        runTier(1);
+
+        assert (
+            feedback.numSpec > numSpec && site.fails === 1 &&
+            site.deopt === true,
+            'guard failure not recorded'
+        );
+
+        // The deoptimized site goes back to the baseline tier
+        runTier(1);
+
+        assert (
+            site.hits === 41 && site.fails === 1,
+            'site not deoptimized'
+        );
+    }
+
+    finally
+    {
+        config.hostParams.typeFeedback = null;
+        inlineCalls.MAX_INLINE_DEPTH = maxInlineDepth;
+    }
+};
+
+/**
+Test of code specialization using static type analysis results.
+*/
+tests.programs.type_spec = function ()
+{
+    var typeSpec = new TypeSpec(new TypeProp());
+
+    config.hostParams.typeSpec = typeSpec;
+
+    try
+    {
+        var result = compileAndRunSrcs(
+            ['programs/type_spec/type_spec.js'],
+            'test',
+            [],
+            'hostParams'
+        );
+    }
+
+    finally
+    {
+        config.hostParams.typeSpec = null;
+    }
+
+    assert (
+        result === 0,
+        'Invalid return value "' + result + '", expected "0"'
+    );
+
+    assert (
+        typeSpec.numProven > 0 && typeSpec.numGuarded > 0 &&
+        typeSpec.numCallees > 0,
+        'no sites specialized'
+    );
+};
+
 /**
 Test of assignment expressions.
 */
@@ -566,6 +759,47 @@ tests.programs.exceptions = genProgTest(
     0
 );
 
+/**
+Calls inside try blocks
+*/
+tests.programs.exc_calls = genProgTest(
+    'programs/exc_calls/exc_calls.js',
+    'try_calls',
+    [100],
+    4950
+);
+
+/**
+Exceptions thrown and caught in a loop
+*/
+tests.programs.exc_throw = genProgTest(
+    'programs/exc_calls/exc_calls.js',
+    'throw_catch',
+    [100],
+    4050
+);
+
+/**
+Tail calls, including deep self and mutual recursion
+*/
+tests.programs.tail_calls = genProgTest(
+    'programs/tail_calls/tail_calls.js',
+    'test',
+    [],
+    0
+);
+
+/**
+Tail calls between static functions with stack arguments
+*/
+tests.programs.tail_calls_iir = genProgTest(
+    'programs/tail_calls_iir/tail_calls_iir.js',
+    'test',
+    [],
+    0,
+    'hostParams'
+);
+
 /**
 Array indexing test.
 */
@@ -964,6 +1198,16 @@ tests.programs.perf_arr_access = genProgTest(
     0
 );
 
+/**
+JSON parsing and serialization performance test.
+*/
+tests.programs.perf_json = genProgTest(
+    'programs/perf_json/perf_json.js',
+    'test',
+    [],
+    0
+);
+
 /**
 Tests for sunspider.
 */
@@ -1214,6 +1458,29 @@ tests.programs.gc.stackvm = genProgTest(
     0,
     'hostParams'
 );
+tests.programs.gc.far_calls = function ()
+{
+    // Link the direct calls through their far jump stubs, so that the
+    // collector visits the callees through the stub addresses
+    var backend = config.hostParams.backend;
+    backend.farDirectRefs = true;
+
+    try
+    {
+        genProgTest(
+            'programs/gc/deepstack.js',
+            'test',
+            [],
+            0,
+            'hostParams'
+        )();
+    }
+
+    finally
+    {
+        backend.farDirectRefs = false;
+    }
+};
 
 /**
 Esprima parser test
@@ -246,6 +246,13 @@ function makeContextLayout(params)
         'null'
     );
 
+    // Exception value being thrown
+    ctxLayout.addField(
+        'excval',
+        IRType.box,
+        'null'
+    );
+
     // Finalize the context layout
     ctxLayout.finalize();
 }
@@ -56,19 +56,75 @@ Maxime Chevalier-Boisvert
 
 /**
 Unwind the stack and pass an exception value to the topmost exception handler.
+Call sites inside try blocks have a landing pad whose displacement from the
+return address is stored in the stack info, at the same location the GC
+reads its stack frame information from.
 */
 function throwExc(val)
 {
     "tachyon:static";
     "tachyon:noglobal";
 
-    // TODO
+    // Size of a stack slot
+    const SLOT_SIZE = PTR_NUM_BYTES;
 
-    iir.trace_print('exception thrown');
+    // Store the exception value in the context for the catch block
+    set_ctx_excval(iir.get_ctx(), val);
 
+    // Get the current return address and stack base pointer
+    var ra = iir.get_ra();
+    var bp = iir.get_bp();
+
+    // For each stack level
+    for (;;)
+    {
+        // Read the magic code
+        var magic = iir.icast(IRType.pint, iir.load(IRType.u16, ra, pint(8)));
+
+        // If the magic code doesn't match, there is no handler
+        if (magic !== pint(1337))
+            break;
+
+        // Read the landing pad displacement
+        var padDisp = iir.icast(IRType.pint, iir.load(IRType.u16, ra, pint(6)));
+
+        // If this call site has a landing pad, unwind the stack to the
+        // calling frame and jump to the landing pad
+        if (padDisp !== pint(0))
+            iir.unwind(bp, ra + padDisp);
+
+        // Compute the sp at the moment of the call
+        var sp = getFrameSp(ra, bp);
+
+        // Compute the base pointer for this frame
+        bp = sp + getFrameSize(ra, sp);
+
+        // Load the return address for the next frame down
+        ra = iir.load(IRType.rptr, sp, getFrameRaSlot(ra) * SLOT_SIZE);
+    }
+
+    // The exception is uncaught
     error(val);
 }
 
+/**
+Get the value of the exception being caught. The context field is
+cleared so that it does not keep the value alive for the GC.
+*/
+function getExcVal()
+{
+    "tachyon:static";
+    "tachyon:noglobal";
+
+    var ctx = iir.get_ctx();
+
+    var excVal = get_ctx_excval(ctx);
+
+    set_ctx_excval(ctx, null);
+
+    return excVal;
+}
+
 //=============================================================================
 //
 // Exception/error creating functions
@@ -108,9 +108,57 @@ function memCopy(dst, src, size)
 }
 
 /**
-Allocate a memory block of a given size on the heap
+Round a size up to a multiple of a given number of bytes.
+The alignment must be a power of 2.
+*/
+function alignSize(size, alignBytes)
+{
+    "tachyon:inline";
+    "tachyon:noglobal";
+    "tachyon:arg size pint";
+    "tachyon:arg alignBytes pint";
+    "tachyon:ret pint";
+
+    var mask = alignBytes - pint(1);
+
+    return (size + mask) & ~mask;
+}
+
+/**
+Allocate a memory block of a given size on the heap. This is the fast
+path, inlined at allocation sites. The free pointer is kept aligned, so
+that only the size needs to be aligned, which is usually a constant.
 */
 function heapAlloc(size)
+{
+    "tachyon:inline";
+    "tachyon:noglobal";
+    "tachyon:arg size pint";
+    "tachyon:ret rptr";
+
+    // Get a pointer to the context
+    var ctx = iir.get_ctx();
+
+    // Compute the next allocation pointer
+    var freePtr = get_ctx_freeptr(ctx);
+    var nextPtr = freePtr + alignSize(size, HEAP_ALIGN);
+
+    // If this allocation exceeds the heap limit, take the slow path
+    if (nextPtr > get_ctx_heaplimit(ctx))
+        return heapAllocSlow(size);
+
+    // Update the allocation pointer in the context object
+    set_ctx_freeptr(ctx, nextPtr);
+
+    // Allocate the object at the current position
+    return freePtr;
+}
+
+/**
+Allocate a memory block of a given size on the heap when the space
+left is insufficient. Performs a garbage collection.
+*/
+function heapAllocSlow(size)
 {
     "tachyon:static";
     "tachyon:noglobal";
@@ -127,64 +175,37 @@ function heapAlloc(size)
         'heapAlloc called during GC'
     );
 
-    // Get the heap parameters
+    assert (
+        get_ctx_freeptr(ctx) <= get_ctx_heaplimit(ctx),
+        'free ptr past heap limit'
+    );
+
+    // Log that we are going to perform GC
+    puts('Performing garbage collection');
+
+    // Call the garbage collector
+    gcCollect();
+
+    // Get the new heap parameters
     var heapStart = get_ctx_heapstart(ctx);
     var heapLimit = get_ctx_heaplimit(ctx);
     var freePtr = get_ctx_freeptr(ctx);
 
     assert (
-        freePtr <= heapLimit,
-        'free ptr past heap limit'
+        freePtr >= heapStart && freePtr <= heapLimit,
+        'free pointer outside of heap after GC'
     );
 
-    // Align the allocation pointer
-    freePtr = alignPtr(freePtr, HEAP_ALIGN);
-
     // Compute the next allocation pointer
-    var nextPtr = freePtr + size;
+    var nextPtr = freePtr + alignSize(size, HEAP_ALIGN);
 
-    //printInt(iir.icast(IRType.pint, size));
-    //printPtr(nextPtr);
-    //printPtr(heapLimit);
-
-    // If this allocation exceeds the heap limit
+    // If this allocation still exceeds the heap limit
     if (nextPtr > heapLimit)
     {
-        // Log that we are going to perform GC
-        puts('Performing garbage collection');
-
-        // Call the garbage collector
-        gcCollect();
-
-        // Get the new heap parameters
-        var heapStart = get_ctx_heapstart(ctx);
-        var heapLimit = get_ctx_heaplimit(ctx);
-        var freePtr = get_ctx_freeptr(ctx);
-
-        assert (
-            freePtr >= heapStart && freePtr < heapLimit,
-            'free pointer outside of heap after GC'
-        );
-
-        // Align the allocation pointer
-        freePtr = alignPtr(freePtr, HEAP_ALIGN);
-
-        // Compute the next allocation pointer
-        var nextPtr = freePtr + size;
-
-        // If this allocation still exceeds the heap limit
-        if (nextPtr > heapLimit)
-        {
-            // Report an error and abort
-            error('allocation exceeds heap limit');
-        }
+        // Report an error and abort
+        error('allocation exceeds heap limit');
     }
 
-    assert (
-        freePtr >= heapStart && freePtr < heapLimit,
-        'new address outside of heap'
-    );
-
     // Update the allocation pointer in the context object
     set_ctx_freeptr(ctx, nextPtr);
 
@@ -353,7 +374,8 @@ function gcCollect()
     // Set the heap start, limit and free pointers in the context
     set_ctx_heapstart(ctx, toStart);
     set_ctx_heaplimit(ctx, toLimit);
-    set_ctx_freeptr(ctx, get_ctx_tofree(ctx));
+    // The free pointer is kept aligned by the allocator
+    set_ctx_freeptr(ctx, alignPtr(get_ctx_tofree(ctx), HEAP_ALIGN));
 
     // For debugging, clear the old heap
     //for (var p = fromStart; p < fromLimit; p += pint(1))
@@ -521,6 +543,89 @@ function ptrInHeap(ptr)
     );
 }
 
+/**
+Get the stack pointer at the moment of a call, given the return address of
+the call and the base pointer of the callee's caller frame.
+Note: the stack info is located 8 bytes after the return address.
+*/
+function getFrameSp(ra, bp)
+{
+    "tachyon:static";
+    "tachyon:noglobal";
+    "tachyon:arg ra rptr";
+    "tachyon:arg bp rptr";
+    "tachyon:ret rptr";
+
+    // Read the padding space for this call
+    var padSpace = iir.icast(IRType.pint, iir.load(IRType.u16, ra, pint(10)));
+
+    // If this frame uses dynamic alignment, the sp is stored at the base
+    // pointer, otherwise it is offset by the padding space
+    if (padSpace === pint(0xFFFF))
+        return iir.load(IRType.rptr, bp, pint(0));
+    else
+        return bp + padSpace;
+}
+
+/**
+Get the return address slot index of a stack frame, given the return
+address of the call made from that frame
+*/
+function getFrameRaSlot(ra)
+{
+    "tachyon:static";
+    "tachyon:noglobal";
+    "tachyon:arg ra rptr";
+    "tachyon:ret pint";
+
+    var numSlots = iir.icast(IRType.pint, iir.load(IRType.i16, ra, pint(12)));
+
+    // If this is a frame with a variable argument count, the return
+    // address is below the argument count and spilled argument registers
+    if (numSlots < pint(0))
+        return pint(1) - numSlots;
+
+    return iir.icast(IRType.pint, iir.load(IRType.u16, ra, pint(14)));
+}
+
+/**
+Get the size in bytes of a stack frame, given the return address of the
+call made from that frame and the stack pointer at the moment of the call
+*/
+function getFrameSize(ra, sp)
+{
+    "tachyon:static";
+    "tachyon:noglobal";
+    "tachyon:arg ra rptr";
+    "tachyon:arg sp rptr";
+    "tachyon:ret pint";
+
+    // Number of hidden arguments
+    const NUM_HIDDEN_ARGS = pint(2);
+
+    // Size of a stack slot
+    const SLOT_SIZE = PTR_NUM_BYTES;
+
+    var numSlots = iir.icast(IRType.pint, iir.load(IRType.i16, ra, pint(12)));
+
+    // If the argument count is fixed
+    if (numSlots >= pint(0))
+        return numSlots * SLOT_SIZE;
+
+    // Get the number of argument registers
+    var numArgRegs = -numSlots;
+
+    // Load the argument count at the top of the stack
+    var numArgs = iir.load(IRType.pint, sp, pint(0)) + NUM_HIDDEN_ARGS;
+
+    // Compute the number of stack arguments
+    var numStackArgs = numArgs - numArgRegs;
+    if (numStackArgs < pint(0))
+        numStackArgs = pint(0);
+
+    return (pint(1) + numArgRegs + pint(1) + numStackArgs) * SLOT_SIZE;
+}
+
 /**
 Walk the stack and forward references to the to-space
 */
@@ -571,9 +676,6 @@ function visitStackRoots(ra, bp)
             break;
         }
 
-        // Read the padding space for this call
-        var padSpace = iir.icast(IRType.pint, iir.load(IRType.u16, ra, pint(10)));
-
         // Read the number of stack slots
         var numSlots = iir.icast(IRType.pint, iir.load(IRType.i16, ra, pint(12)));
 
@@ -598,23 +700,10 @@ function visitStackRoots(ra, bp)
         /*
         iir.trace_print('num slots:');
         printInt(numSlots);
-        iir.trace_print('pad space:');
-        printInt(padSpace);
         */
 
-        // If this frame uses dynamic alignment
-        if (padSpace === pint(0xFFFF))
-        {
-            //iir.trace_print('dynamic alignment');
-
-            // Load the sp at the base pointer
-            var sp = iir.load(IRType.rptr, bp, pint(0));
-        }
-        else
-        {
-            // Compute the sp at the moment of the call
-            var sp = bp + padSpace;
-        }
+        // Compute the sp at the moment of the call
+        var sp = getFrameSp(ra, bp);
 
         // If this is a frame with a variable argument count
         //
@@ -797,6 +886,23 @@ function gcVisitMCB(funcPtr, offset)
         {
             gcVisitBox(mcbPtr, offset);
         }
+
+        // Relative function pointer, the upper bits of the kind
+        // encode the offset of the entry point in the callee block
+        else if ((kind & u32(0xFF)) === u32(4))
+        {
+            var entryOffset = iir.icast(IRType.pint, kind >>> u32(8));
+            gcVisitRelFptr(mcbPtr, offset, entryOffset);
+        }
+
+        // Absolute pointer to an entry point, stored in a far jump stub,
+        // the upper bits of the kind encode the offset of the entry point
+        else if ((kind & u32(0xFF)) === u32(5))
+        {
+            var entryOffset = iir.icast(IRType.pint, kind >>> u32(8));
+            var entryPtr = iir.load(IRType.rptr, mcbPtr, offset);
+            gcVisitMCB(entryPtr, entryOffset);
+        }
     }
 }
 
@@ -819,6 +925,28 @@ function gcVisitFptr(ptr, offset)
     gcVisitMCB(funcPtr, MCB_HEADER_SIZE);
 }
 
+/**
+Visit the function referenced by a relative offset to one of its entry
+points, as encoded in direct calls
+*/
+function gcVisitRelFptr(ptr, offset, entryOffset)
+{
+    "tachyon:static";
+    "tachyon:noglobal";
+    "tachyon:arg ptr rptr";
+    "tachyon:arg offset pint";
+    "tachyon:arg entryOffset pint";
+
+    // Read the offset, relative to the end of the reference
+    var relOffset = iir.icast(IRType.pint, iir.load(IRType.i32, ptr, offset));
+
+    // Compute the entry point address
+    var funcPtr = ptr + (offset + pint(4) + relOffset);
+
+    // Visit the function's machine code block
+    gcVisitMCB(funcPtr, entryOffset);
+}
+
 /**
 Visit and update a reference value
 */
@@ -776,22 +776,32 @@ MemLayout.prototype.genMethods = function ()
     sourceStr += '}\n';
     sourceStr += '\n';
 
-    // Function to generate the allocation function code
-    function genAllocCode(namePrefix, layout, initCode)
+    // Function to generate the allocation function code. If the space is
+    // reserved, the function takes a pointer to already allocated heap space.
+    function genAllocCode(namePrefix, layout, initCode, reserved)
     {
         var sourceStr = '';
 
+        var argStr = (reserved? 'ptr':'');
+        if (varSize)
+            argStr += (reserved? ', size':'size');
+
         sourceStr += 'function ' + namePrefix + '_' + layout.name + '(' +
-                     (varSize? 'size':'') + ')\n';
+                     argStr + ')\n';
         sourceStr += '{\n';
         sourceStr += '\t"tachyon:inline";\n';
         sourceStr += '\t"tachyon:noglobal";\n';
+        if (reserved)
+            sourceStr += '\t"tachyon:arg ptr rptr";\n';
         if (varSize)
             sourceStr += '\t"tachyon:arg size pint";\n';
         sourceStr += '\t"tachyon:ret ' + layout.ptrType + '";\n';
 
-        sourceStr += '\tvar ptr = heapAlloc(comp_size_' + layout.name + '(' +
-                     (varSize? 'size':'') + '));\n';
+        if (!reserved)
+        {
+            sourceStr += '\tvar ptr = heapAlloc(comp_size_' + layout.name + '(' +
+                         (varSize? 'size':'') + '));\n';
+        }
 
         // Convert the layout pointer type as appropriate
         if (layout.ptrType === IRType.box){
@@ -826,6 +836,10 @@ MemLayout.prototype.genMethods = function ()
     // Generate the allocation function without initialization
     sourceStr += genAllocCode('alloc_noinit', this);
 
+    // Generate the function to allocate an object in space reserved by a
+    // larger allocation, so that neighbouring allocations can be combined
+    sourceStr += genAllocCode('alloc_at', this, initCode, true);
+
     // Generate code for the accessor functions for this layout
     this.forEachField(
         function (layout, spec, fieldSpecs)
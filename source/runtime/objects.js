@@ -549,6 +549,15 @@ function makeObjectLayouts(params)
     // Finalize the string layout
     strLayout.finalize();
 
+    // Offset of the character data in string objects
+    params.staticEnv.regBinding(
+        'STR_DATA_OFFSET',
+        IRConst.getConst(
+            strLayout.getFieldOffset(['data', 0]),
+            IRType.pint
+        )
+    );
+
     // Offset added to string hash codes, so as to reserve a range
     // for integer values
     params.staticEnv.regBinding(
@@ -191,6 +191,18 @@ function boxIsFunc(boxVal)
     return getRefTag(boxVal) === TAG_FUNCTION;
 }
 
+/**
+Test if a boxed value is a closure of a given function
+*/
+function boxIsClosOf(boxVal, funcPtr)
+{
+    "tachyon:inline";
+    "tachyon:noglobal";
+    "tachyon:arg funcPtr rptr";
+
+    return boxIsFunc(boxVal) && get_clos_funcptr(boxVal) === funcPtr;
+}
+
 /**
 Test if a boxed value is an array
 */
@@ -364,6 +376,27 @@ function boxIsInt32(boxVal)
     return false;
 }
 
+/**
+Compute the square root of a non-negative integer, rounded down
+*/
+function intSqrt(intVal)
+{
+    "tachyon:inline";
+    "tachyon:arg intVal pint";
+    "tachyon:ret pint";
+
+    var root = iir.isqrt(intVal);
+
+    // The root is computed in double precision and may be off by one
+    // for values which are not exactly representable as doubles
+    if (root * root > intVal)
+        root = root - pint(1);
+    else if ((root + pint(1)) * (root + pint(1)) <= intVal)
+        root = root + pint(1);
+
+    return root;
+}
+
 /**
 Convert a boxed value to a string
 */
@@ -507,6 +540,54 @@ function u8(boxVal)
     return iir.icast(IRType.u8, unboxInt(boxVal));
 }
 
+/**
+Record the tag of a boxed value in a type feedback cell. The tag
+byte at the given offset accumulates one bit per reference tag.
+*/
+function fbRecordTag(cell, offset, boxVal)
+{
+    "tachyon:inline";
+    "tachyon:noglobal";
+    "tachyon:arg cell rptr";
+    "tachyon:arg offset pint";
+
+    var tag = iir.icast(IRType.pint, boxVal) & TAG_REF_MASK;
+
+    var bits = iir.icast(IRType.pint, iir.load(IRType.u8, cell, offset));
+    bits = bits | (pint(1) << tag);
+
+    iir.store(IRType.u8, cell, offset, iir.icast(IRType.u8, bits));
+}
+
+/**
+Increment the execution count of a type feedback cell
+*/
+function fbCountHit(cell)
+{
+    "tachyon:inline";
+    "tachyon:noglobal";
+    "tachyon:arg cell rptr";
+
+    var count = iir.load(IRType.u32, cell, pint(4));
+
+    iir.store(IRType.u32, cell, pint(4), count + u32(1));
+}
+
+/**
+Increment the (saturating) guard failure count of a type feedback cell
+*/
+function fbGuardFail(cell)
+{
+    "tachyon:inline";
+    "tachyon:noglobal";
+    "tachyon:arg cell rptr";
+
+    var count = iir.load(IRType.u8, cell, pint(2));
+
+    if (count !== u8(255))
+        iir.store(IRType.u8, cell, pint(2), count + u8(1));
+}
+
 //=============================================================================
 //
 // Implementation of JavaScript primitives (IR instructions)
@@ -526,8 +607,13 @@ function newObject(proto)
         'invalid object prototype'
     );
 
-    // Allocate space for an object
-    var obj = alloc_obj();
+    // Reserve space for the object and its hash table at once
+    var objSize = alignSize(comp_size_obj(), HEAP_ALIGN);
+    var tblSize = comp_size_hashtbl(HASH_MAP_INIT_SIZE);
+    var ptr = heapAlloc(objSize + tblSize);
+
+    // Allocate the object
+    var obj = alloc_at_obj(ptr);
 
     //iir.trace_print('allocated obj:');
     //printPtr(iir.icast(IRType.rptr, obj));
@@ -538,8 +624,8 @@ function newObject(proto)
     // Initialize the number of properties
     set_obj_numprops(obj, u32(0));
 
-    // Allocate space for a hash table
-    var hashtbl = alloc_hashtbl(HASH_MAP_INIT_SIZE);
+    // Allocate the hash table
+    var hashtbl = alloc_at_hashtbl(ptr + objSize, HASH_MAP_INIT_SIZE);
 
     // Set the hash table reference
     set_obj_tbl(obj, hashtbl);
@@ -557,8 +643,14 @@ function newArray(capacity)
     "tachyon:noglobal";
     "tachyon:arg capacity pint";
 
-    // Allocate space for an array
-    var arr = alloc_arr();
+    // Reserve space for the array, its hash table and its array
+    // table at once
+    var arrSize = alignSize(comp_size_arr(), HEAP_ALIGN);
+    var tblSize = alignSize(comp_size_hashtbl(HASH_MAP_INIT_SIZE), HEAP_ALIGN);
+    var ptr = heapAlloc(arrSize + tblSize + comp_size_arrtbl(capacity));
+
+    // Allocate the array
+    var arr = alloc_at_arr(ptr);
 
     // Set the prototype to the array prototype object
     var arrproto = get_ctx_arrproto(iir.get_ctx());
@@ -570,12 +662,12 @@ function newArray(capacity)
     // Initialize the array length
     set_arr_len(arr, u32(0));
 
-    // Allocate space for a hash table and set the hash table reference
-    var hashtbl = alloc_hashtbl(HASH_MAP_INIT_SIZE);
+    // Allocate the hash table and set the hash table reference
+    var hashtbl = alloc_at_hashtbl(ptr + arrSize, HASH_MAP_INIT_SIZE);
     set_obj_tbl(arr, hashtbl);
 
-    // Allocate space for an array table and set the table reference
-    var arrtbl = alloc_arrtbl(capacity);
+    // Allocate the array table and set the table reference
+    var arrtbl = alloc_at_arrtbl(ptr + arrSize + tblSize, capacity);
     set_arr_arr(arr, arrtbl);
 
     // Return the array reference
@@ -617,8 +709,13 @@ function makeClos(funcPtr, numCells)
     "tachyon:arg funcPtr rptr";
     "tachyon:arg numCells pint";
 
-    // Allocate space for the closure
-    var clos = alloc_clos(numCells);
+    // Reserve space for the closure and its hash table at once
+    var closSize = alignSize(comp_size_clos(numCells), HEAP_ALIGN);
+    var tblSize = comp_size_hashtbl(HASH_MAP_INIT_SIZE);
+    var ptr = heapAlloc(closSize + tblSize);
+
+    // Allocate the closure
+    var clos = alloc_at_clos(ptr, numCells);
 
     // Get a reference to the context
     var ctx = iir.get_ctx();
@@ -633,8 +730,8 @@ function makeClos(funcPtr, numCells)
     // Initialize the number of properties
     set_obj_numprops(clos, u32(0));
 
-    // Allocate space for a hash table and set the hash table reference
-    var hashtbl = alloc_hashtbl(HASH_MAP_INIT_SIZE);
+    // Allocate the hash table and set the hash table reference
+    var hashtbl = alloc_at_hashtbl(ptr + closSize, HASH_MAP_INIT_SIZE);
     set_obj_tbl(clos, hashtbl);
 
     // Return the closure reference
@@ -703,8 +800,13 @@ function makeArgObj(funcObj, numArgs, argTable)
     "tachyon:arg numArgs pint";
     "tachyon:arg argTable ref";
 
-    // Allocate space for an array
-    var arr = alloc_arr();
+    // Reserve space for the array and its hash table at once
+    var arrSize = alignSize(comp_size_arr(), HEAP_ALIGN);
+    var tblSize = comp_size_hashtbl(HASH_MAP_INIT_SIZE);
+    var ptr = heapAlloc(arrSize + tblSize);
+
+    // Allocate the array
+    var arr = alloc_at_arr(ptr);
 
     // Set the prototype to the object prototype object
     var objproto = get_ctx_objproto(iir.get_ctx());
@@ -722,8 +824,8 @@ function makeArgObj(funcObj, numArgs, argTable)
     // Set the array table pointer to the arguments table
     set_arr_arr(arr, argTable);
 
-    // Allocate space for a hash table and set the hash table reference
-    var hashtbl = alloc_hashtbl(HASH_MAP_INIT_SIZE);
+    // Allocate the hash table and set the hash table reference
+    var hashtbl = alloc_at_hashtbl(ptr + arrSize, HASH_MAP_INIT_SIZE);
     set_obj_tbl(arr, hashtbl);
 
     // Initialize the callee variable to the function object
@@ -273,13 +273,17 @@ function getStrObj(rawStr, strLen)
 Compare two string objects for equality by iterating over UTF-16 code
 units. This conforms to section 11.8.5 of the ECMAScript 262
 specification.
-NOTE: this is used to find strings in the hash consing table
+NOTE: this is used to find strings in the hash consing table, both
+strings must have their hash code computed
 */
 function streq(str1, str2)
 {
     "tachyon:static";
     "tachyon:noglobal";
 
+    // Number of characters per machine word
+    const CHARS_PER_WORD = PTR_NUM_BYTES / pint(2);
+
     // Get the length of both strings
     var len1 = iir.icast(IRType.pint, get_str_size(str1));
     var len2 = iir.icast(IRType.pint, get_str_size(str2));
@@ -288,8 +292,24 @@ function streq(str1, str2)
     if (len1 !== len2)
         return false;
 
-    // For each character to be compared
-    for (var i = pint(0); i < len1; i++)
+    // If the hash codes aren't equal, the strings aren't equal
+    if (get_str_hash(str1) !== get_str_hash(str2))
+        return false;
+
+    var i = pint(0);
+
+    // Compare a machine word of characters at a time
+    for (; i + CHARS_PER_WORD <= len1; i += CHARS_PER_WORD)
+    {
+        var word1 = iir.load(IRType.pint, str1, STR_DATA_OFFSET + pint(2) * i);
+        var word2 = iir.load(IRType.pint, str2, STR_DATA_OFFSET + pint(2) * i);
+
+        if (word1 !== word2)
+            return false;
+    }
+
+    // For each remaining character to be compared
+    for (; i < len1; i++)
     {
         var ch1 = get_str_data(str1, i);
         var ch2 = get_str_data(str2, i);
@@ -313,6 +333,9 @@ function strcmp(str1, str2)
     "tachyon:noglobal";
     "tachyon:ret pint";
 
+    // Number of characters per machine word
+    const CHARS_PER_WORD = PTR_NUM_BYTES / pint(2);
+
     // Get the length of both strings
     var len1 = iir.icast(IRType.pint, get_str_size(str1));
     var len2 = iir.icast(IRType.pint, get_str_size(str2));
@@ -320,8 +343,20 @@ function strcmp(str1, str2)
     // Compute the minimum of both string lengths
     var minLen = (len1 < len2)? len1:len2;
 
-    // For each character to be compared
-    for (var i = pint(0); i < minLen; i++)
+    var i = pint(0);
+
+    // Skip the common prefix a machine word of characters at a time
+    for (; i + CHARS_PER_WORD <= minLen; i += CHARS_PER_WORD)
+    {
+        var word1 = iir.load(IRType.pint, str1, STR_DATA_OFFSET + pint(2) * i);
+        var word2 = iir.load(IRType.pint, str2, STR_DATA_OFFSET + pint(2) * i);
+
+        if (word1 !== word2)
+            break;
+    }
+
+    // For each remaining character to be compared
+    for (; i < minLen; i++)
     {
         var ch1 = get_str_data(str1, i);
         var ch2 = get_str_data(str2, i);
@@ -334,7 +369,7 @@ function strcmp(str1, str2)
 
     if (len1 < len2)
         return pint(-1);
-    else if (len2 > len1)
+    else if (len1 > len2)
         return pint(1);
     else
         return pint(0);
@@ -381,6 +416,310 @@ function strcat(str1, str2)
     return newStr;
 }
 
+/**
+Extract the characters of a string object between two indices into
+a new string object
+*/
+function strSlice(str, start, end)
+{
+    "tachyon:static";
+    "tachyon:noglobal";
+    "tachyon:arg start pint";
+    "tachyon:arg end pint";
+
+    // Allocate a string object
+    var newStr = alloc_str(end - start);
+
+    // Copy the character data
+    for (var i = start; i < end; i++)
+    {
+        var ch = get_str_data(str, i);
+        set_str_data(newStr, i - start, ch);
+    }
+
+    // Compute the hash code for the new string
+    compStrHash(newStr);
+
+    // Find/add the new string in the string table
+    return getTableStr(newStr);
+}
+
+/**
+Replace the characters of a string object between two indices by
+those of another string object, producing a new string object
+*/
+function strSplice(str, start, end, insStr)
+{
+    "tachyon:static";
+    "tachyon:noglobal";
+    "tachyon:arg start pint";
+    "tachyon:arg end pint";
+
+    // Get the length of both strings
+    var len = iir.icast(IRType.pint, get_str_size(str));
+    var insLen = iir.icast(IRType.pint, get_str_size(insStr));
+
+    // Allocate a string object
+    var newStr = alloc_str(len - (end - start) + insLen);
+
+    // Copy the characters before the replaced range
+    for (var i = pint(0); i < start; i++)
+        set_str_data(newStr, i, get_str_data(str, i));
+
+    // Copy the inserted characters
+    for (var i = pint(0); i < insLen; i++)
+        set_str_data(newStr, start + i, get_str_data(insStr, i));
+
+    // Copy the characters after the replaced range
+    var ofs = start + insLen - end;
+    for (var i = end; i < len; i++)
+        set_str_data(newStr, i + ofs, get_str_data(str, i));
+
+    // Compute the hash code for the new string
+    compStrHash(newStr);
+
+    // Find/add the new string in the string table
+    return getTableStr(newStr);
+}
+
+/**
+Find the first occurrence of a character in a string object, between
+two indices. The character data is scanned a machine word at a time,
+testing all the characters of a word for a match at once.
+@returns the index of the character, or -1 if not found
+*/
+function strScanChar(str, ch, start, end)
+{
+    "tachyon:static";
+    "tachyon:noglobal";
+    "tachyon:arg ch pint";
+    "tachyon:arg start pint";
+    "tachyon:arg end pint";
+    "tachyon:ret pint";
+
+    // Number of characters per machine word
+    const CHARS_PER_WORD = PTR_NUM_BYTES / pint(2);
+
+    // Word with a one in the low bit of every character
+    var ones = pint(0x00010001);
+    if (PTR_NUM_BYTES === pint(8))
+        ones = ones | (ones << pint(32));
+
+    // Word with a one in the high bit of every character
+    var highs = ones << pint(15);
+
+    // Word with the searched character in every position
+    var pattern = ones * ch;
+
+    var i = start;
+
+    // Skip the words which do not contain the character. A character of
+    // the word matches if the xor with the pattern has a zero character.
+    while (i + CHARS_PER_WORD <= end)
+    {
+        var word = iir.load(IRType.pint, str, STR_DATA_OFFSET + pint(2) * i);
+
+        var diff = word ^ pattern;
+
+        if (((diff - ones) & ~diff & highs) !== pint(0))
+            break;
+
+        i += CHARS_PER_WORD;
+    }
+
+    // Find the character in the remaining characters
+    for (; i < end; i++)
+    {
+        if (iir.icast(IRType.pint, get_str_data(str, i)) === ch)
+            return i;
+    }
+
+    return pint(-1);
+}
+
+/**
+Find the first occurrence of a string object in another, starting at
+a given index. Uses a Horspool-style search, with a bloom filter of
+the pattern characters in a machine word, so that the text can be
+skipped over by the pattern length when the character following the
+current window does not occur in the pattern.
+@returns the index of the occurrence, or -1 if not found
+*/
+function strIndexOf(str, pat, start)
+{
+    "tachyon:static";
+    "tachyon:noglobal";
+    "tachyon:arg start pint";
+    "tachyon:ret pint";
+
+    // Mask for the bloom filter bit indices
+    const BLOOM_MASK = PTR_NUM_BYTES * pint(8) - pint(1);
+
+    // Get the length of both strings
+    var len = iir.icast(IRType.pint, get_str_size(str));
+    var patLen = iir.icast(IRType.pint, get_str_size(pat));
+
+    // The empty string is found at the start position
+    if (patLen === pint(0))
+        return start;
+
+    if (start + patLen > len)
+        return pint(-1);
+
+    // Single characters are searched for a word at a time
+    if (patLen === pint(1))
+    {
+        var patCh = iir.icast(IRType.pint, get_str_data(pat, pint(0)));
+        return strScanChar(str, patCh, start, len);
+    }
+
+    var last = patLen - pint(1);
+    var lastCh = get_str_data(pat, last);
+
+    // Compute the bloom filter of the pattern characters, and the shift
+    // to the last occurrence of the last character in the pattern
+    var mask = pint(0);
+    var skip = last - pint(1);
+    for (var i = pint(0); i < last; i++)
+    {
+        var ch = get_str_data(pat, i);
+
+        mask |= pint(1) << (iir.icast(IRType.pint, ch) & BLOOM_MASK);
+
+        if (ch === lastCh)
+            skip = last - i - pint(1);
+    }
+    mask |= pint(1) << (iir.icast(IRType.pint, lastCh) & BLOOM_MASK);
+
+    // Last possible position of the pattern
+    var maxPos = len - patLen;
+
+    for (var i = start; i <= maxPos; i++)
+    {
+        // If the last character of the window matches
+        if (get_str_data(str, i + last) === lastCh)
+        {
+            // Compare the rest of the window
+            for (var j = pint(0); j < last; j++)
+                if (get_str_data(str, i + j) !== get_str_data(pat, j))
+                    break;
+
+            if (j === last)
+                return i;
+
+            // Skip the window if the next character isn't in the pattern,
+            // otherwise align the last character with its previous
+            // occurrence in the pattern
+            if (i < maxPos && (mask & (pint(1) << (iir.icast(IRType.pint, 
+                get_str_data(str, i + patLen)) & BLOOM_MASK))) === pint(0))
+                i += patLen;
+            else
+                i += skip;
+        }
+
+        // Skip the window if the next character isn't in the pattern
+        else if (i < maxPos && (mask & (pint(1) << (iir.icast(IRType.pint, 
+                 get_str_data(str, i + patLen)) & BLOOM_MASK))) === pint(0))
+        {
+            i += patLen;
+        }
+    }
+
+    return pint(-1);
+}
+
+/**
+Find the last occurrence of a string object in another, at or before
+a given index. This is the mirror image of strIndexOf.
+@returns the index of the occurrence, or -1 if not found
+*/
+function strLastIndexOf(str, pat, start)
+{
+    "tachyon:static";
+    "tachyon:noglobal";
+    "tachyon:arg start pint";
+    "tachyon:ret pint";
+
+    // Mask for the bloom filter bit indices
+    const BLOOM_MASK = PTR_NUM_BYTES * pint(8) - pint(1);
+
+    // Get the length of both strings
+    var len = iir.icast(IRType.pint, get_str_size(str));
+    var patLen = iir.icast(IRType.pint, get_str_size(pat));
+
+    // The pattern can't start past the last possible position
+    if (start > len - patLen)
+        start = len - patLen;
+
+    // The empty string is found at the start position
+    if (patLen === pint(0))
+        return start;
+
+    if (start < pint(0))
+        return pint(-1);
+
+    var firstCh = get_str_data(pat, pint(0));
+
+    // Single characters are compared one at a time
+    if (patLen === pint(1))
+    {
+        for (var i = start; i >= pint(0); i--)
+            if (get_str_data(str, i) === firstCh)
+                return i;
+
+        return pint(-1);
+    }
+
+    var last = patLen - pint(1);
+
+    // Compute the bloom filter of the pattern characters, and the shift
+    // to the next occurrence of the first character in the pattern
+    var mask = pint(1) << (iir.icast(IRType.pint, firstCh) & BLOOM_MASK);
+    var skip = last - pint(1);
+    for (var i = last; i > pint(0); i--)
+    {
+        var ch = get_str_data(pat, i);
+
+        mask |= pint(1) << (iir.icast(IRType.pint, ch) & BLOOM_MASK);
+
+        if (ch === firstCh)
+            skip = i - pint(1);
+    }
+
+    for (var i = start; i >= pint(0); i--)
+    {
+        // If the first character of the window matches
+        if (get_str_data(str, i) === firstCh)
+        {
+            // Compare the rest of the window
+            for (var j = last; j > pint(0); j--)
+                if (get_str_data(str, i + j) !== get_str_data(pat, j))
+                    break;
+
+            if (j === pint(0))
+                return i;
+
+            // Skip the window if the previous character isn't in the
+            // pattern, otherwise align the first character with its next
+            // occurrence in the pattern
+            if (i > pint(0) && (mask & (pint(1) << (iir.icast(IRType.pint, 
+                get_str_data(str, i - pint(1))) & BLOOM_MASK))) === pint(0))
+                i -= patLen;
+            else
+                i -= skip;
+        }
+
+        // Skip the window if the previous character isn't in the pattern
+        else if (i > pint(0) && (mask & (pint(1) << (iir.icast(IRType.pint, 
+                 get_str_data(str, i - pint(1))) & BLOOM_MASK))) === pint(0))
+        {
+            i -= patLen;
+        }
+    }
+
+    return pint(-1);
+}
+
 /**
 Create a string object from raw string data
 */
@@ -412,62 +751,97 @@ function rawStrToObj(rawStr, strLen)
 }
 
 /**
-Compute and set the hash code for a string object
+Compute and set the hash code for a string object. Strings representing
+small integer values hash to their value and single characters to their
+code unit. Other strings are hashed a machine word of characters at a
+time using multiplicative hashing.
 */
 function compStrHash(strObj)
 {
     "tachyon:static";
     "tachyon:noglobal";
 
-    // Get the string length
-    var len = iir.icast(IRType.pint, get_str_size(strObj));
-
-    // Initialize the hash code to 0
-    var hashCode = u32(0);
+    // Number of characters per machine word
+    const CHARS_PER_WORD = PTR_NUM_BYTES / pint(2);
 
-    // Initialize the integer value to 0
-    var intVal = u32(0);
+    // Hash mixing multiplier (from MurmurHash2)
+    const HASH_MULT = pint(0x5bd1e995);
 
-    // Flag indicating that the string represents an integer
-    var isInt = true;
+    // Get the string length
+    var len = iir.icast(IRType.pint, get_str_size(strObj));
 
-    // For each character, update the hash code
-    for (var i = pint(0); i < len; i++)
+    // Integers below the string hash code offset have at most 5 digits
+    if (len > pint(0) && len <= pint(5))
     {
-        // Get the current character
-        var ch = iir.icast(IRType.u32, get_str_data(strObj, i));
+        // Initialize the integer value to 0
+        var intVal = u32(0);
 
-        // If this character is a digit
-        if (ch >= u32(48) && ch <= u32(57))
+        // For each character, update the integer value
+        for (var i = pint(0); i < len; i++)
         {
-            // Update the number value
-            var digitVal = ch - u32(48);
-            intVal = u32(10) * intVal + digitVal;
+            // Get the current character
+            var ch = iir.icast(IRType.u32, get_str_data(strObj, i));
+
+            // If this character is not a digit, stop
+            if (ch < u32(48) || ch > u32(57))
+                break;
+
+            intVal = u32(10) * intVal + (ch - u32(48));
         }
-        else
+
+        // If this is an integer value within the supported range
+        if (i === len && intVal < HASH_CODE_STR_OFFSET)
         {
-            // This string does not represent a number
-            isInt = false;
+            // Set the hash code to the integer value
+            set_str_hash(strObj, intVal);
+            return;
         }
+    }
 
-        // Update the hash code
-        hashCode = (((hashCode << u32(8)) + ch) & u32(536870911)) % u32(426870919);
+    // Single characters hash to their code unit, which keeps short
+    // property names in definition order in property tables
+    if (len === pint(1))
+    {
+        var ch = iir.icast(IRType.u32, get_str_data(strObj, pint(0)));
+        set_str_hash(strObj, ch + HASH_CODE_STR_OFFSET);
+        return;
     }
 
-    // If this is an integer value within the supported range
-    if (len > pint(0) && isInt === true && intVal < HASH_CODE_STR_OFFSET)
+    // Initialize the hash value with the string length
+    var hash = len;
+
+    var i = pint(0);
+
+    // Mix in a machine word of characters at a time
+    for (; i + CHARS_PER_WORD <= len; i += CHARS_PER_WORD)
     {
-        // Set the hash code to the integer value
-        hashCode = intVal;
+        var word = iir.load(IRType.pint, strObj, STR_DATA_OFFSET + pint(2) * i);
+
+        hash = (hash ^ word) * HASH_MULT;
+        hash ^= hash >>> (PTR_NUM_BYTES * pint(2));
     }
-    else
+
+    // Mix in the remaining characters
+    for (; i < len; i++)
     {
-        // Offset the string hash code to indicate this is not an integer value
-        hashCode += HASH_CODE_STR_OFFSET;
+        var ch = iir.icast(IRType.pint, get_str_data(strObj, i));
+
+        hash = (hash ^ ch) * HASH_MULT;
     }
 
+    // Final mixing, so that all bits affect the low-order bits
+    hash ^= hash >>> pint(13);
+    hash *= HASH_MULT;
+    hash ^= hash >>> pint(15);
+    if (PTR_NUM_BYTES === pint(8))
+        hash ^= hash >>> pint(32);
+
+    // Offset the string hash code to indicate this is not an integer value
+    var hashCode = iir.icast(IRType.u32, hash & pint(0x3FFFFFFF));
+    hashCode += HASH_CODE_STR_OFFSET;
+
     // Set the hash code in the string object
-    set_str_hash(strObj, iir.icast(IRType.u32, hashCode));
+    set_str_hash(strObj, hashCode);
 }
 
 /**
@@ -63,358 +63,710 @@ JSON.toString = function ()
 }
 
 /**
-15.12.2 JSON.parse(text, [, reviver])
+Get the character code at a given index of a string, without bounds or
+type checks.
 */
-JSON.parse = function (
-    text,
-    reviver
+function json_internal_charCodeAt (
+    s,
+    index
 )
 {
-    var index = 0;
+    "tachyon:noglobal";
 
-    // Return current char code, or undefined if at the end of input.
-    function current ()
-    {
-        if (index < text.length)
-            return text.charCodeAt(index);
-        else
-            return undefined;
-    }
+    return boxInt(iir.icast(IRType.pint, get_str_data(s, unboxInt(index))));
+}
 
-    // Skip <n> characters from input.
-    function consume (
-        n
-    )
-    {
-        index += (n === undefined ? 1 : n);
-    }
+/**
+Create an interned string from the characters of a string between
+two indices.
+*/
+function json_internal_substring (
+    s,
+    start,
+    end
+)
+{
+    "tachyon:noglobal";
 
-    // Set input to the next non whitespace character.
-    function skipWhiteSpace ()
-    {
-        var c;
+    var from = unboxInt(start);
+    var len = unboxInt(end) - from;
 
-        while (true)
-        {
-            c = current();
+    var strObj = alloc_str(len);
 
-            if (c === 9 || c === 10 || c === 32 || c === 13)
-                consume();
-            else
-                return;
-        }
-    }
+    for (var i = pint(0); i < len; ++i)
+        set_str_data(strObj, i, get_str_data(s, from + i));
 
-    // Parse a JSON input and return its value.
-    function parseJSON ()
-    {
-        skipWhiteSpace();
+    compStrHash(strObj);
 
-        var c = current();
+    return getTableStr(strObj);
+}
 
-        if (c === 123) // '{'
-            return parseObject();
-        else if (c === 91) // '['
-            return parseArray();
-        else if (c === 34) // '"'
-            return parseString();
-        else if (c === 110) // 'n'
-            return parseNull();
-        else if (c === 116) // 't'
-            return parseTrue();
-        else if (c === 102) // 'f'
-            return parseFalse();
-        else if ((c >= 48 && c <= 57) || c === 45) // 0-9 | '-'
-            return parseNumber();
-        else
-            // FIXME: throw SyntaxError
-            return undefined;
-    }
+/**
+Get the value of an hexadecimal digit, or -1 if the character code is
+not an hexadecimal digit.
+*/
+function json_internal_hexValue (
+    c
+)
+{
+    if (c >= 48 && c <= 57) // 0-9
+        return c - 48;
+    if (c >= 65 && c <= 70) // A-F
+        return c - 55;
+    if (c >= 97 && c <= 102) // a-f
+        return c - 87;
+    return -1;
+}
+
+/**
+Create an interned string from the characters of a string literal with
+escape sequences, between two indices. The length of the unescaped
+string is given. Returns undefined on invalid escape sequences.
+*/
+function json_internal_unescape (
+    s,
+    start,
+    end,
+    len
+)
+{
+    var strObj = alloc_str(unboxInt(len));
+    var k = pint(0);
 
-    function parseObject ()
+    for (var i = start; i < end; ++i)
     {
-        var o = {};
+        var c = json_internal_charCodeAt(s, i);
 
-        // Consume opening {
-        consume();
-    
-        skipWhiteSpace();
-        while (current() !== 125) // '}'
+        if (c === 92) // '\'
         {
-            skipWhiteSpace();
+            c = json_internal_charCodeAt(s, ++i);
 
-            if (current() !== 34) // '"'
-                // FIXME: throw SyntaxError
-                return undefined;
-            
-            var propName = parseString();
+            switch (c)
+            {
+                case 34: // '"'
+                case 47: // '/'
+                case 92: // '\'
+                break;
 
-            skipWhiteSpace();
+                case 98: // 'b'
+                c = 8;
+                break;
 
-            if (current() !== 58) // ':'
-                // FIXME: throw SyntaxError
-                return undefined;
-            else
-                consume();
+                case 102: // 'f'
+                c = 12;
+                break;
 
-            skipWhiteSpace();
+                case 110: // 'n'
+                c = 10;
+                break;
 
-            var propValue = parseJSON();
+                case 114: // 'r'
+                c = 13;
+                break;
 
-            if (propValue === undefined)
-                // FIXME: throw SyntaxError
-                return undefined;
+                case 116: // 't'
+                c = 9;
+                break;
 
-            o[propName] = propValue;
+                case 117: // 'u'
+                c = 0;
+                for (var j = 0; j < 4; ++j)
+                {
+                    var d = json_internal_hexValue(
+                        json_internal_charCodeAt(s, ++i)
+                    );
 
-            skipWhiteSpace();
+                    if (d < 0)
+                        // FIXME: throw SyntaxError
+                        return undefined;
 
-            if (current() === 44) // ','
-                consume();
-            else if (current() !== 125) // '}'
+                    c = c * 16 + d;
+                }
+                break;
+
+                default:
                 // FIXME: throw SyntaxError
                 return undefined;
+            }
         }
 
-        // Consume closing }
-        consume();
-        return o;
+        set_str_data(strObj, k, iir.icast(IRType.u16, unboxInt(c)));
+        ++k;
     }
 
-    function parseArray ()
-    {
-        var a = [];
+    compStrHash(strObj);
 
-        // Consume opening [
-        consume();
-    
-        skipWhiteSpace();
+    return getTableStr(strObj);
+}
 
-        while (current() !== 93) // ']'
-        {
-            skipWhiteSpace();
+/**
+Create an object from the keys and values stored in alternance in an
+array, between two indices. The hash table of the object is allocated
+large enough to hold every property.
+*/
+function json_internal_makeObject (
+    values,
+    start,
+    end
+)
+{
+    var obj = {};
 
-            var value = parseJSON();
+    var numProps = unboxInt(end - start) / pint(2);
+    var tblSize = (numProps * HASH_MAP_MAX_LOAD_DENOM) /
+                  HASH_MAP_MAX_LOAD_NUM + pint(1);
 
-            if (value === undefined)
-                // FIXME: throw SyntaxError
-                return undefined;
+    if (tblSize > HASH_MAP_INIT_SIZE)
+        set_obj_tbl(obj, alloc_hashtbl(tblSize));
 
-            a.push(value);
+    for (var i = start; i < end; i += 2)
+        obj[values[i]] = values[i + 1];
 
-            skipWhiteSpace();
+    return obj;
+}
 
-            if (current() === 44) // ','
-                consume();
-            else if (current() !== 93) // ']'
-                // FIXME: throw SyntaxError
-                return undefined;
-        }
-        
-        // Consume closing ]
-        consume();
-        return a;
-    }
+/**
+Create an array from the values stored in an array between two indices.
+*/
+function json_internal_makeArray (
+    values,
+    start,
+    end
+)
+{
+    var arr = new Array(end - start);
 
-    function parseString ()
-    {
-        var parts = [], j = index + 1;
+    for (var i = start; i < end; ++i)
+        arr[i - start] = values[i];
 
-        // Consume opening "
-        consume();
+    return arr;
+}
 
-        while (true)
+/**
+Apply a reviver function to a parsed value and its elements.
+*/
+function json_internal_walk (
+    holder,
+    name,
+    reviver
+)
+{
+    var value;
+    if (name === null)
+        value = holder;
+    else
+        value = holder[name]; 
+
+    if ((typeof value) === "object")
+    {
+        if (value instanceof Array)
         {
-            var c = current(); 
+            for (var i = 0; i < value.length; ++i)
+            {
+                var elt = json_internal_walk(value, i.toString(), reviver);
 
-            if (c === 34) // '"'
+                if (elt === undefined)
+                    // FIXME: Delete a value in an array is not currently supported.
+                    // delete value[i.toString()];
+                    value[i.toString()] = undefined;
+            }
+        }
+        else
+        {
+            for (var prop in value)
             {
-                consume();
-                break;
+                var elt = json_internal_walk(value, prop, reviver);
+
+                if (elt === undefined)
+                    delete value[prop];
             }
+        }
+    }
 
-            if (c === 92) // '\'
-            {
-                // Parse escape sequence
-                if (index > j)
-                    parts.push(text.substring(j, index));
+    return reviver.call(holder, name, value);
+}
 
-                consume();
+/**
+15.12.2 JSON.parse(text, [, reviver])
 
-                switch (current())
-                {
-                    case 34: // '\'
-                    parts.push("\"");
-                    break;
+The text is scanned in a single pass. The values of the arrays and
+objects being parsed are kept on an explicit stack, and each array or
+object is created once all its elements are known.
+*/
+JSON.parse = function (
+    text,
+    reviver
+)
+{
+    text = text.toString();
 
-                    case 47: // '/'
-                    parts.push("\/");
-                    break;
+    var length = text.length;
+    var index = 0;
+    var c;
 
-                    case 92: // '\'
-                    parts.push("\\");
-                    break;
+    // Elements of the open arrays and objects, with object keys and
+    // values in alternance
+    var values = [];
+    var numValues = 0;
 
-                    case 98: // 'b'
-                    parts.push("\b");
-                    break;
+    // Start of the elements of each open array or object in the values
+    // stack, and its opening character
+    var starts = [];
+    var kinds = [];
+    var depth = 0;
 
-                    case 110: // 'n'
-                    parts.push("\n");
-                    break;
+    var value;
 
-                    case 114: // 'r'
-                    parts.push("\r");
-                    break;
+    while (true)
+    {
+        // Skip white space before the value.
+        while (index < length)
+        {
+            c = json_internal_charCodeAt(text, index);
 
-                    case 116: // 't'
-                    parts.push("\t");
-                    break;
+            if (c === 9 || c === 10 || c === 32 || c === 13)
+                ++index;
+            else
+                break;
+        }
 
-                    default:
-                    // FIXME: throw SyntaxError
-                    return undefined;
-                }
+        if (index >= length)
+            // FIXME: throw SyntaxError
+            return undefined;
 
-                consume();
-                j = index;
+        if (c === 123 || c === 91) // '{' | '['
+        {
+            starts[depth] = numValues;
+            kinds[depth] = c;
+            ++depth;
+            ++index;
+
+            while (index < length)
+            {
+                c = json_internal_charCodeAt(text, index);
+
+                if (c === 9 || c === 10 || c === 32 || c === 13)
+                    ++index;
+                else
+                    break;
+            }
+
+            // Empty array or object.
+            if (c === kinds[depth - 1] + 2) // '}' | ']'
+            {
+                ++index;
+                --depth;
+                value = (c === 125)? {}:[];
+            }
+            else if (kinds[depth - 1] === 91)
+            {
+                // Parse the first element.
+                continue;
             }
             else
             {
-                consume();
+                // Parse the first key, then its value.
+                value = undefined;
             }
         }
+        else if (c === 34) // '"'
+        {
+            // Find the end of the string and its unescaped length.
+            var start = ++index;
+            var strLen = 0;
+            var escaped = false;
 
-        if (index > j)
-            parts.push(text.substring(j, index - 1));
+            while (index < length)
+            {
+                c = json_internal_charCodeAt(text, index);
 
-        return parts.join("");
-    }
+                if (c === 34) // '"'
+                    break;
 
-    function parseTrue ()
-    {
-        var str = "true";
+                if (c === 92) // '\'
+                {
+                    escaped = true;
 
-        for (var i = 0; i < str.length; ++i)
-            if (current() !== str.charCodeAt(i))
-                return undefined;
-            else
-                consume();
-        return true;
-    }
+                    if (index + 1 < length &&
+                        json_internal_charCodeAt(text, index + 1) === 117)
+                        index += 5;
+                    else
+                        index += 1;
+                }
 
-    function parseFalse ()
-    {
-        var str = "false";
+                ++index;
+                ++strLen;
+            }
 
-        for (var i = 0; i < str.length; ++i)
-            if (current() !== str.charCodeAt(i))
+            if (index >= length)
+                // FIXME: throw SyntaxError
                 return undefined;
-            else
-                consume();
-        return false;
-    }
 
-    function parseNull ()
-    {
-        var str = "null";
+            if (escaped)
+                value = json_internal_unescape(text, start, index, strLen);
+            else
+                value = json_internal_substring(text, start, index);
 
-        for (var i = 0; i < str.length; ++i)
-            if (current() !== str.charCodeAt(i))
+            if (value === undefined)
                 return undefined;
-            else
-                consume();
-        return null;
-    }
 
-    function isDigit (c) { return (c >= 48 && c <= 57); }
+            ++index;
+        }
+        else if ((c >= 48 && c <= 57) || c === 45) // 0-9 | '-'
+        {
+            var n = 0;
+            var positive = true;
 
-    function parseNumber ()
-    {
-        var n = 0;
-        var positive = true;
+            if (c === 45) // '-'
+            {
+                positive = false;
+                ++index;
+            }
 
-        if (current() === 45) // '-'
-        {
-            positive = false;
-            consume();
-        }
+            while (index < length)
+            {
+                c = json_internal_charCodeAt(text, index);
+
+                if (c < 48 || c > 57)
+                    break;
+
+                n = (n * 10) + c - 48;
+                ++index;
+            }
 
-        while (isDigit(current()))
+            if (c === 46) // '.'
+            {
+                // Skip the fraction
+                for (++index; index < length; ++index)
+                {
+                    c = json_internal_charCodeAt(text, index);
+                    if (c < 48 || c > 57)
+                        break;
+                }
+            }
+
+            if (c === 69 || c === 101) // 'e' | 'E'
+            {
+                // Skip the exponent
+                for (++index; index < length; ++index)
+                {
+                    c = json_internal_charCodeAt(text, index);
+                    if (c < 48 || c > 57)
+                        break;
+                }
+            }
+
+            value = positive ? n : -n;
+        }
+        else if (c === 116 && text.substring(index, index + 4) === "true")
         {
-            n = (n * 10) + current() - 48;
-            consume();
+            index += 4;
+            value = true;
         }
-
-        if (current() === 46) // '.'
+        else if (c === 102 && text.substring(index, index + 5) === "false")
         {
-            consume();
-
-            // Parse fraction
-            while (isDigit(current()))
-                consume();
+            index += 5;
+            value = false;
         }
-
-        if (current() === 69 || current() === 101) // 'e' | 'E'
+        else if (c === 110 && text.substring(index, index + 4) === "null")
         {
-            consume();
-            
-            // Parse exponent
-            while (isDigit(current()))
-                consume();
+            index += 4;
+            value = null;
         }
-
-        return positive ? n : -n;
-    }
-
-    function walk (
-        holder,
-        name
-    )
-    {
-        var value;
-        if (name === null)
-            value = holder;
         else
-            value = holder[name]; 
+        {
+            // FIXME: throw SyntaxError
+            return undefined;
+        }
 
-        if ((typeof value) === "object")
+        // Add the value to the open array or object, creating the arrays
+        // and objects it closes.
+        while (depth > 0)
         {
-            if (value instanceof Array)
+            var kind = kinds[depth - 1];
+
+            // The value is undefined before the first key of an object
+            if (value !== undefined)
             {
-                for (var i = 0; i < value.length; ++i)
+                values[numValues++] = value;
+
+                while (index < length)
                 {
-                    var elt = walk(value, i.toString());
+                    c = json_internal_charCodeAt(text, index);
 
-                    if (elt === undefined)
-                        // FIXME: Delete a value in an array is not currently supported.
-                        // delete value[i.toString()];
-                        value[i.toString()] = undefined;
+                    if (c === 9 || c === 10 || c === 32 || c === 13)
+                        ++index;
+                    else
+                        break;
+                }
+
+                if (index >= length)
+                    // FIXME: throw SyntaxError
+                    return undefined;
+
+                ++index;
+
+                if (c === kind + 2) // '}' | ']'
+                {
+                    --depth;
+
+                    if (kind === 123)
+                        value = json_internal_makeObject(
+                            values, starts[depth], numValues
+                        );
+                    else
+                        value = json_internal_makeArray(
+                            values, starts[depth], numValues
+                        );
+
+                    numValues = starts[depth];
+                    continue;
+                }
+
+                if (c !== 44) // ','
+                    // FIXME: throw SyntaxError
+                    return undefined;
+
+                if (kind === 91)
+                    break;
+
+                while (index < length)
+                {
+                    c = json_internal_charCodeAt(text, index);
+
+                    if (c === 9 || c === 10 || c === 32 || c === 13)
+                        ++index;
+                    else
+                        break;
                 }
             }
-            else
+
+            // Parse the next key and the ':' which follows it.
+            if (index >= length || c !== 34) // '"'
+                // FIXME: throw SyntaxError
+                return undefined;
+
+            var keyStart = ++index;
+            var keyLen = 0;
+            var keyEscaped = false;
+
+            while (index < length)
             {
-                for (prop in value)
+                c = json_internal_charCodeAt(text, index);
+
+                if (c === 34) // '"'
+                    break;
+
+                if (c === 92) // '\'
                 {
-                    var elt = walk(value, prop);
+                    keyEscaped = true;
 
-                    if (elt === undefined)
-                        delete value[prop];
+                    if (index + 1 < length &&
+                        json_internal_charCodeAt(text, index + 1) === 117)
+                        index += 5;
+                    else
+                        index += 1;
                 }
+
+                ++index;
+                ++keyLen;
+            }
+
+            if (index >= length)
+                // FIXME: throw SyntaxError
+                return undefined;
+
+            var key;
+            if (keyEscaped)
+                key = json_internal_unescape(text, keyStart, index, keyLen);
+            else
+                key = json_internal_substring(text, keyStart, index);
+
+            if (key === undefined)
+                return undefined;
+
+            values[numValues++] = key;
+            ++index;
+
+            while (index < length)
+            {
+                c = json_internal_charCodeAt(text, index);
+
+                if (c === 9 || c === 10 || c === 32 || c === 13)
+                    ++index;
+                else
+                    break;
             }
+
+            if (index >= length || c !== 58) // ':'
+                // FIXME: throw SyntaxError
+                return undefined;
+
+            ++index;
+            break;
         }
 
-        return reviver.call(holder, name, value);
+        if (depth === 0)
+            break;
     }
 
-    var r = parseJSON();
     if (reviver !== undefined)
-        walk(r, null);
-    return r;
+        json_internal_walk(value, null, reviver);
+    return value;
+}
+
+/**
+Create a growable character buffer. The characters are stored in a
+string object which is not interned until the buffer is complete.
+*/
+function json_internal_newBuffer ()
+{
+    var buf = {};
+
+    buf.data = alloc_str(pint(256));
+    buf.capacity = 256;
+    buf.length = 0;
+
+    return buf;
+}
+
+/**
+Ensure that a buffer can hold a number of additional characters.
+*/
+function json_internal_reserve (
+    buf,
+    numChars
+)
+{
+    var newLen = buf.length + numChars;
+
+    if (newLen <= buf.capacity)
+        return;
+
+    var capacity = buf.capacity * 2;
+    if (capacity < newLen)
+        capacity = newLen;
+
+    var data = buf.data;
+    var newData = alloc_str(unboxInt(capacity));
+
+    var len = unboxInt(buf.length);
+    for (var i = pint(0); i < len; ++i)
+        set_str_data(newData, i, get_str_data(data, i));
+
+    buf.data = newData;
+    buf.capacity = capacity;
+}
+
+/**
+Append a string to a buffer.
+*/
+function json_internal_append (
+    buf,
+    s
+)
+{
+    var sLen = iir.icast(IRType.pint, get_str_size(s));
+
+    json_internal_reserve(buf, boxInt(sLen));
+
+    var data = buf.data;
+    var k = unboxInt(buf.length);
+
+    for (var i = pint(0); i < sLen; ++i)
+        set_str_data(data, k + i, get_str_data(s, i));
+
+    buf.length = boxInt(k + sLen);
+}
+
+/**
+Append a quoted string to a buffer, escaping the characters which
+need it.
+*/
+function json_internal_appendQuoted (
+    buf,
+    s
+)
+{
+    // TODO: Control sequence escaping.
+    var sLen = iir.icast(IRType.pint, get_str_size(s));
+
+    // Count the characters to escape
+    var numEscaped = pint(0);
+    for (var i = pint(0); i < sLen; ++i)
+    {
+        var c = iir.icast(IRType.pint, get_str_data(s, i));
+
+        if (c === pint(34) || c === pint(92) || c === pint(8) ||
+            c === pint(12) || c === pint(10) || c === pint(13) ||
+            c === pint(9))
+            ++numEscaped;
+    }
+
+    json_internal_reserve(buf, boxInt(sLen + numEscaped + pint(2)));
+
+    var data = buf.data;
+    var k = unboxInt(buf.length);
+
+    set_str_data(data, k++, u16(34)); // '"'
+
+    for (var i = pint(0); i < sLen; ++i)
+    {
+        var ch = get_str_data(s, i);
+        var c = iir.icast(IRType.pint, ch);
+        var e = pint(0);
+
+        if (c === pint(34) || c === pint(92)) // '"' | '\'
+            e = c;
+        else if (c === pint(8)) // '\b'
+            e = pint(98);
+        else if (c === pint(12)) // '\f'
+            e = pint(102);
+        else if (c === pint(10)) // '\n'
+            e = pint(110);
+        else if (c === pint(13)) // '\r'
+            e = pint(114);
+        else if (c === pint(9)) // '\t'
+            e = pint(116);
+
+        if (e !== pint(0))
+        {
+            set_str_data(data, k++, u16(92)); // '\'
+            ch = iir.icast(IRType.u16, e);
+        }
+
+        set_str_data(data, k++, ch);
+    }
+
+    set_str_data(data, k++, u16(34)); // '"'
+
+    buf.length = boxInt(k);
+}
+
+/**
+Create an interned string from the contents of a buffer.
+*/
+function json_internal_bufferToString (
+    buf
+)
+{
+    var len = unboxInt(buf.length);
+    var data = buf.data;
+
+    var strObj = alloc_str(len);
+
+    for (var i = pint(0); i < len; ++i)
+        set_str_data(strObj, i, get_str_data(data, i));
+
+    compStrHash(strObj);
+
+    return getTableStr(strObj);
 }
 
 /**
 15.12.3 JSON.stringify(value, [, replace [, space ]])
+
+The output is written into a growable character buffer.
 */
 JSON.stringify = function (
     value,
@@ -422,7 +774,7 @@ JSON.stringify = function (
     space
 )
 {
-    // Holds references to stringified object to avoid cyclic evaluation.
+    // Holds references to the objects being stringified to detect cycles.
     var objStack = [];
     var replacerFunction;
     var propertyList;
@@ -463,20 +815,18 @@ JSON.stringify = function (
         }
     }
 
-    function toJSON (
+    var buf = json_internal_newBuffer();
+
+    // Get the value to stringify for a key of a holder object.
+    function getValue (
         key,
-        holder,
-        depth
+        holder
     )
     {
-        var value;
-
-        if (key === "")
-            value = holder;
-        else
-            value = holder[key];
+        var value = holder[key];
 
-        if (typeof value.toJSON === "function")
+        if (typeof value === "object" && value !== null &&
+            typeof value.toJSON === "function")
            value = value.toJSON(); 
 
         if (replacerFunction !== undefined)
@@ -489,19 +839,19 @@ JSON.stringify = function (
         else if (value instanceof Boolean)
             value = value.valueOf();
 
-        if (value === null)
-            return "null";
-        else if (value === false)
-            return "false";
-        else if (value === true)
-            return "true";
+        return value;
+    }
 
-        if (typeof value === "string")
-            return quote(value);
+    // Test if a value has a JSON representation.
+    function isSerializable (
+        value
+    )
+    {
+        if (value === null || value === true || value === false)
+            return true;
 
-        if (typeof value === "number")
-            // TODO: return "null" if value is not finite.
-            return value.toString();
+        if (typeof value === "string" || typeof value === "number")
+            return true;
 
         if (typeof value === "object")
         {
@@ -509,26 +859,58 @@ JSON.stringify = function (
             for (var i = 0; i < objStack.length; ++i)
                 if (objStack[i] === value)
                     // FIXME: throw SyntaxError
-                    return undefined;
+                    return false;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // Append the indentation for a given depth.
+    function indent (
+        depth
+    )
+    {
+        for (var j = 0; j < depth; ++j)
+            json_internal_append(buf, espace);
+    }
 
+    // Write a serializable value into the buffer.
+    function write (
+        value,
+        depth
+    )
+    {
+        if (value === null)
+            json_internal_append(buf, "null");
+        else if (value === false)
+            json_internal_append(buf, "false");
+        else if (value === true)
+            json_internal_append(buf, "true");
+        else if (typeof value === "string")
+            json_internal_appendQuoted(buf, value);
+        else if (typeof value === "number")
+            // TODO: write "null" if value is not finite.
+            json_internal_append(buf, value.toString());
+        else
+        {
             objStack.push(value);
 
             if (value instanceof Array)
-                return arrayToJSON(value, depth);
+                writeArray(value, depth);
+            else
+                writeObject(value, depth);
 
-            return objectToJSON(value, depth);
+            objStack.pop();
         }
-        return undefined;
     }
 
-    function objectToJSON (
+    function writeObject (
         o,
         depth
     )
     {
-        if (o === null)
-            return 'null';
-
         var keys;
 
         if (propertyList === undefined)
@@ -536,185 +918,101 @@ JSON.stringify = function (
         else
             keys = propertyList;
 
-        if (keys.length === 0)
-            return "{}";
+        var numWritten = 0;
 
-        var parts = [];
-
-        if (espace === undefined)
+        for (var i = 0; i < keys.length; ++i)
         {
-            parts.push("{");
+            var v = getValue(keys[i], o);
 
-            for (var i = 0; i < keys.length; ++i)
-            {
-                var strp = toJSON(keys[i], o, depth + 1);
+            if (!isSerializable(v))
+                continue;
 
-                if (strp !== undefined)
-                {
-                    parts.push(quote(keys[i]));        
-                    parts.push(":");
-                    parts.push(strp);
-                    parts.push(",");
-                }
+            if (espace === undefined)
+            {
+                json_internal_append(buf, (numWritten === 0)? "{":",");
+                json_internal_appendQuoted(buf, keys[i]);
+                json_internal_append(buf, ":");
             }
-
-            if (parts.length > 1)
-                parts.pop();
-            parts.push("}");
-        }
-        else
-        {
-            parts.push("{\n");
-
-            for (var i = 0; i < keys.length; ++i)
+            else
             {
-                var strp = toJSON(keys[i], o, depth + 1);
-
-                if (strp !== undefined)
-                {
-                    for (var j = 0; j < depth; ++j)
-                        parts.push(espace);
-
-                    parts.push(quote(keys[i]));        
-                    parts.push(": ");
-                    parts.push(strp);
-                    parts.push(",\n");
-                }
+                json_internal_append(buf, (numWritten === 0)? "{\n":",\n");
+                indent(depth);
+                json_internal_appendQuoted(buf, keys[i]);
+                json_internal_append(buf, ": ");
             }
 
-            if (parts.length > 1)
-                parts.pop();
-
-            parts.push("\n");
-            for (var j = 0; j < depth - 1; ++j)
-                parts.push(espace);
-            parts.push("}");
+            write(v, depth + 1);
+            ++numWritten;
         }
 
-        return parts.join("");
+        if (numWritten === 0)
+        {
+            json_internal_append(buf, "{}");
+        }
+        else if (espace === undefined)
+        {
+            json_internal_append(buf, "}");
+        }
+        else
+        {
+            json_internal_append(buf, "\n");
+            indent(depth - 1);
+            json_internal_append(buf, "}");
+        }
     }
 
-    function arrayToJSON (
+    function writeArray (
         a,
         depth
     )
     {
-        var parts = [];
-
         if (a.length === 0)
-            return "[]";
-
-        if (espace === undefined)
         {
-            parts.push("[");
+            json_internal_append(buf, "[]");
+            return;
+        }
 
-            for (var i = 0; i < a.length; ++i)
+        for (var i = 0; i < a.length; ++i)
+        {
+            if (espace === undefined)
             {
-                var strp = toJSON(i.toString(), a, depth + 1);
-
-                parts.push(strp);
-                parts.push(",");
+                json_internal_append(buf, (i === 0)? "[":",");
             }
-
-            if (a.length > 0)
-                parts.pop();
-
-            parts.push("]");
-        }
-        else
-        {
-            parts.push("[\n");
-
-            for (var i = 0; i < a.length; ++i)
+            else
             {
-                var strp = toJSON(i.toString(), a, depth + 1);
-
-                for (var j = 0; j < depth; ++j)
-                    parts.push(espace);
-                parts.push(strp);
-                parts.push(",\n");
+                json_internal_append(buf, (i === 0)? "[\n":",\n");
+                indent(depth);
             }
 
-            if (a.length > 0)
-                parts.pop();
+            var v = getValue(i.toString(), a);
 
-            parts.push("\n");
-            for (var j = 0; j < depth - 1; ++j)
-                parts.push(espace);
-            parts.push("]");
+            if (isSerializable(v))
+                write(v, depth + 1);
+            else
+                json_internal_append(buf, "null");
         }
 
-        return parts.join("");
-    }
-
-    function quote (
-        s
-    )
-    {
-        // TODO: Control sequence escaping.
-        var parts = ["\""];
-
-        var i = 0, j = 0;
-        for (; i < s.length; ++i)
+        if (espace === undefined)
         {
-            var c = s.charCodeAt(i);
-            var escapedSeq = undefined;
-
-            switch (c)
-            {
-                case 34: // '"'
-                // Escape double quote character.
-                escapedSeq = "\\\"";
-                break;
-
-                case 92: // '\'
-                // Escape backslash character.
-                escapedSeq = "\\\\";
-                break;
-
-                case 8: // '\b'
-                // Escape backspace character.
-                escapedSeq = "\\b";
-                break;
-
-                case 12: // '\f'
-                // Escape formfeed character.
-                escapedSeq = "\\f";
-                break;
-
-                case 10: // '\n'
-                // Escape linefeed character.
-                escapedSeq = "\\n";
-                break;
-
-                case 13: // '\r'
-                // Escape carriage return character.
-                escapedSeq = "\\r";
-                break;
-
-                case 9: // '\t'
-                // Escape tab character.
-                escapedSeq = "\\t";
-                break;
-            }
+            json_internal_append(buf, "]");
+        }
+        else
+        {
+            json_internal_append(buf, "\n");
+            indent(depth - 1);
+            json_internal_append(buf, "]");
+        }
+    }
 
-            if (escapedSeq !== undefined)
-            {
-                if (j < i)
-                    parts.push(s.substring(j, i));
+    var wrapper = {};
+    wrapper[""] = value;
 
-                parts.push(escapedSeq);
-                j = i + 1;
-            }
-        }
+    value = getValue("", wrapper);
 
-        if (j < i)
-            parts.push(s.substring(j, i));
-        parts.push("\"");
+    if (!isSerializable(value))
+        return undefined;
 
-        return parts.join("");
-    }
+    write(value, 1);
 
-    return toJSON("", value, 1);
+    return json_internal_bufferToString(buf);
 }
-
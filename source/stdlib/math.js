@@ -246,7 +246,16 @@ Returns an implementation-dependent approximation to the square root of x.
 */
 Math.sqrt = function (x)
 {
-    // TODO: implement this function
+    if (boxIsInt(x) && x >= 0)
+    {
+        var r = boxInt(intSqrt(unboxInt(x)));
+
+        // If the root is an integer, it can be returned directly
+        if (r * r === x)
+            return r;
+    }
+
+    // Non-integer roots require floating-point support
     return noFPSupport('Math.sqrt');
 };
 
@@ -892,16 +892,14 @@ function RegExp (
         }
     }
 
-    // Parse pattern and compile it to an automata.
-    var ast = new RegExpParser().parse(pattern); 
-    
+    // Get the compiled pattern, parsing and compiling it if needed.
     var prop = {
-      value: astToAutomata(ast, this.global, this.ignoreCase, this.multiline),
+      value: getProgram(this.source, this.global, this.ignoreCase, this.multiline),
       writable: false,
       configurable: false,
       enumerable: false
     };
-    Object.defineProperty(this, "_automata", prop);
+    Object.defineProperty(this, "_program", prop);
 }
 
 /**
@@ -2522,6 +2520,651 @@ function assertionToAutomata (
     return nextTransition;
 }
 
+/***********************************************************************
+    Compiled patterns.
+
+    The automata above is needed for captures, backreferences and
+    lookaheads. On top of it, each pattern gets a literal prefix and
+    anchoring analysis used to skip start positions that cannot match,
+    and patterns free of backreferences and assertions also get a lazily
+    built DFA which decides whether an input contains a match in a
+    single pass, without backtracking.
+***********************************************************************/
+
+/**
+    Maximum number of NFA states built for a pattern before giving up
+    on the DFA matcher.
+*/
+var REGEXP_MAX_NFA_STATES = 1024;
+
+/**
+    Maximum number of DFA states built for a pattern before giving up
+    on the DFA matcher.
+*/
+var REGEXP_MAX_DFA_STATES = 256;
+
+/**
+    Maximum number of compiled patterns kept in the cache.
+*/
+var REGEXP_CACHE_SIZE = 64;
+
+/**
+    NFA state kinds.
+*/
+var NFA_CHAR = 0;
+var NFA_SPLIT = 1;
+var NFA_MATCH = 2;
+
+/**
+    Compiled pattern.
+*/
+function RegExpProgram (
+    automata,
+    prefix,
+    anchored,
+    dfa
+)
+{
+    this.automata = automata;
+    this.prefix = prefix;
+    this.anchored = anchored;
+    this.dfa = dfa;
+}
+
+/**
+    Returns the first position at or after <index> where a match can
+    start, or -1 if there is none.
+*/
+RegExpProgram.prototype.nextStart = function (
+    input,
+    index
+)
+{
+    if (this.anchored && index !== 0)
+        return -1;
+
+    if (this.prefix.length === 0)
+        return index;
+
+    if (this.anchored)
+    {
+        for (var i = 0; i < this.prefix.length; ++i)
+            if (input.charCodeAt(i) !== this.prefix.charCodeAt(i))
+                return -1;
+        return 0;
+    }
+
+    return input.indexOf(this.prefix, index);
+}
+
+/**
+    Returns 1 if a match starts at or after <index> in the input, 0 if
+    there is none and -1 if the DFA matcher is not available.
+*/
+RegExpProgram.prototype.search = function (
+    input,
+    index
+)
+{
+    if (this.dfa === null)
+        return -1;
+
+    var result = this.dfa.search(input, index);
+
+    // Stop using the DFA if it grew too large
+    if (result < 0)
+        this.dfa = null;
+
+    return result;
+}
+
+/**
+    Thompson NFA, stored in parallel arrays indexed by state number.
+*/
+function RegExpNFA ()
+{
+    this.kinds = [];
+    this.ranges = [];
+    this.positive = [];
+    this.out1 = [];
+    this.out2 = [];
+
+    // Set when the pattern uses features the NFA cannot express
+    this.unsupported = false;
+}
+
+/**
+    Add a state to the NFA and returns its number.
+*/
+RegExpNFA.prototype.addState = function (
+    kind,
+    ranges,
+    positive,
+    out1,
+    out2
+)
+{
+    var state = this.kinds.length;
+
+    if (state >= REGEXP_MAX_NFA_STATES)
+        this.unsupported = true;
+
+    this.kinds.push(kind);
+    this.ranges.push(ranges);
+    this.positive.push(positive);
+    this.out1.push(out1);
+    this.out2.push(out2);
+
+    return state;
+}
+
+/**
+    Compile a RegExpDisjunction ast node to NFA states leading to <next>.
+    Returns the start state.
+*/
+RegExpNFA.prototype.disjunction = function (
+    astNode,
+    next,
+    ignoreCase
+)
+{
+    var alternatives = astNode.alternatives;
+
+    if (alternatives.length === 0)
+        return next;
+
+    var start = this.alternative(
+        alternatives[alternatives.length - 1],
+        next,
+        ignoreCase
+    );
+
+    for (var i = alternatives.length - 1; i > 0; --i)
+    {
+        start = this.addState(
+            NFA_SPLIT,
+            null,
+            true,
+            this.alternative(alternatives[i - 1], next, ignoreCase),
+            start
+        );
+    }
+
+    return start;
+}
+
+/**
+    Compile a RegExpAlternative ast node to NFA states leading to <next>.
+*/
+RegExpNFA.prototype.alternative = function (
+    astNode,
+    next,
+    ignoreCase
+)
+{
+    for (var i = astNode.terms.length; i > 0 && !this.unsupported; --i)
+        next = this.term(astNode.terms[i - 1], next, ignoreCase);
+    return next;
+}
+
+/**
+    Compile a RegExpTerm ast node to NFA states leading to <next>. Greedy
+    and non greedy quantifiers accept the same inputs.
+*/
+RegExpNFA.prototype.term = function (
+    astNode,
+    next,
+    ignoreCase
+)
+{
+    if (astNode.prefix === undefined)
+        return next;
+
+    if (!(astNode.prefix instanceof RegExpAtom))
+    {
+        this.unsupported = true;
+        return next;
+    }
+
+    var min = astNode.quantifier.min;
+    var max = astNode.quantifier.max;
+
+    if (max < 0)
+    {
+        // Loop state, either entering the atom again or leaving
+        var loop = this.addState(NFA_SPLIT, null, true, -1, next);
+        this.out1[loop] = this.atom(astNode.prefix, loop, ignoreCase);
+        next = loop;
+    }
+    else
+    {
+        // Nested optional copies of the atom
+        var exit = next;
+        for (var i = min; i < max && !this.unsupported; ++i)
+        {
+            next = this.addState(
+                NFA_SPLIT,
+                null,
+                true,
+                this.atom(astNode.prefix, next, ignoreCase),
+                exit
+            );
+        }
+    }
+
+    // Concatenate atom <min> times.
+    for (var i = 0; i < min && !this.unsupported; ++i)
+        next = this.atom(astNode.prefix, next, ignoreCase);
+
+    return next;
+}
+
+/**
+    Compile a RegExpAtom ast node to NFA states leading to <next>.
+*/
+RegExpNFA.prototype.atom = function (
+    astNode,
+    next,
+    ignoreCase
+)
+{
+    var atomAstNode = astNode.value;
+
+    if (atomAstNode instanceof RegExpDisjunction)
+        return this.disjunction(atomAstNode, next, ignoreCase);
+
+    var ranges = [];
+    var positive = true;
+
+    if (atomAstNode instanceof RegExpPatternCharacter)
+    {
+        var charCode = atomAstNode.value;
+
+        ranges.push(charCode, charCode);
+
+        if (ignoreCase && charCode >= 97 && charCode <= 122) // a-z
+            ranges.push(charCode - 32, charCode - 32);
+        else if (ignoreCase && charCode >= 65 && charCode <= 90) // A-Z
+            ranges.push(charCode + 32, charCode + 32);
+    }
+    else if (atomAstNode instanceof RegExpCharacterClass)
+    {
+        positive = atomAstNode.positive;
+
+        for (var i = 0; i < atomAstNode.classAtoms.length; ++i)
+        {
+            var ca = atomAstNode.classAtoms[i];
+
+            // Escaped classes inside classes are not handled here
+            if (!(ca.min instanceof RegExpPatternCharacter) ||
+                (ca.max !== undefined &&
+                 !(ca.max instanceof RegExpPatternCharacter)))
+            {
+                this.unsupported = true;
+                return next;
+            }
+
+            // Same case folding as atomToAutomata
+            var lo = ca.min.value;
+            var hi = (ca.max === undefined)? lo:ca.max.value;
+
+            ranges.push(lo, hi);
+
+            if (ignoreCase && ca.max === undefined)
+            {
+                if (lo >= 97 && lo <= 122)
+                    ranges.push(lo - 32, lo - 32);
+                else if (lo >= 65 && lo <= 90)
+                    ranges.push(lo + 32, lo + 32);
+            }
+        }
+    }
+    else
+    {
+        // Backreferences and control sequences
+        this.unsupported = true;
+        return next;
+    }
+
+    return this.addState(NFA_CHAR, ranges, positive, next, -1);
+}
+
+/**
+    Add the epsilon closure of an NFA state to a state set.
+*/
+RegExpNFA.prototype.closure = function (
+    state,
+    set,
+    visited
+)
+{
+    if (visited[state] === true)
+        return;
+    visited[state] = true;
+
+    if (this.kinds[state] === NFA_SPLIT)
+    {
+        this.closure(this.out1[state], set, visited);
+        this.closure(this.out2[state], set, visited);
+    }
+    else
+    {
+        set.push(state);
+    }
+}
+
+/**
+    Test if an NFA character state accepts a character code.
+*/
+RegExpNFA.prototype.accepts = function (
+    state,
+    charCode
+)
+{
+    var ranges = this.ranges[state];
+
+    for (var i = 0; i < ranges.length; i += 2)
+        if (charCode >= ranges[i] && charCode <= ranges[i + 1])
+            return this.positive[state];
+
+    return !this.positive[state];
+}
+
+/**
+    DFA built lazily from an NFA by subset construction. Every DFA state
+    includes the start state of the NFA, so that matches may begin at
+    any position. Characters are mapped to classes which no character
+    range of the pattern splits.
+*/
+function RegExpDFA (
+    nfa,
+    start
+)
+{
+    this.nfa = nfa;
+
+    // Collect the class boundaries
+    var bounds = [];
+    for (var s = 0; s < nfa.kinds.length; ++s)
+    {
+        if (nfa.kinds[s] !== NFA_CHAR)
+            continue;
+
+        var ranges = nfa.ranges[s];
+        for (var i = 0; i < ranges.length; i += 2)
+            bounds.push(ranges[i], ranges[i + 1] + 1);
+    }
+    bounds.sort(function (a, b) { return a - b; });
+
+    this.bounds = [];
+    for (var i = 0; i < bounds.length; ++i)
+        if (i === 0 || bounds[i] !== bounds[i - 1])
+            this.bounds.push(bounds[i]);
+
+    this.numClasses = this.bounds.length + 1;
+
+    // Class of each ASCII character
+    this.asciiClasses = new Array(128);
+    for (var c = 0; c < 128; ++c)
+        this.asciiClasses[c] = this.getClass(c);
+
+    // Closure of the NFA start state, part of every DFA state
+    this.startSet = [];
+    nfa.closure(start, this.startSet, []);
+
+    this.sets = [];
+    this.accepting = [];
+    this.trans = [];
+    this.stateMap = {};
+
+    this.startState = this.addState(this.startSet.slice(0));
+}
+
+/**
+    Returns the class of a character code.
+*/
+RegExpDFA.prototype.getClass = function (
+    charCode
+)
+{
+    var lo = 0;
+    var hi = this.bounds.length;
+
+    // Number of bounds lesser or equal to the character code
+    while (lo < hi)
+    {
+        var mid = (lo + hi) >> 1;
+
+        if (this.bounds[mid] <= charCode)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+/**
+    Returns the DFA state for a set of NFA states, creating it if needed.
+    Returns -1 if the DFA has too many states.
+*/
+RegExpDFA.prototype.addState = function (
+    set
+)
+{
+    set.sort(function (a, b) { return a - b; });
+    var key = "s" + set.join(",");
+
+    var state = this.stateMap[key];
+    if (state !== undefined)
+        return state;
+
+    state = this.sets.length;
+    if (state >= REGEXP_MAX_DFA_STATES)
+        return -1;
+
+    var accepting = false;
+    for (var i = 0; i < set.length; ++i)
+        if (this.nfa.kinds[set[i]] === NFA_MATCH)
+            accepting = true;
+
+    this.stateMap[key] = state;
+    this.sets.push(set);
+    this.accepting.push(accepting);
+    for (var i = 0; i < this.numClasses; ++i)
+        this.trans.push(-1);
+
+    return state;
+}
+
+/**
+    Compute the transition of a DFA state on a character class.
+*/
+RegExpDFA.prototype.addTrans = function (
+    state,
+    cls
+)
+{
+    var nfa = this.nfa;
+    var set = this.sets[state];
+
+    // Any character code of the class is representative
+    var charCode = (cls === 0)? 0:this.bounds[cls - 1];
+
+    var visited = [];
+    var next = [];
+
+    for (var i = 0; i < this.startSet.length; ++i)
+    {
+        visited[this.startSet[i]] = true;
+        next.push(this.startSet[i]);
+    }
+
+    for (var i = 0; i < set.length; ++i)
+    {
+        var s = set[i];
+
+        if (nfa.kinds[s] === NFA_CHAR && nfa.accepts(s, charCode))
+            nfa.closure(nfa.out1[s], next, visited);
+    }
+
+    var dest = this.addState(next);
+    this.trans[state * this.numClasses + cls] = dest;
+
+    return dest;
+}
+
+/**
+    Returns 1 if a match starts at or after <index> in the input, 0 if
+    there is none and -1 if the DFA grew too large.
+*/
+RegExpDFA.prototype.search = function (
+    input,
+    index
+)
+{
+    var state = this.startState;
+    var numClasses = this.numClasses;
+
+    if (this.accepting[state])
+        return 1;
+
+    for (var i = index; i < input.length; ++i)
+    {
+        var charCode = input.charCodeAt(i);
+        var cls = (charCode < 128)?
+                  this.asciiClasses[charCode]:this.getClass(charCode);
+
+        var next = this.trans[state * numClasses + cls];
+        if (next < 0)
+        {
+            next = this.addTrans(state, cls);
+            if (next < 0)
+                return -1;
+        }
+
+        state = next;
+        if (this.accepting[state])
+            return 1;
+    }
+
+    return 0;
+}
+
+/**
+    Build the DFA matcher of a pattern, or returns null if the pattern
+    uses backreferences or assertions.
+*/
+function astToDFA (
+    ast,
+    ignoreCase
+)
+{
+    var nfa = new RegExpNFA();
+    var match = nfa.addState(NFA_MATCH, null, true, -1, -1);
+    var start = nfa.disjunction(ast, match, ignoreCase);
+
+    if (nfa.unsupported)
+        return null;
+
+    return new RegExpDFA(nfa, start);
+}
+
+/**
+    Compile a parsed pattern. The literal prefix and anchoring are found
+    from the terms every match must begin with.
+*/
+function astToProgram (
+    ast,
+    global,
+    ignoreCase,
+    multiline
+)
+{
+    var automata = astToAutomata(ast, global, ignoreCase, multiline);
+
+    var prefix = "";
+    var anchored = false;
+
+    if (ast.alternatives.length === 1 && !ignoreCase)
+    {
+        var terms = ast.alternatives[0].terms;
+        var codes = [];
+
+        for (var i = 0; i < terms.length; ++i)
+        {
+            var prefixNode = terms[i].prefix;
+            var quantifier = terms[i].quantifier;
+
+            if (i === 0 && !multiline &&
+                prefixNode instanceof RegExpAssertion &&
+                prefixNode.value === 94) // '^'
+            {
+                anchored = true;
+            }
+            else if (prefixNode instanceof RegExpAtom &&
+                     prefixNode.value instanceof RegExpPatternCharacter &&
+                     quantifier.min === 1 && quantifier.max === 1)
+            {
+                codes.push(prefixNode.value.value);
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        for (var i = 0; i < codes.length; ++i)
+            prefix += String.fromCharCode(codes[i]);
+    }
+
+    return new RegExpProgram(
+        automata,
+        prefix,
+        anchored,
+        astToDFA(ast, ignoreCase)
+    );
+}
+
+/**
+    Cache of compiled patterns, keyed by flags and source.
+*/
+var programCache = {};
+var programCacheSize = 0;
+
+/**
+    Returns the compiled program of a pattern with the given flags.
+*/
+function getProgram (
+    pattern,
+    global,
+    ignoreCase,
+    multiline
+)
+{
+    var key = (global? "g":"") + (ignoreCase? "i":"") +
+              (multiline? "m":"") + "/" + pattern;
+
+    var program = programCache[key];
+    if (program !== undefined)
+        return program;
+
+    // Parse pattern and compile it.
+    var ast = new RegExpParser().parse(pattern);
+    program = astToProgram(ast, global, ignoreCase, multiline);
+
+    if (programCacheSize >= REGEXP_CACHE_SIZE)
+    {
+        programCache = {};
+        programCacheSize = 0;
+    }
+
+    programCache[key] = program;
+    ++programCacheSize;
+
+    return program;
+}
+
 (function ()
 {
     // Get a reference to the context
@@ -2543,14 +3186,30 @@ RegExp.prototype.exec = function (
     input
 )
 {
-    var context = new RegExpContext(input, this._automata.captures);
+    var program = this._program;
+    var automata = program.automata;
+
+    // Inputs without any match are rejected without backtracking.
+    if (program.search(input, this.lastIndex) === 0)
+    {
+        this.lastIndex = 0;
+        return null;
+    }
+
+    var context = new RegExpContext(input, automata.captures);
     var padding = 0;
-    var currentNode = this._automata.headNode;
+    var currentNode = automata.headNode;
     var nextNode = currentNode;
 
     do {
-        currentNode = this._automata.headNode;
-        context.setIndex(this.lastIndex + padding);
+        // Skip the positions where no match can start.
+        var start = program.nextStart(input, this.lastIndex + padding);
+        if (start < 0)
+            break;
+        padding = start - this.lastIndex;
+
+        currentNode = automata.headNode;
+        context.setIndex(start);
 
         while (true)
         {
@@ -2567,10 +3226,10 @@ RegExp.prototype.exec = function (
                         this.lastIndex = context.index;
 
                     // Build match array.
-                    var matches = new Array(this._automata.captures.length);
-                    for (var i = 0; i < this._automata.captures.length; ++i)
+                    var matches = new Array(automata.captures.length);
+                    for (var i = 0; i < automata.captures.length; ++i)
                     {
-                        var capture = this._automata.captures[i];
+                        var capture = automata.captures[i];
 
                         if (capture.start >= 0)
                             matches[i] = input.substring(capture.start, capture.end);
@@ -2605,14 +3264,36 @@ RegExp.prototype.test = function (
     input
 )
 {
-    var context = new RegExpContext(input, this._automata.captures);
+    var program = this._program;
+    var automata = program.automata;
+
+    // Without the global flag, only the presence of a match matters and
+    // the DFA gives the answer on its own.
+    var found = program.search(input, this.lastIndex);
+
+    if (found === 0)
+    {
+        this.lastIndex = 0;
+        return null;
+    }
+
+    if (found === 1 && !this.global)
+        return true;
+
+    var context = new RegExpContext(input, automata.captures);
     var padding = 0;
-    var currentNode = this._automata.headNode;
+    var currentNode = automata.headNode;
     var nextNode = currentNode;
 
     do {
-        currentNode = this._automata.headNode;
-        context.setIndex(this.lastIndex + padding);
+        // Skip the positions where no match can start.
+        var start = program.nextStart(input, this.lastIndex + padding);
+        if (start < 0)
+            break;
+        padding = start - this.lastIndex;
+
+        currentNode = automata.headNode;
+        context.setIndex(start);
 
         while (true)
         {
@@ -271,24 +271,23 @@ function string_indexOf (
     pos
 )
 {
-    var i;
+    var str = string_internal_toString(this);
+    var searchStr = boxToString(searchString);
+    var len = string_internal_getLength(str);
 
-    if (pos === undefined || pos < 0)
-        i = 0;
-    else
-        i = pos;
+    // Convert the position to an integer, a missing or non-numeric
+    // position starts the search at the beginning
+    pos = boxToNumber(pos);
 
-    for (; i < this.length; ++i)
-    {
-        var j;
+    var start;
+    if (!boxIsInt(pos) || pos < 0)
+        start = 0;
+    else if (pos > len)
+        start = len;
+    else
+        start = pos;
 
-        for (j = 0; j < searchString.length; ++j)
-            if (this.charCodeAt(i + j) !== searchString.charCodeAt(j))
-                break;
-        if (j === searchString.length)
-            return i;
-    }
-    return -1;
+    return boxInt(strIndexOf(str, searchStr, unboxInt(start)));
 }
 
 /**
@@ -299,41 +298,23 @@ function string_lastIndexOf (
     pos
 )
 {
-    if (searchString.length > this.length)
-        return -1;
-
-    if (pos === undefined)
-        pos = this.length;
-    else if (pos >= this.length)
-        pos = this.length;
-    else if (pos < 0)
-        pos = 0;
+    var str = string_internal_toString(this);
+    var searchStr = boxToString(searchString);
+    var len = string_internal_getLength(str);
 
-    if (searchString.length === 0)
-        return pos;
+    // Convert the position to an integer, a missing or non-numeric
+    // position starts the search at the end
+    pos = boxToNumber(pos);
 
-    if (pos + searchString.length > this.length)
-        pos = this.length - searchString.length;
-    
-    var firstChar = searchString.charCodeAt(0);
-    for (var i = pos; i >= 0; i--)
-    {
-        if (this.charCodeAt(i) === firstChar)
-        {
-            var match = true;
-            for (var j = 1; j < searchString.length; j++)
-            {
-                if (this.charCodeAt(i + j) !== searchString.charCodeAt(j))
-                {
-                    match = false;
-                    break;
-                }
-            }
-            if (match) return i;
-        }
-    }
+    var start;
+    if (!boxIsInt(pos) || pos > len)
+        start = len;
+    else if (pos < 0)
+        start = 0;
+    else
+        start = pos;
 
-    return -1;
+    return boxInt(strLastIndexOf(str, searchStr, unboxInt(start)));
 }
 
 /**
@@ -418,22 +399,22 @@ function string_replace (
 {
     if (typeof searchValue === "string")
     {
-        var pos = this.indexOf(searchValue);
+        var str = string_internal_toString(this);
 
-        if (typeof replaceValue === "function")
-        {
-            var ret = replaceValue(searchValue, pos, this.toString());
+        var pos = strIndexOf(str, searchValue, pint(0));
 
-            return this.substring(0, pos).concat(
-                new String(ret).toString(),
-                this.substring(pos + string_internal_getLength(searchValue)));
-        }
+        // If the search string is not found, the string is unchanged
+        if (pos < pint(0))
+            return str;
+
+        if (typeof replaceValue === "function")
+            var repStr = boxToString(replaceValue(searchValue, boxInt(pos), str));
         else
-        {
-            return this.substring(0, pos).concat(
-                replaceValue.toString(),
-                this.substring(pos + string_internal_getLength(searchValue)));
-        }
+            var repStr = boxToString(replaceValue);
+
+        var end = pos + iir.icast(IRType.pint, get_str_size(searchValue));
+
+        return strSplice(str, pos, end, repStr);
     }
     else if (searchValue instanceof RegExp)
     {
@@ -620,30 +601,70 @@ function string_split (
     limit
 )
 {
-    var res = new Array();
-    if (limit === 0) return res;
+    if (limit === 0)
+        return new Array();
 
-    var len = this.length;
-    if (len === 0) return res;
+    var str = string_internal_toString(this);
 
     if (separator === undefined)
-        return [this];
+        return [str];
 
-    var pos = this.indexOf(separator);
-    var start = 0;
-    var sepLen = separator.length;
+    var sep = boxToString(separator);
 
-    while (pos >= 0)
+    var len = iir.icast(IRType.pint, get_str_size(str));
+    var sepLen = iir.icast(IRType.pint, get_str_size(sep));
+
+    // The empty string is split into nothing if the separator matches it
+    if (len === pint(0))
+        return (sepLen === pint(0))? new Array():[str];
+
+    // Maximum number of parts to produce
+    if (limit === undefined || limit < 0)
+        var maxParts = len + pint(1);
+    else
+        var maxParts = unboxInt(limit);
+
+    // Count the parts, so that the result array is allocated at its size
+    if (sepLen === pint(0))
+    {
+        var numParts = len;
+    }
+    else
     {
-        res.push(this.substring(start, pos));
-        if (res.length === limit) return res;
-        start = pos + sepLen;
-        pos = this.indexOf(separator, pos + sepLen);
+        var numParts = pint(1);
+        var pos = strIndexOf(str, sep, pint(0));
+        while (pos >= pint(0) && numParts < maxParts)
+        {
+            numParts++;
+            pos = strIndexOf(str, sep, pos + sepLen);
+        }
     }
 
-    if (start <= len)
+    if (numParts > maxParts)
+        numParts = maxParts;
+
+    var res = new Array(boxInt(numParts));
+
+    // Extract the parts into the result array
+    var start = pint(0);
+    for (var i = pint(0); i < numParts; i++)
     {
-        res.push(this.substring(start));
+        if (sepLen === pint(0))
+        {
+            var end = start + pint(1);
+            var next = end;
+        }
+        else
+        {
+            var end = strIndexOf(str, sep, start);
+            if (end < pint(0))
+                end = len;
+            var next = end + sepLen;
+        }
+
+        res[boxInt(i)] = strSlice(str, start, end);
+
+        start = next;
     }
 
     return res;
@@ -679,15 +700,7 @@ function string_substring (
         end = tmp;
     }
     
-    // Allocate new string.
-    var s = alloc_str(unboxInt(end - start));
-
-    // Copy substring characters in the new allocated string.
-    for (var i = start, j = pint(0); i < end; ++i, ++j)
-        set_str_data(s, j, iir.icast(IRType.u16, unboxInt( source.charCodeAt(i) )));
-
-    compStrHash(s);
-    return getTableStr(s);
+    return strSlice(source, unboxInt(start), unboxInt(end));
 }
 
 /**
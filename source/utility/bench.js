@@ -0,0 +1,497 @@
+/* _________________________________________________________________________
+ *
+ *             Tachyon : A Self-Hosted JavaScript Virtual Machine
+ *
+ *
+ *  This file is part of the Tachyon JavaScript project. Tachyon is
+ *  distributed at:
+ *  http://github.com/Tachyon-Team/Tachyon
+ *
+ *
+ *  Copyright (c) 2011, Universite de Montreal
+ *  All rights reserved.
+ *
+ *  This software is licensed under the following license (Modified BSD
+ *  License):
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the Universite de Montreal nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL UNIVERSITE DE
+ *  MONTREAL BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * _________________________________________________________________________
+ */
+
+
+/**
+@fileOverview
+Benchmark harness. Runs each benchmark of the selected suites in a
+separate VM process, times a fixed number of iterations after a warm-up
+phase and compares the resulting statistics against a stored baseline.
+*/
+
+/**
+Namespace for the benchmark harness
+*/
+var bench = {};
+
+/**
+Tag prefixing the line of results output by a benchmark process
+*/
+bench.RESULT_TAG = 'BENCH-RESULT ';
+
+/**
+Default number of timed iterations
+*/
+bench.DEFAULT_ITERS = 10;
+
+/**
+Default number of untimed warm-up iterations
+*/
+bench.DEFAULT_WARMUP = 2;
+
+/**
+Default regression threshold, in percent of the baseline median
+*/
+bench.DEFAULT_THRESHOLD = 5;
+
+/**
+Benchmark suites. Each benchmark lists its source files and, optionally,
+a function to call with integer arguments once the files are loaded,
+and a number of calls per timed iteration for short functions. If no
+function is given, executing the files is the timed workload.
+*/
+bench.suites = {
+
+    micro: [
+        { name: 'fib', files: ['programs/fib/fib.js'],
+          func: 'fib', args: [25] },
+        { name: 'call_loop', files: ['programs/call_loop/call_loop.js'],
+          func: 'foo', args: [], reps: 10000 },
+        { name: 'try_calls', files: ['programs/exc_calls/exc_calls.js'],
+          func: 'try_calls', args: [10000], reps: 20 },
+        { name: 'throw_catch', files: ['programs/exc_calls/exc_calls.js'],
+          func: 'throw_catch', args: [10000], reps: 5 },
+        { name: 'loop_sum', files: ['programs/loop_sum/loop_sum.js'],
+          func: 'loop_sum', args: [30000], reps: 20 },
+        { name: 'bubble_sort', files: ['programs/bubble_sort/bubble_sort.js'],
+          func: 'test', args: [], reps: 100 },
+        { name: 'merge_sort', files: ['programs/merge_sort/merge_sort.js'],
+          func: 'test', args: [], reps: 1000 },
+        { name: 'nqueens', files: ['programs/nqueens/nqueens.js'],
+          func: 'test', args: [], reps: 100 },
+        { name: 'matrix_comp', files: ['programs/matrix_comp/matrix_comp.js'],
+          func: 'test', args: [], reps: 100 },
+        { name: 'perf_obj_access',
+          files: ['programs/perf_obj_access/perf_obj_access.js'],
+          func: 'test', args: [] },
+        { name: 'perf_arr_access',
+          files: ['programs/perf_arr_access/perf_arr_access.js'],
+          func: 'test', args: [], reps: 10 },
+        { name: 'str_indexOf',
+          files: ['programs/stdlib_string/stdlib_string.js'],
+          func: 'bench_indexOf', args: [2000], reps: 10 },
+        { name: 'str_lastIndexOf',
+          files: ['programs/stdlib_string/stdlib_string.js'],
+          func: 'bench_lastIndexOf', args: [2000], reps: 10 },
+        { name: 'str_split',
+          files: ['programs/stdlib_string/stdlib_string.js'],
+          func: 'bench_split', args: [2000] },
+        { name: 'str_replace',
+          files: ['programs/stdlib_string/stdlib_string.js'],
+          func: 'bench_replace', args: [2000], reps: 10 },
+        { name: 'str_intern',
+          files: ['programs/stdlib_string/stdlib_string.js'],
+          func: 'bench_intern', args: [20000] }
+    ],
+
+    sunspider: [
+        { name: 'access-binary-trees',
+          files: ['programs/sunspider/access-binary-trees.js'] },
+        { name: 'access-fannkuch',
+          files: ['programs/sunspider/access-fannkuch.js'] },
+        { name: 'access-nsieve',
+          files: ['programs/sunspider/access-nsieve.js'] },
+        { name: 'bitops-3bit-bits-in-byte',
+          files: ['programs/sunspider/bitops-3bit-bits-in-byte.js'] },
+        { name: 'bitops-bits-in-byte',
+          files: ['programs/sunspider/bitops-bits-in-byte.js'] },
+        { name: 'bitops-bitwise-and',
+          files: ['programs/sunspider/bitops-bitwise-and.js'] },
+        { name: 'bitops-nsieve-bits',
+          files: ['programs/sunspider/bitops-nsieve-bits.js'] },
+        { name: 'controlflow-recursive',
+          files: ['programs/sunspider/controlflow-recursive.js'] },
+        { name: 'crypto-md5',
+          files: ['programs/sunspider/crypto-md5.js'] },
+        { name: 'crypto-sha1',
+          files: ['programs/sunspider/crypto-sha1.js'] }
+    ],
+
+    v8bench: [
+        { name: 'deltablue',
+          files: ['programs/v8bench/base.js',
+                  'programs/v8bench/deltablue.js',
+                  'programs/v8bench/drv-deltablue.js'] },
+        { name: 'richards',
+          files: ['programs/v8bench/base.js',
+                  'programs/v8bench/richards.js',
+                  'programs/v8bench/drv-richards.js'] }
+    ]
+};
+
+/**
+Suites run when none are specified
+*/
+bench.DEFAULT_SUITES = ['micro', 'sunspider', 'v8bench'];
+
+/**
+Parse a non-negative integer option value, with a default value
+*/
+bench.intOption = function (optVal, defVal)
+{
+    if (optVal === undefined)
+        return defVal;
+
+    var val = parseInt(optVal, 10);
+
+    assert (
+        isNonNegInt(val),
+        'invalid integer option value: "' + optVal + '"'
+    );
+
+    return val;
+};
+
+/**
+Get the value at a given percentile of a sorted array of samples,
+using the nearest-rank method
+*/
+bench.percentile = function (sorted, pct)
+{
+    assert (
+        sorted.length > 0,
+        'no samples'
+    );
+
+    var rank = Math.ceil(pct / 100 * sorted.length);
+
+    return sorted[Math.max(rank, 1) - 1];
+};
+
+/**
+Compute summary statistics for a list of timing samples
+*/
+bench.stats = function (times)
+{
+    assert (
+        times.length > 0,
+        'no samples'
+    );
+
+    var sorted = times.slice(0).sort(function (a, b) { return a - b; });
+
+    var n = sorted.length;
+    var mid = Math.floor(n / 2);
+
+    var median = (n % 2 === 1)? sorted[mid]:(sorted[mid-1] + sorted[mid]) / 2;
+
+    var sum = 0;
+    for (var i = 0; i < n; ++i)
+        sum += sorted[i];
+
+    return {
+        iters: n,
+        min: sorted[0],
+        median: median,
+        p95: bench.percentile(sorted, 95),
+        mean: sum / n
+    };
+};
+
+/**
+Compare benchmark results against a baseline. Returns the list of
+benchmarks whose median changed by more than the threshold percentage.
+*/
+bench.compare = function (results, baseline, threshold)
+{
+    var changes = [];
+
+    for (var name in results)
+    {
+        if (!baseline.hasOwnProperty(name))
+            continue;
+
+        var cur = results[name].median;
+        var base = baseline[name].median;
+
+        if (base <= 0)
+            continue;
+
+        var ratio = cur / base;
+
+        if (ratio > 1 + threshold / 100)
+            changes.push({ name: name, ratio: ratio, regression: true });
+        else if (ratio < 1 - threshold / 100)
+            changes.push({ name: name, ratio: ratio, regression: false });
+    }
+
+    return changes;
+};
+
+/**
+Format a time in nanoseconds as milliseconds
+*/
+bench.fmtMs = function (nanos)
+{
+    return fmtNumDecimals(nanos / 1000000, 2);
+};
+
+/**
+Compile the given files, then time repeated executions of the code.
+This runs inside each benchmark process and prints the raw samples.
+*/
+bench.runFiles = function (files, units, options)
+{
+    const params = config.hostParams;
+
+    var numIters = bench.intOption(options['iters'], bench.DEFAULT_ITERS);
+    var numWarmup = bench.intOption(options['warmup'], bench.DEFAULT_WARMUP);
+
+    var funcName = options['benchfunc'];
+    var numReps = bench.intOption(options['benchreps'], 1);
+    var funcArgs = [];
+    if (typeof options['benchargs'] === 'string')
+    {
+        var argStrs = options['benchargs'].split(',');
+        for (var i = 0; i < argStrs.length; ++i)
+            funcArgs.push(bench.intOption(argStrs[i]));
+    }
+
+    // Compile all the files before running anything, so that the
+    // compilation time is not part of the measurements
+    var bridges = [];
+    var funcIR = null;
+    for (var i = 0; i < files.length; ++i)
+    {
+        if (units !== undefined)
+            var ir = compileUnit(units[i], params);
+        else
+            var ir = compileSrcFile(files[i], params);
+
+        bridges.push(makeBridge(ir, params, [], new CIntAsBox()));
+
+        if (typeof funcName === 'string' && ir.getChild(funcName) !== null)
+            funcIR = ir.getChild(funcName);
+    }
+
+    function runUnits()
+    {
+        for (var i = 0; i < bridges.length; ++i)
+            bridges[i](params.ctxPtr);
+    }
+
+    // If a function is to be called, initialize the units once and
+    // time the function calls only
+    if (typeof funcName === 'string')
+    {
+        assert (
+            funcIR !== null,
+            'benchmark function not found: "' + funcName + '"'
+        );
+
+        runUnits();
+
+        var argTypes = funcArgs.map(function () { return new CIntAsBox(); });
+        var funcBridge = makeBridge(funcIR, params, argTypes, new CIntAsBox());
+        var callArgs = [params.ctxPtr].concat(funcArgs);
+
+        var runOnce = function ()
+        {
+            for (var i = 0; i < numReps; ++i)
+                funcBridge.apply(undefined, callArgs);
+        };
+    }
+    else
+    {
+        var runOnce = runUnits;
+    }
+
+    for (var i = 0; i < numWarmup; ++i)
+        runOnce();
+
+    var times = [];
+    for (var i = 0; i < numIters; ++i)
+    {
+        var startTime = getTimeNanos();
+        runOnce();
+        times.push(getTimeNanos() - startTime);
+    }
+
+    print(bench.RESULT_TAG + JSON.stringify({ times: times }));
+};
+
+/**
+Run one benchmark in a separate VM process. Returns the list of timing
+samples, or null if the process did not report results.
+*/
+bench.runProcess = function (vmCmd, benchmark, options)
+{
+    var cmd = vmCmd + ' -benchrun';
+
+    if (options['iters'] !== undefined)
+        cmd += ' -iters=' + options['iters'];
+    if (options['warmup'] !== undefined)
+        cmd += ' -warmup=' + options['warmup'];
+
+    if (benchmark.func !== undefined)
+    {
+        cmd += ' -benchfunc=' + benchmark.func;
+        if (benchmark.args.length > 0)
+            cmd += ' -benchargs=' + benchmark.args.join(',');
+        if (benchmark.reps !== undefined)
+            cmd += ' -benchreps=' + benchmark.reps;
+    }
+
+    if (typeof options['benchopts'] === 'string')
+        cmd += ' ' + options['benchopts'];
+
+    cmd += ' ' + benchmark.files.join(' ') + ' 2>&1';
+
+    var output = shellCommand(cmd);
+
+    var lines = output.split('\n');
+    for (var i = 0; i < lines.length; ++i)
+    {
+        var line = lines[i];
+
+        if (line.indexOf(bench.RESULT_TAG) === 0)
+            return JSON.parse(line.slice(bench.RESULT_TAG.length)).times;
+    }
+
+    if (config.verbosity >= log.DEBUG)
+        print(output);
+
+    return null;
+};
+
+/**
+Benchmark harness entry point. Runs the selected suites, prints the
+statistics for each benchmark, and optionally compares them against
+a baseline file and saves them as a new baseline.
+*/
+bench.run = function (options)
+{
+    var vmCmd = options['benchvm'];
+
+    if (typeof vmCmd !== 'string')
+        error('no VM command specified for the benchmark processes');
+
+    var suiteNames = bench.DEFAULT_SUITES;
+    if (typeof options['bench'] === 'string')
+        suiteNames = options['bench'].split(',');
+
+    var threshold = bench.DEFAULT_THRESHOLD;
+    if (options['threshold'] !== undefined)
+        threshold = parseFloat(options['threshold']);
+
+    var results = {};
+    var numFailed = 0;
+
+    print(
+        rightPadStr('benchmark', ' ', 36) +
+        leftPadStr('median', ' ', 12) +
+        leftPadStr('p95', ' ', 12) +
+        leftPadStr('min', ' ', 12) + '  (ms)'
+    );
+
+    for (var i = 0; i < suiteNames.length; ++i)
+    {
+        var suiteName = suiteNames[i];
+        var suite = bench.suites[suiteName];
+
+        if (suite === undefined)
+            error('unknown benchmark suite: "' + suiteName + '"');
+
+        for (var j = 0; j < suite.length; ++j)
+        {
+            var benchmark = suite[j];
+            var name = suiteName + '/' + benchmark.name;
+
+            var times = bench.runProcess(vmCmd, benchmark, options);
+
+            if (times === null)
+            {
+                print(rightPadStr(name, ' ', 36) + '      FAILED');
+                ++numFailed;
+                continue;
+            }
+
+            var stats = bench.stats(times);
+            results[name] = stats;
+
+            print(
+                rightPadStr(name, ' ', 36) +
+                leftPadStr(bench.fmtMs(stats.median), ' ', 12) +
+                leftPadStr(bench.fmtMs(stats.p95), ' ', 12) +
+                leftPadStr(bench.fmtMs(stats.min), ' ', 12)
+            );
+        }
+    }
+
+    if (numFailed > 0)
+        print(numFailed + ' ' + pluralize('benchmark', numFailed) + ' failed');
+
+    // Compare the results against the baseline, if one is provided
+    if (typeof options['baseline'] === 'string')
+    {
+        var baseline = JSON.parse(readFile(options['baseline']));
+        var changes = bench.compare(results, baseline, threshold);
+
+        var numRegs = 0;
+        for (var i = 0; i < changes.length; ++i)
+        {
+            var change = changes[i];
+            var pct = fmtNumDecimals(Math.abs(change.ratio - 1) * 100, 1);
+
+            if (change.regression)
+            {
+                print('REGRESSION: ' + change.name + ' is ' + pct + '% slower');
+                ++numRegs;
+            }
+            else
+            {
+                print('improvement: ' + change.name + ' is ' + pct + '% faster');
+            }
+        }
+
+        print(
+            numRegs + ' ' + pluralize('regression', numRegs) +
+            ' beyond ' + threshold + '% of ' + options['baseline']
+        );
+    }
+
+    // Save the results as the new baseline, if requested
+    if (typeof options['save'] === 'string')
+        writeFile(options['save'], JSON.stringify(results, null, 4));
+
+    return results;
+};
@@ -0,0 +1,347 @@
+/* _________________________________________________________________________
+ *
+ *             Tachyon : A Self-Hosted JavaScript Virtual Machine
+ *
+ *
+ *  This file is part of the Tachyon JavaScript project. Tachyon is
+ *  distributed at:
+ *  http://github.com/Tachyon-Team/Tachyon
+ *
+ *
+ *  Copyright (c) 2011, Universite de Montreal
+ *  All rights reserved.
+ *
+ *  This software is licensed under the following license (Modified BSD
+ *  License):
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the Universite de Montreal nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL UNIVERSITE DE
+ *  MONTREAL BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * _________________________________________________________________________
+ */
+
+/**
+@fileOverview
+Dense bit set implementation, for sets of small integers such as
+instruction and block ids.
+*/
+
+/**
+@class Set of integers in [0, size[, stored as packed words of bits
+*/
+function BitSet(size)
+{
+    assert (
+        isNonNegInt(size),
+        'invalid bit set size'
+    );
+
+    var numWords = Math.ceil(size / BitSet.WORD_BITS);
+
+    /**
+    Number of integers the set can hold
+    @field
+    */
+    this.size = size;
+
+    /**
+    Words of bits
+    @field
+    */
+    this.words = new Array(numWords);
+
+    for (var i = 0; i < numWords; ++i)
+        this.words[i] = 0;
+}
+BitSet.prototype = {};
+
+/**
+Number of bits per word. Words are kept small enough to remain
+small integers on all platforms.
+@constant
+*/
+BitSet.WORD_BITS = 16;
+
+/**
+Test if an integer is in the set
+*/
+BitSet.prototype.has = function (idx)
+{
+    var word = this.words[(idx / BitSet.WORD_BITS) | 0];
+
+    return (word & (1 << (idx % BitSet.WORD_BITS))) !== 0;
+};
+
+/**
+Add an integer to the set
+*/
+BitSet.prototype.add = function (idx)
+{
+    assert (
+        idx >= 0 && idx < this.size,
+        'index outside of bit set'
+    );
+
+    var wordIdx = (idx / BitSet.WORD_BITS) | 0;
+
+    this.words[wordIdx] |= (1 << (idx % BitSet.WORD_BITS));
+
+    return this;
+};
+
+/**
+Remove an integer from the set
+*/
+BitSet.prototype.rem = function (idx)
+{
+    var wordIdx = (idx / BitSet.WORD_BITS) | 0;
+
+    this.words[wordIdx] &= ~(1 << (idx % BitSet.WORD_BITS));
+
+    return this;
+};
+
+/**
+In-place union. Returns true if the set changed.
+*/
+BitSet.prototype.union = function (set)
+{
+    assert (
+        set.size === this.size,
+        'bit sets of different sizes'
+    );
+
+    var changed = false;
+
+    for (var i = 0; i < this.words.length; ++i)
+    {
+        var word = this.words[i];
+        var newWord = word | set.words[i];
+
+        if (newWord !== word)
+        {
+            this.words[i] = newWord;
+            changed = true;
+        }
+    }
+
+    return changed;
+};
+
+/**
+In-place union with the integers of a set which are not in another set.
+Returns true if the set changed.
+*/
+BitSet.prototype.unionExcept = function (set, exclSet)
+{
+    assert (
+        set.size === this.size && exclSet.size === this.size,
+        'bit sets of different sizes'
+    );
+
+    var changed = false;
+
+    for (var i = 0; i < this.words.length; ++i)
+    {
+        var word = this.words[i];
+        var newWord = word | (set.words[i] & ~exclSet.words[i]);
+
+        if (newWord !== word)
+        {
+            this.words[i] = newWord;
+            changed = true;
+        }
+    }
+
+    return changed;
+};
+
+/**
+In-place set difference (relative complement)
+*/
+BitSet.prototype.diff = function (set)
+{
+    assert (
+        set.size === this.size,
+        'bit sets of different sizes'
+    );
+
+    for (var i = 0; i < this.words.length; ++i)
+        this.words[i] &= ~set.words[i];
+
+    return this;
+};
+
+/**
+Test if two sets contain the same integers
+*/
+BitSet.prototype.equal = function (set)
+{
+    if (set.size !== this.size)
+        return false;
+
+    for (var i = 0; i < this.words.length; ++i)
+        if (this.words[i] !== set.words[i])
+            return false;
+
+    return true;
+};
+
+/**
+Copy the set
+*/
+BitSet.prototype.copy = function ()
+{
+    var newSet = Object.create(BitSet.prototype);
+
+    newSet.size = this.size;
+    newSet.words = this.words.slice(0);
+
+    return newSet;
+};
+
+/**
+Remove all integers from the set
+*/
+BitSet.prototype.clear = function ()
+{
+    for (var i = 0; i < this.words.length; ++i)
+        this.words[i] = 0;
+
+    return this;
+};
+
+/**
+Test if the set is empty
+*/
+BitSet.prototype.isEmpty = function ()
+{
+    for (var i = 0; i < this.words.length; ++i)
+        if (this.words[i] !== 0)
+            return false;
+
+    return true;
+};
+
+/**
+Get the smallest integer in the set greater or equal to some
+integer, or -1 if there is none
+*/
+BitSet.prototype.nextSet = function (idx)
+{
+    var wordIdx = (idx / BitSet.WORD_BITS) | 0;
+    var bitIdx = idx % BitSet.WORD_BITS;
+
+    for (; wordIdx < this.words.length; ++wordIdx, bitIdx = 0)
+    {
+        var word = this.words[wordIdx];
+
+        if (word === 0)
+            continue;
+
+        for (; bitIdx < BitSet.WORD_BITS; ++bitIdx)
+            if ((word & (1 << bitIdx)) !== 0)
+                return wordIdx * BitSet.WORD_BITS + bitIdx;
+    }
+
+    return -1;
+};
+
+/**
+Count the integers in the set
+*/
+BitSet.prototype.count = function ()
+{
+    var count = 0;
+
+    for (var idx = this.nextSet(0); idx !== -1; idx = this.nextSet(idx + 1))
+        ++count;
+
+    return count;
+};
+
+/**
+Get an array of the integers in the set, in increasing order
+*/
+BitSet.prototype.toArray = function ()
+{
+    var arr = [];
+
+    for (var idx = this.nextSet(0); idx !== -1; idx = this.nextSet(idx + 1))
+        arr.push(idx);
+
+    return arr;
+};
+
+/**
+Get an iterator over the integers in the set, in increasing order
+*/
+BitSet.prototype.getItr = function ()
+{
+    return new BitSet.Iterator(this);
+};
+
+/**
+@class Bit set iterator
+@augments Iterator
+*/
+BitSet.Iterator = function (set)
+{
+    /**
+    Associated bit set
+    @field
+    */
+    this.set = set;
+
+    /**
+    Current integer
+    @field
+    */
+    this.idx = set.nextSet(0);
+};
+BitSet.Iterator.prototype = new Iterator();
+
+/**
+Move to the next integer
+*/
+BitSet.Iterator.prototype.next = function ()
+{
+    this.idx = this.set.nextSet(this.idx + 1);
+};
+
+/**
+Test if the iterator is at a valid position
+*/
+BitSet.Iterator.prototype.valid = function ()
+{
+    return (this.idx !== -1);
+};
+
+/**
+Get the current integer
+*/
+BitSet.Iterator.prototype.get = function ()
+{
+    return this.idx;
+};
+
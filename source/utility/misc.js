@@ -161,29 +161,57 @@ function getIntMin(numBits, unsigned)
     // If this is a signed integer type
     else
     {
-        return num_shift(-1, numBits-1);
+        var min = getIntMin.cache[numBits];
+
+        if (min === undefined)
+            min = getIntMin.cache[numBits] = num_shift(-1, numBits-1);
+
+        return min;
     }
 }
 
+/**
+Cache of the signed minimums, by number of bits. Their computation
+involves bignum arithmetic.
+*/
+getIntMin.cache = [];
+
 /**
 Calculate the maximum value an integer variable can store. Signed
 values are assumed to use the 2s complement representation.
 */
 function getIntMax(numBits, unsigned)
 {
+    var cache = unsigned? getIntMax.unsgCache:getIntMax.cache;
+
+    var max = cache[numBits];
+
+    if (max !== undefined)
+        return max;
+
     // If this is an unsigned integer type
     if (unsigned)
     {
-        return num_sub(num_shift(1, numBits), 1);
+        max = num_sub(num_shift(1, numBits), 1);
     }
 
     // If this is a signed integer type
     else
     {
-        return num_sub(num_shift(1, numBits-1), 1);
+        max = num_sub(num_shift(1, numBits-1), 1);
     }
+
+    cache[numBits] = max;
+
+    return max;
 }
 
+/**
+Caches of the signed and unsigned maximums, by number of bits
+*/
+getIntMax.cache = [];
+getIntMax.unsgCache = [];
+
 /**
 Test if a value is a positive integer
 */
@@ -469,8 +497,25 @@ function PerfInfo()
 
 var perfBuckets = {};
 
-function measurePerformance(bucket, thunk)
+/**
+Measure the time taken by a thunk and accumulate it in a performance
+bucket. Buckets nest according to the calls. If a compilation trace is
+being recorded, the call is also recorded as a trace event, along with
+the values returned by the optional count function before and after
+the thunk runs (e.g. an instruction count).
+*/
+function measurePerformance(bucket, thunk, countFunc)
 {
+    var traceStart, countIn;
+
+    if (perfTrace !== null)
+    {
+        traceStart = traceBegin();
+
+        if (countFunc !== undefined)
+            countIn = countFunc();
+    }
+
     var perfInfo;
 
     if (!perfBuckets.hasOwnProperty(bucket))
@@ -500,6 +545,14 @@ function measurePerformance(bucket, thunk)
     perfInfo.time += time;
     perfInfo.kbs_alloc += kbs_alloc;
 
+    if (perfTrace !== null)
+    {
+        if (countFunc !== undefined)
+            traceEnd(bucket, 'pass', traceStart, countIn, countFunc());
+        else
+            traceEnd(bucket, 'pass', traceStart);
+    }
+
     return result;
 }
 
@@ -556,3 +609,206 @@ function reportPerformanceSubBuckets(overall, buckets, indent)
         reportPerformanceSubBuckets(overall, perfInfo.buckets, indent);
     }
 }
+
+/**
+Get the current time in nanoseconds. Falls back on the millisecond
+timer if the host does not provide a high-resolution one.
+*/
+function getTimeNanos()
+{
+    if (typeof currentTimeNanos === 'function')
+        return currentTimeNanos();
+
+    return currentTimeMillis() * 1000000;
+}
+
+/**
+Compilation trace being recorded, null when tracing is disabled. Holds
+the trace events in the Chrome trace event format, with the name of
+the function currently being compiled.
+*/
+var perfTrace = null;
+
+/**
+Start recording a compilation trace
+*/
+function startPerfTrace()
+{
+    perfTrace = {
+        events: [],
+        startTime: getTimeNanos(),
+        funcName: null
+    };
+}
+
+/**
+Begin a trace event, returning its start time
+*/
+function traceBegin()
+{
+    return getTimeNanos();
+}
+
+/**
+End a trace event of a given category. The counts in and out are
+optional.
+*/
+function traceEnd(name, cat, startTime, countIn, countOut)
+{
+    var endTime = getTimeNanos();
+
+    var args = { func: perfTrace.funcName };
+
+    if (countIn !== undefined)
+    {
+        args.countIn = countIn;
+        args.countOut = countOut;
+    }
+
+    perfTrace.events.push({
+        name: name,
+        cat: cat,
+        ph: 'X',
+        pid: 1,
+        tid: 1,
+        ts: (startTime - perfTrace.startTime) / 1000,
+        dur: (endTime - startTime) / 1000,
+        args: args
+    });
+}
+
+/**
+Record the compilation of a function as a trace event enclosing the
+events of the passes run on it. Does nothing if tracing is disabled.
+*/
+function traceFunc(kind, funcName, thunk)
+{
+    if (perfTrace === null)
+        return thunk();
+
+    if (funcName === '')
+        funcName = '<anonymous>';
+
+    var prevFuncName = perfTrace.funcName;
+    perfTrace.funcName = funcName;
+
+    var startTime = traceBegin();
+    var result = thunk();
+    traceEnd(kind + ' ' + funcName, 'func', startTime);
+
+    perfTrace.funcName = prevFuncName;
+
+    return result;
+}
+
+/**
+Write the recorded compilation trace to a file, in the Chrome trace
+event JSON format
+*/
+function writePerfTrace(fileName)
+{
+    assert (
+        perfTrace !== null,
+        'no compilation trace recorded'
+    );
+
+    writeFile(fileName, JSON.stringify({ traceEvents: perfTrace.events }));
+}
+
+/**
+Print the time spent in each compilation pass, with the instruction
+counts in and out of the pass, and the functions taking the most time
+to compile
+*/
+function reportPerfTrace(numFuncs)
+{
+    assert (
+        perfTrace !== null,
+        'no compilation trace recorded'
+    );
+
+    if (numFuncs === undefined)
+        numFuncs = 20;
+
+    var passes = {};
+    var funcs = {};
+
+    function sortedKeys(map)
+    {
+        var keys = [];
+        for (var key in map)
+            keys.push(key);
+
+        return keys.sort(function (x, y) { return map[y].time - map[x].time; });
+    }
+
+    for (var i = 0; i < perfTrace.events.length; ++i)
+    {
+        var event = perfTrace.events[i];
+
+        // Function events are accounted for separately from passes
+        if (event.cat === 'func')
+        {
+            var func = funcs[event.name];
+            if (func === undefined)
+                func = funcs[event.name] = { time: 0, count: 0 };
+
+            func.time += event.dur;
+            func.count++;
+
+            continue;
+        }
+
+        var pass = passes[event.name];
+        if (pass === undefined)
+            pass = passes[event.name] = { time: 0, count: 0, countIn: 0, countOut: 0 };
+
+        pass.time += event.dur;
+        pass.count++;
+
+        if (event.args.countIn !== undefined)
+        {
+            pass.countIn += event.args.countIn;
+            pass.countOut += event.args.countOut;
+        }
+    }
+
+    print('******************** Compilation trace report');
+    print('');
+    print(
+        rightPadStr('pass', ' ', 28) +
+        leftPadStr('time (ms)', ' ', 12) +
+        leftPadStr('calls', ' ', 8) +
+        leftPadStr('count in', ' ', 12) +
+        leftPadStr('count out', ' ', 12)
+    );
+
+    var passNames = sortedKeys(passes);
+    for (var i = 0; i < passNames.length; ++i)
+    {
+        var pass = passes[passNames[i]];
+
+        print(
+            rightPadStr(passNames[i], ' ', 28) +
+            leftPadStr(fmtNumDecimals(pass.time / 1000, 1), ' ', 12) +
+            leftPadStr(pass.count, ' ', 8) +
+            leftPadStr(pass.countIn || '', ' ', 12) +
+            leftPadStr(pass.countOut || '', ' ', 12)
+        );
+    }
+
+    print('');
+    print(rightPadStr('function', ' ', 40) + leftPadStr('time (ms)', ' ', 12));
+
+    var funcNames = sortedKeys(funcs);
+    for (var i = 0; i < funcNames.length && i < numFuncs; ++i)
+    {
+        print(
+            rightPadStr(funcNames[i], ' ', 40) +
+            leftPadStr(fmtNumDecimals(funcs[funcNames[i]].time / 1000, 1), ' ', 12)
+        );
+    }
+
+    print('');
+    print('********************');
+}
@@ -0,0 +1,98 @@
+/* _________________________________________________________________________
+ *
+ *             Tachyon : A Self-Hosted JavaScript Virtual Machine
+ *
+ *
+ *  This file is part of the Tachyon JavaScript project. Tachyon is
+ *  distributed at:
+ *  http://github.com/Tachyon-Team/Tachyon
+ *
+ *
+ *  Copyright (c) 2011, Universite de Montreal
+ *  All rights reserved.
+ *
+ *  This software is licensed under the following license (Modified BSD
+ *  License):
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the Universite de Montreal nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL UNIVERSITE DE
+ *  MONTREAL BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * _________________________________________________________________________
+ */
+
+
+/**
+@fileOverview
+
+Unit tests for the benchmark harness statistics.
+
+@copyright
+Copyright (c) 2011 Tachyon Javascript Engine, All Rights Reserved
+*/
+
+tests.utility = tests.utility || tests.testSuite();
+
+tests.utility.bench = tests.testSuite();
+
+tests.utility.bench.stats = function ()
+{
+    var s = bench.stats([5, 1, 4, 2, 3]);
+
+    assert(s.iters === 5);
+    assert(s.min === 1);
+    assert(s.median === 3);
+    assert(s.p95 === 5);
+    assert(s.mean === 3);
+
+    s = bench.stats([4, 1, 3, 2]);
+
+    assert(s.median === 2.5);
+    assert(s.p95 === 4);
+
+    var samples = arrayRange(1, 101);
+    assert(bench.percentile(samples, 95) === 95);
+    assert(bench.percentile(samples, 50) === 50);
+    assert(bench.percentile(samples, 0) === 1);
+};
+
+tests.utility.bench.compare = function ()
+{
+    var baseline = {
+        a: { median: 100 },
+        b: { median: 100 },
+        c: { median: 100 }
+    };
+
+    var results = {
+        a: { median: 110 },
+        b: { median: 103 },
+        c: { median: 80 },
+        d: { median: 50 }
+    };
+
+    var changes = bench.compare(results, baseline, 5);
+
+    assert(changes.length === 2);
+    assert(changes[0].name === 'a' && changes[0].regression === true);
+    assert(changes[1].name === 'c' && changes[1].regression === false);
+};
@@ -116,3 +116,61 @@ tests.utility.set.hashSet = function ()
 
 };
 
+
+tests.utility.set.bitSet = function ()
+{
+    var s1 = new BitSet(40);
+
+    assert(s1.isEmpty());
+    assert(s1.count() === 0);
+    assert(s1.nextSet(0) === -1);
+
+    s1.add(0);
+    s1.add(17);
+    s1.add(39);
+    assert(s1.has(0));
+    assert(s1.has(17));
+    assert(s1.has(39));
+    assert(!s1.has(1));
+    assert(!s1.has(16));
+    assert(s1.count() === 3);
+    assert(arraySetEqual(s1.toArray(), [0,17,39]));
+
+    assert(s1.nextSet(0) === 0);
+    assert(s1.nextSet(1) === 17);
+    assert(s1.nextSet(18) === 39);
+
+    s1.rem(17);
+    assert(!s1.has(17));
+    assert(s1.count() === 2);
+
+    var s2 = s1.copy();
+    assert(s2.equal(s1));
+    s2.add(5);
+    assert(!s2.equal(s1));
+    assert(!s1.has(5));
+
+    var s3 = new BitSet(40);
+    s3.add(5);
+    s3.add(20);
+    assert(s1.union(s3));
+    assert(!s1.union(s3));
+    assert(arraySetEqual(s1.toArray(), [0,5,20,39]));
+
+    var s4 = new BitSet(40);
+    var s5 = new BitSet(40);
+    s5.add(20);
+    assert(s4.unionExcept(s1, s5));
+    assert(arraySetEqual(s4.toArray(), [0,5,39]));
+    assert(!s4.unionExcept(s1, s5));
+
+    s1.diff(s4);
+    assert(arraySetEqual(s1.toArray(), [20]));
+
+    var vals = [];
+    for (var itr = s4.getItr(); itr.valid(); itr.next())
+        vals.push(itr.get());
+    assert(arraySetEqual(vals, [0,5,39]));
+
+    assert(s4.clear().isEmpty());
+};
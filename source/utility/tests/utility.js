@@ -80,6 +80,57 @@ tests.utility.strIndent = function()
     assert (str2 == str3);
 };
 
+/**
+Test of the compilation trace recording
+*/
+tests.utility.perfTrace = function ()
+{
+    var prevBuckets = perfBuckets;
+    perfBuckets = {};
+
+    startPerfTrace();
+
+    try
+    {
+        var count = 3;
+
+        traceFunc(
+            'lower',
+            'foo',
+            function ()
+            {
+                measurePerformance(
+                    'pass',
+                    function () { count = 5; },
+                    function () { return count; }
+                );
+            }
+        );
+
+        var events = perfTrace.events;
+
+        assert (events.length === 2);
+
+        assert (events[0].name === 'pass');
+        assert (events[0].cat === 'pass');
+        assert (events[0].args.func === 'foo');
+        assert (events[0].args.countIn === 3);
+        assert (events[0].args.countOut === 5);
+
+        assert (events[1].name === 'lower foo');
+        assert (events[1].cat === 'func');
+        assert (events[1].ph === 'X');
+        assert (events[1].ts <= events[0].ts);
+        assert (events[1].dur >= events[0].dur);
+    }
+
+    finally
+    {
+        perfTrace = null;
+        perfBuckets = prevBuckets;
+    }
+};
+
 /**
 Test suite for the hash map code
 */